@@ -1,31 +1,45 @@
 TEMPLATE = app
-CONFIG += console c++17
+CONFIG += console
 CONFIG -= app_bundle
 CONFIG -= qt
 
-QMAKE_CXXFLAGS += -std=c++17 -Wall -Wfatal-errors
-
-HEADERS += \
-    headers/dataFiles.h \
-    headers/earth.h \
-    headers/geometry.h \
-    headers/position.h \
-    headers/types.h \
-    headers/nmea/nmea-parser.h
-
-SOURCES += \
-    src/dataFiles.cpp \
-    src/earth.cpp \
-    src/geometry.cpp \
-    src/position.cpp \
-    src/nmea/nmea-parser.cpp
+include(gps.pri)
 
 SOURCES += \
     tests/BoostUTF-main.cpp \
+    tests/clustering-tests.cpp \
+    tests/distance-matrix-tests.cpp \
+    tests/earth-tests.cpp \
+    tests/fix-filter-tests.cpp \
+    tests/geofence-tests.cpp \
+    tests/landmarks-tests.cpp \
+    tests/latency-histogram-tests.cpp \
     tests/position-tests.cpp \
-    tests/nmea/nmea-parser-tests.cpp
+    tests/spsc-queue-tests.cpp \
+    tests/stay-points-tests.cpp \
+    tests/test-helpers.cpp \
+    tests/thread-pool-tests.cpp \
+    tests/track-tests.cpp \
+    tests/track-similarity-tests.cpp \
+    tests/track-statistics-tests.cpp \
+    tests/nmea/compressed-input-tests.cpp \
+    tests/nmea/epoll-reader-tests.cpp \
+    tests/nmea/fleet-ingestor-tests.cpp \
+    tests/nmea/generator-tests.cpp \
+    tests/nmea/instrumentation-tests.cpp \
+    tests/nmea/line-reader-tests.cpp \
+    tests/nmea/nmea-batch-tests.cpp \
+    tests/nmea/nmea-parser-tests.cpp \
+    tests/nmea/pipeline-tests.cpp \
+    tests/nmea/position-range-tests.cpp \
+    tests/nmea/replay-tests.cpp \
+    tests/nmea/sentence-scanner-tests.cpp \
+    tests/nmea/structural-index-tests.cpp \
+    tests/nmea/track-reader-tests.cpp \
+    tests/nmea/track-statistics-reader-tests.cpp
 
-INCLUDEPATH += headers/ headers/nmea/
+HEADERS += \
+    tests/test-helpers.h
 
 OBJECTS_DIR = $$_PRO_FILE_PWD_/bin/
 DESTDIR = $$_PRO_FILE_PWD_/bin/
@@ -0,0 +1,63 @@
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+#include "allocation-counter.h"
+
+namespace
+{
+  std::atomic<std::size_t> allocations{0};
+}
+
+/* The replaceable global allocation functions.  The array and nothrow forms call these by
+ * default, so every allocation is counted.
+ */
+void * operator new(std::size_t size)
+{
+    allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void * p = std::malloc(size == 0 ? 1 : size)) return p;
+    throw std::bad_alloc();
+}
+
+void operator delete(void * p) noexcept
+{
+    std::free(p);
+}
+
+void operator delete(void * p, std::size_t) noexcept
+{
+    std::free(p);
+}
+
+// std::pmr::new_delete_resource() allocates with the alignment-aware forms.
+void * operator new(std::size_t size, std::align_val_t alignment)
+{
+    allocations.fetch_add(1, std::memory_order_relaxed);
+    const std::size_t align = static_cast<std::size_t>(alignment);
+    if (void * p = std::aligned_alloc(align, (size + align - 1) / align * align)) return p;
+    throw std::bad_alloc();
+}
+
+void operator delete(void * p, std::align_val_t) noexcept
+{
+    std::free(p);
+}
+
+void operator delete(void * p, std::size_t, std::align_val_t) noexcept
+{
+    std::free(p);
+}
+
+namespace GPS::Benchmarks
+{
+  std::size_t heapAllocations()
+  {
+      return allocations.load(std::memory_order_relaxed);
+  }
+
+  void reportHeapAllocations(benchmark::State & state, std::size_t before)
+  {
+      const double items = double(state.items_processed() > 0 ? state.items_processed() : state.iterations());
+      state.counters["allocs_per_item"] = double(heapAllocations() - before) / items;
+  }
+}
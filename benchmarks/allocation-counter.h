@@ -0,0 +1,21 @@
+#ifndef GPS_BENCHMARK_ALLOCATION_COUNTER_H
+#define GPS_BENCHMARK_ALLOCATION_COUNTER_H
+
+#include <cstddef>
+
+#include <benchmark/benchmark.h>
+
+namespace GPS::Benchmarks
+{
+  /* The number of heap allocations made so far by the whole program (on any thread), counted
+   * by the replacement global operator new in allocation-counter.cpp.  Allocations from
+   * std::pmr resources only count when they reach the heap (e.g. through
+   * std::pmr::new_delete_resource()).
+   */
+  std::size_t heapAllocations();
+
+  // Reports the heap allocations since 'before', per item processed, as a counter.
+  void reportHeapAllocations(benchmark::State &, std::size_t before);
+}
+
+#endif
@@ -0,0 +1,419 @@
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iterator>
+#include <sstream>
+#include <stdexcept>
+
+#include "baseline.h"
+
+namespace GPS::Benchmarks
+{
+  namespace
+  {
+      // Just enough JSON to read back the baseline files written by saveBaseline().
+      struct JsonValue
+      {
+          enum class Type { null, boolean, number, string, array, object };
+
+          Type type = Type::null;
+          bool boolean = false;
+          double number = 0;
+          std::string text;
+          std::vector<JsonValue> elements;
+          std::map<std::string, JsonValue> members;
+      };
+
+      class JsonParser
+      {
+        public:
+
+          explicit JsonParser(const std::string & text) : text(text) {}
+
+          JsonValue parseDocument()
+          {
+              JsonValue value = parseValue();
+              skipWhitespace();
+              if (pos != text.size()) fail("unexpected characters after the end");
+              return value;
+          }
+
+        private:
+
+          [[noreturn]] void fail(const std::string & what)
+          {
+              throw std::runtime_error("Invalid JSON at offset " + std::to_string(pos) + ": " + what + ".");
+          }
+
+          void skipWhitespace()
+          {
+              while (pos < text.size() && std::isspace(static_cast<unsigned char>(text[pos]))) ++pos;
+          }
+
+          char peek()
+          {
+              skipWhitespace();
+              if (pos == text.size()) fail("unexpected end");
+              return text[pos];
+          }
+
+          void expect(char c)
+          {
+              if (peek() != c) fail(std::string("expected '") + c + "'");
+              ++pos;
+          }
+
+          void expectWord(const std::string & word)
+          {
+              if (text.compare(pos, word.size(), word) != 0) fail("expected '" + word + "'");
+              pos += word.size();
+          }
+
+          JsonValue parseValue()
+          {
+              JsonValue value;
+              switch (peek())
+              {
+                  case '{':
+                      value.type = JsonValue::Type::object;
+                      ++pos;
+                      if (peek() == '}') { ++pos; break; }
+                      do
+                      {
+                          std::string name = parseString();
+                          expect(':');
+                          value.members[name] = parseValue();
+                      }
+                      while (peek() == ',' && ++pos);
+                      expect('}');
+                      break;
+
+                  case '[':
+                      value.type = JsonValue::Type::array;
+                      ++pos;
+                      if (peek() == ']') { ++pos; break; }
+                      do
+                      {
+                          value.elements.push_back(parseValue());
+                      }
+                      while (peek() == ',' && ++pos);
+                      expect(']');
+                      break;
+
+                  case '"':
+                      value.type = JsonValue::Type::string;
+                      value.text = parseString();
+                      break;
+
+                  case 't':
+                      value.type = JsonValue::Type::boolean;
+                      value.boolean = true;
+                      expectWord("true");
+                      break;
+
+                  case 'f':
+                      value.type = JsonValue::Type::boolean;
+                      expectWord("false");
+                      break;
+
+                  case 'n':
+                      expectWord("null");
+                      break;
+
+                  default:
+                  {
+                      const char * start = text.c_str() + pos;
+                      char * end;
+                      value.type = JsonValue::Type::number;
+                      value.number = std::strtod(start, &end);
+                      if (end == start) fail("expected a value");
+                      pos += end - start;
+                  }
+              }
+              return value;
+          }
+
+          std::string parseString()
+          {
+              expect('"');
+              std::string result;
+              while (true)
+              {
+                  if (pos == text.size()) fail("unterminated string");
+                  const char c = text[pos++];
+                  if (c == '"') return result;
+                  if (c != '\\')
+                  {
+                      result += c;
+                      continue;
+                  }
+
+                  if (pos == text.size()) fail("unterminated string");
+                  switch (const char escaped = text[pos++])
+                  {
+                      case 'b': result += '\b'; break;
+                      case 'f': result += '\f'; break;
+                      case 'n': result += '\n'; break;
+                      case 'r': result += '\r'; break;
+                      case 't': result += '\t'; break;
+                      case 'u':
+                      {
+                          const unsigned long code = std::stoul(text.substr(pos, 4), nullptr, 16);
+                          if (code > 0x7F) fail("only ASCII \\u escapes are supported");
+                          result += static_cast<char>(code);
+                          pos += 4;
+                          break;
+                      }
+                      default: result += escaped;
+                  }
+              }
+          }
+
+          const std::string & text;
+          std::size_t pos = 0;
+      };
+
+      void writeJsonString(std::ostream & out, const std::string & text)
+      {
+          out << '"';
+          for (char c : text)
+          {
+              if (c == '"' || c == '\\') out << '\\' << c;
+              else if (static_cast<unsigned char>(c) < 0x20)
+              {
+                  out << "\\u" << std::hex << std::setw(4) << std::setfill('0') << int(c) << std::dec << std::setfill(' ');
+              }
+              else out << c;
+          }
+          out << '"';
+      }
+
+      const JsonValue & member(const JsonValue & object, const std::string & name, JsonValue::Type type)
+      {
+          auto it = object.members.find(name);
+          if (object.type != JsonValue::Type::object || it == object.members.end() || it->second.type != type)
+          {
+              throw std::runtime_error("Baseline file is missing \"" + name + "\", or it has the wrong type.");
+          }
+          return it->second;
+      }
+
+      // The probability that a Binomial(n, 1/2) variable is at most k.
+      double binomialHalfCDF(std::size_t n, std::size_t k)
+      {
+          double sum = 0;
+          for (std::size_t i = 0; i <= k; ++i)
+          {
+              sum += std::exp(std::lgamma(n + 1.0) - std::lgamma(i + 1.0) - std::lgamma(n - i + 1.0) - n * std::log(2.0));
+          }
+          return sum;
+      }
+
+      std::string formatNanoseconds(double ns)
+      {
+          std::ostringstream text;
+          text << std::fixed << std::setprecision(ns < 10 ? 2 : 1);
+          if      (ns < 1e3) text << ns << " ns";
+          else if (ns < 1e6) text << ns / 1e3 << " us";
+          else if (ns < 1e9) text << ns / 1e6 << " ms";
+          else               text << ns / 1e9 << " s";
+          return text.str();
+      }
+
+      const char * verdictName(Comparison::Verdict verdict)
+      {
+          switch (verdict)
+          {
+              case Comparison::Verdict::unchanged: return "unchanged";
+              case Comparison::Verdict::noisy:     return "noisy";
+              case Comparison::Verdict::faster:    return "FASTER";
+              case Comparison::Verdict::regressed: return "REGRESSED";
+              case Comparison::Verdict::added:     return "new";
+              case Comparison::Verdict::removed:   return "missing";
+          }
+          return "";
+      }
+  }
+
+  void SampleCollector::ReportRuns(const std::vector<Run> & runs)
+  {
+      std::vector<Run> displayed;
+      for (const Run & run : runs)
+      {
+          if (run.run_type == Run::RT_Iteration && ! run.error_occurred)
+          {
+              // The time the benchmark is measured by: real (or manual) time if it asks for it.
+              const double time = run.run_name.time_type.empty() ? run.GetAdjustedCPUTime() : run.GetAdjustedRealTime();
+              const double nanoseconds = time / benchmark::GetTimeUnitMultiplier(run.time_unit) * 1e9;
+              collected[run.benchmark_name()].push_back(nanoseconds);
+          }
+          if (run.run_type == Run::RT_Aggregate || run.error_occurred || run.repetitions <= 1) displayed.push_back(run);
+      }
+      ConsoleReporter::ReportRuns(displayed);
+  }
+
+  const Samples & SampleCollector::samples() const
+  {
+      return collected;
+  }
+
+  void saveBaseline(const std::string & filepath, const Samples & samples)
+  {
+      std::ofstream out(filepath, std::ios::trunc);
+      if (! out) throw std::runtime_error("Cannot write " + filepath);
+
+      out << "{\n  \"benchmarks\": [";
+      bool first = true;
+      for (const auto & [name, times] : samples)
+      {
+          out << (first ? "\n" : ",\n") << "    { \"name\": ";
+          writeJsonString(out, name);
+          out << ", \"unit\": \"ns\", \"samples\": [";
+          out << std::setprecision(9);
+          for (std::size_t i = 0; i < times.size(); ++i) out << (i ? ", " : " ") << times[i];
+          out << " ] }";
+          first = false;
+      }
+      out << "\n  ]\n}\n";
+
+      out.flush();
+      if (! out) throw std::runtime_error("Failed to write " + filepath);
+  }
+
+  Samples loadBaseline(const std::string & filepath)
+  {
+      std::ifstream in(filepath);
+      if (! in) throw std::runtime_error("Cannot read " + filepath);
+      const std::string text((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+
+      const JsonValue document = JsonParser(text).parseDocument();
+      Samples samples;
+      for (const JsonValue & benchmark : member(document, "benchmarks", JsonValue::Type::array).elements)
+      {
+          const std::string & name = member(benchmark, "name", JsonValue::Type::string).text;
+          if (member(benchmark, "unit", JsonValue::Type::string).text != "ns")
+          {
+              throw std::runtime_error("Baseline for " + name + " is not in nanoseconds.");
+          }
+          std::vector<double> & times = samples[name];
+          for (const JsonValue & sample : member(benchmark, "samples", JsonValue::Type::array).elements)
+          {
+              if (sample.type != JsonValue::Type::number) throw std::runtime_error("Baseline samples must be numbers.");
+              times.push_back(sample.number);
+          }
+          if (times.empty()) throw std::runtime_error("Baseline for " + name + " has no samples.");
+      }
+      return samples;
+  }
+
+  double median(std::vector<double> samples)
+  {
+      std::sort(samples.begin(), samples.end());
+      const std::size_t n = samples.size();
+      return (n % 2 == 1) ? samples[n/2] : (samples[n/2 - 1] + samples[n/2]) / 2;
+  }
+
+  Interval medianConfidenceInterval(std::vector<double> samples, double confidence)
+  {
+      std::sort(samples.begin(), samples.end());
+      const std::size_t n = samples.size();
+      const double alpha = 1 - confidence;
+
+      /* The interval between the l-th smallest and l-th largest samples (counting from 1)
+       * contains the median with probability 1 - 2*P(X < l), where X ~ Binomial(n, 1/2).
+       * Take the narrowest such interval with at least the requested confidence.
+       */
+      std::size_t l = 1;
+      while (l < (n + 1) / 2 && 2 * binomialHalfCDF(n, l) <= alpha) ++l;
+      return {samples[l - 1], samples[n - l]};
+  }
+
+  std::vector<Comparison> compare(const Samples & baseline, const Samples & current, double threshold)
+  {
+      std::vector<Comparison> comparisons;
+
+      for (const auto & [name, times] : baseline)
+      {
+          Comparison comparison;
+          comparison.name = name;
+          comparison.baselineMedian = median(times);
+          comparison.baselineInterval = medianConfidenceInterval(times);
+
+          auto it = current.find(name);
+          if (it == current.end() || it->second.empty())
+          {
+              comparison.verdict = Comparison::Verdict::removed;
+              comparisons.push_back(comparison);
+              continue;
+          }
+
+          comparison.currentMedian = median(it->second);
+          comparison.currentInterval = medianConfidenceInterval(it->second);
+          comparison.change = comparison.currentMedian / comparison.baselineMedian - 1;
+
+          if (comparison.change > threshold)
+          {
+              comparison.verdict = (comparison.currentInterval.lower > comparison.baselineInterval.upper)
+                                   ? Comparison::Verdict::regressed : Comparison::Verdict::noisy;
+          }
+          else if (comparison.change < -threshold)
+          {
+              comparison.verdict = (comparison.currentInterval.upper < comparison.baselineInterval.lower)
+                                   ? Comparison::Verdict::faster : Comparison::Verdict::noisy;
+          }
+          else
+          {
+              comparison.verdict = Comparison::Verdict::unchanged;
+          }
+          comparisons.push_back(comparison);
+      }
+
+      for (const auto & [name, times] : current)
+      {
+          if (baseline.count(name) > 0 || times.empty()) continue;
+          Comparison comparison;
+          comparison.name = name;
+          comparison.verdict = Comparison::Verdict::added;
+          comparison.currentMedian = median(times);
+          comparison.currentInterval = medianConfidenceInterval(times);
+          comparisons.push_back(comparison);
+      }
+
+      return comparisons;
+  }
+
+  bool anyRegressed(const std::vector<Comparison> & comparisons)
+  {
+      return std::any_of(comparisons.begin(), comparisons.end(),
+                         [](const Comparison & c) { return c.verdict == Comparison::Verdict::regressed; });
+  }
+
+  void printComparisons(std::ostream & out, const std::vector<Comparison> & comparisons)
+  {
+      std::size_t nameWidth = 9;
+      for (const Comparison & c : comparisons) nameWidth = std::max(nameWidth, c.name.size());
+
+      out << std::left << std::setw(nameWidth + 2) << "Benchmark" << std::right
+          << std::setw(14) << "Baseline" << std::setw(14) << "Current" << std::setw(10) << "Change"
+          << std::setw(30) << "Current 95% CI" << "  Verdict\n";
+
+      for (const Comparison & c : comparisons)
+      {
+          const bool hasBaseline = c.verdict != Comparison::Verdict::added;
+          const bool hasCurrent = c.verdict != Comparison::Verdict::removed;
+
+          std::ostringstream change;
+          if (hasBaseline && hasCurrent) change << std::showpos << std::fixed << std::setprecision(1) << c.change * 100 << "%";
+
+          out << std::left << std::setw(nameWidth + 2) << c.name << std::right
+              << std::setw(14) << (hasBaseline ? formatNanoseconds(c.baselineMedian) : "-")
+              << std::setw(14) << (hasCurrent ? formatNanoseconds(c.currentMedian) : "-")
+              << std::setw(10) << change.str()
+              << std::setw(30) << (hasCurrent ? "[" + formatNanoseconds(c.currentInterval.lower) + ", "
+                                                    + formatNanoseconds(c.currentInterval.upper) + "]" : "-")
+              << "  " << verdictName(c.verdict) << "\n";
+      }
+  }
+}
@@ -0,0 +1,96 @@
+#ifndef GPS_BENCHMARK_BASELINE_H
+#define GPS_BENCHMARK_BASELINE_H
+
+#include <map>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+namespace GPS::Benchmarks
+{
+  // The time per iteration (in nanoseconds) of every repetition, for each benchmark.
+  using Samples = std::map<std::string, std::vector<double>>;
+
+
+  /* A console reporter that keeps the time per iteration of every repetition, and only
+   * displays the aggregates (means, medians, etc.) of repeated benchmarks.  The time kept
+   * is the CPU time, or the real time for benchmarks that use real (or manual) time, so
+   * that I/O-bound and multithreaded benchmarks are compared by their elapsed time.
+   */
+  class SampleCollector : public benchmark::ConsoleReporter
+  {
+    public:
+
+      void ReportRuns(const std::vector<Run> &) override;
+
+      const Samples & samples() const;
+
+    private:
+
+      Samples collected;
+  };
+
+
+  /* Baseline files are JSON, in the form:
+   *   { "benchmarks": [ { "name": "BM_ddmTodd/realLogs", "unit": "ns", "samples": [ 165.2, ... ] }, ... ] }
+   *
+   * Throws a std::runtime_error exception if the file cannot be written, or cannot be read
+   * or is not in this form.
+   */
+  void saveBaseline(const std::string & filepath, const Samples &);
+  Samples loadBaseline(const std::string & filepath);
+
+
+  double median(std::vector<double> samples);
+
+  struct Interval
+  {
+      double lower;
+      double upper;
+  };
+
+  /* A distribution-free confidence interval for the median, between two order statistics
+   * of the samples.  With 8 or fewer samples, the 95% interval is the whole range.
+   *
+   * Pre-condition: there is at least one sample.
+   */
+  Interval medianConfidenceInterval(std::vector<double> samples, double confidence = 0.95);
+
+
+  struct Comparison
+  {
+      enum class Verdict
+      {
+          unchanged,  // within the threshold
+          noisy,      // beyond the threshold, but the confidence intervals overlap
+          faster,     // beyond the threshold, and the intervals are disjoint
+          regressed,  // beyond the threshold, and the intervals are disjoint
+          added,      // not in the baseline
+          removed     // only in the baseline
+      };
+
+      std::string name;
+      Verdict verdict;
+      double baselineMedian = 0;
+      double currentMedian = 0;
+      Interval baselineInterval = {0, 0};
+      Interval currentInterval = {0, 0};
+
+      // The relative change in the median: +0.1 is 10% slower.
+      double change = 0;
+  };
+
+  /* Compares each benchmark's current samples with its baseline samples.  'threshold' is
+   * the relative change in the median (e.g. 0.1 for 10%) beyond which a benchmark counts
+   * as slower or faster, if the 95% confidence intervals of the medians do not overlap.
+   */
+  std::vector<Comparison> compare(const Samples & baseline, const Samples & current, double threshold);
+
+  bool anyRegressed(const std::vector<Comparison> &);
+
+  void printComparisons(std::ostream &, const std::vector<Comparison> &);
+}
+
+#endif
@@ -0,0 +1,133 @@
+#include <fstream>
+#include <iterator>
+#include <map>
+#include <sstream>
+#include <stdexcept>
+
+#include "dataFiles.h"
+#include "generator.h"
+#include "benchmark-inputs.h"
+
+namespace GPS::Benchmarks
+{
+  namespace
+  {
+      const char * const logFiles[] = {"gll.log", "gga_rmc-1.log", "gga_rmc-2.log"};
+
+      // Kept small, because the regular expression in the parser makes large inputs slow.
+      const std::uint64_t syntheticBytes = 128 * 1024;
+      const double syntheticCorruptionRate = 0.05;
+
+      struct Inputs
+      {
+          std::string text;
+          std::vector<std::string> lines;
+          std::vector<std::string> structuredSentences;
+          std::vector<NMEA::SentenceData> sentenceData;
+          std::vector<std::string> ddmAngles;
+          std::vector<Position> positions;
+      };
+
+      std::string readText(InputSet set)
+      {
+          std::string text;
+          if (set == InputSet::realLogs)
+          {
+              for (const char * filename : logFiles)
+              {
+                  std::ifstream file(DataFiles::NMEADir + filename, std::ios::binary);
+                  if (! file)
+                  {
+                      throw std::runtime_error("Cannot open " + DataFiles::NMEADir + filename
+                                               + " (run the benchmarks from the 'bin/' directory).");
+                  }
+                  text.append(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+              }
+          }
+          else
+          {
+              NMEA::GeneratorOptions options;
+              options.targetBytes = syntheticBytes;
+              options.corruptionRate = syntheticCorruptionRate;
+              std::ostringstream stream;
+              NMEA::generateSentences(stream, options);
+              text = stream.str();
+          }
+          return text;
+      }
+
+      Inputs load(InputSet set)
+      {
+          Inputs inputs;
+          inputs.text = readText(set);
+
+          std::istringstream stream(inputs.text);
+          std::string line;
+          while (std::getline(stream, line))
+          {
+              if (! line.empty() && line.back() == '\r') line.pop_back();
+              if (line.empty()) continue;
+              inputs.lines.push_back(line);
+
+              if (! NMEA::hasValidSentenceStructure(line)) continue;
+              inputs.structuredSentences.push_back(line);
+
+              if (! NMEA::checksumMatches(line)) continue;
+              NMEA::SentenceData data = NMEA::parseSentence(line);
+              if (! NMEA::isSupportedFormat(data.format) || ! NMEA::hasCorrectNumberOfFields(data)) continue;
+              try
+              {
+                  inputs.positions.push_back(NMEA::positionFromSentenceData(data));
+              }
+              catch (const std::domain_error &)
+              {
+                  continue;
+              }
+
+              const std::size_t latIndex = (data.format == "GLL") ? 0 : (data.format == "GGA") ? 1 : 2;
+              inputs.ddmAngles.emplace_back(data.dataFields[latIndex]);
+              inputs.ddmAngles.emplace_back(data.dataFields[latIndex + 2]);
+              inputs.sentenceData.push_back(std::move(data));
+          }
+          return inputs;
+      }
+
+      const Inputs & inputs(InputSet set)
+      {
+          static std::map<InputSet, Inputs> loaded;
+          auto it = loaded.find(set);
+          if (it == loaded.end()) it = loaded.emplace(set, load(set)).first;
+          return it->second;
+      }
+  }
+
+  const std::string & text(InputSet set)
+  {
+      return inputs(set).text;
+  }
+
+  const std::vector<std::string> & lines(InputSet set)
+  {
+      return inputs(set).lines;
+  }
+
+  const std::vector<std::string> & structuredSentences(InputSet set)
+  {
+      return inputs(set).structuredSentences;
+  }
+
+  const std::vector<NMEA::SentenceData> & sentenceData(InputSet set)
+  {
+      return inputs(set).sentenceData;
+  }
+
+  const std::vector<std::string> & ddmAngles(InputSet set)
+  {
+      return inputs(set).ddmAngles;
+  }
+
+  const std::vector<Position> & positions(InputSet set)
+  {
+      return inputs(set).positions;
+  }
+}
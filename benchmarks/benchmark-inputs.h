@@ -0,0 +1,65 @@
+#ifndef GPS_BENCHMARK_INPUTS_H
+#define GPS_BENCHMARK_INPUTS_H
+
+#include <string>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "nmea-parser.h"
+#include "position.h"
+
+namespace GPS::Benchmarks
+{
+  enum class InputSet
+  {
+      realLogs,  // the logs in data/NMEA/
+      synthetic  // generated sentences (see generator.h), with 5% of them corrupted
+  };
+
+  /* Each input set is loaded once, on first use.  The vectors below are views of the same
+   * text, filtered to meet the pre-conditions of the functions being benchmarked.
+   */
+
+  // The whole text, as it would be read from a file.
+  const std::string & text(InputSet);
+
+  // Every non-empty line, including invalid sentences.
+  const std::vector<std::string> & lines(InputSet);
+
+  // The lines that conform to the structure of NMEA sentences.
+  const std::vector<std::string> & structuredSentences(InputSet);
+
+  // The data of every valid sentence.
+  const std::vector<NMEA::SentenceData> & sentenceData(InputSet);
+
+  // The latitude and longitude fields (in DDM format) of every valid sentence.
+  const std::vector<std::string> & ddmAngles(InputSet);
+
+  // The Position from every valid sentence, in order.
+  const std::vector<Position> & positions(InputSet);
+
+
+  /* Run the function on each input in turn (starting again from the first when they run
+   * out), one input per benchmark iteration, and report the number of inputs processed.
+   */
+  template <typename Input, typename Function>
+  void cycleThrough(benchmark::State & state, const std::vector<Input> & inputs, Function function)
+  {
+      if (inputs.empty())
+      {
+          state.SkipWithError("No inputs.");
+          return;
+      }
+
+      auto input = inputs.begin();
+      for (auto _ : state)
+      {
+          benchmark::DoNotOptimize(function(*input));
+          if (++input == inputs.end()) input = inputs.begin();
+      }
+      state.SetItemsProcessed(state.iterations());
+  }
+}
+
+#endif
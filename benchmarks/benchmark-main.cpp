@@ -0,0 +1,128 @@
+#include <benchmark/benchmark.h>
+
+/* This file generates the main() function for the Google Benchmark program.
+ * The benchmarks themselves can be found in the other files in the 'benchmarks/' directory.
+ *
+ * Run it from the 'bin/' directory, so that the data files can be found.  For JSON output,
+ * use "--benchmark_format=json", or "--benchmark_out=FILE --benchmark_out_format=json" to
+ * write JSON to a file while keeping the console table.
+ *
+ * To catch performance regressions, the program also accepts:
+ *   --baseline_save=FILE         save the results as a baseline;
+ *   --baseline_compare=FILE      compare the results with a saved baseline, and exit with
+ *                                a non-zero status if any benchmark has regressed;
+ *   --regression_threshold=PCT   the slowdown of the median that counts as a regression,
+ *                                if the confidence intervals also do not overlap (default 10).
+ * With either baseline option, each benchmark is repeated 10 times unless
+ * "--benchmark_repetitions" is given, and only the aggregates are displayed (the
+ * "--benchmark_*_aggregates_only" options are ignored, as the comparison needs every
+ * repetition).
+ */
+
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "baseline.h"
+
+using namespace GPS::Benchmarks;
+
+namespace
+{
+  const char * const defaultRepetitions = "--benchmark_repetitions=10";
+  const double defaultThresholdPercent = 10;
+
+  // If the argument is "--name=value", removes the prefix and returns true.
+  bool takeOption(std::string & argument, const std::string & name)
+  {
+      const std::string prefix = "--" + name + "=";
+      if (argument.compare(0, prefix.size(), prefix) != 0) return false;
+      argument.erase(0, prefix.size());
+      return true;
+  }
+}
+
+int main(int argc, char * argv[])
+{
+    std::string saveFile, compareFile;
+    double thresholdPercent = defaultThresholdPercent;
+    bool repetitionsGiven = false;
+
+    // Take out the baseline options; the rest are for Google Benchmark.
+    std::vector<char*> benchmarkArgs = {argv[0]};
+    std::vector<char*> aggregatesOnlyArgs;
+    try
+    {
+        for (int i = 1; i < argc; ++i)
+        {
+            std::string argument = argv[i];
+            if      (takeOption(argument, "baseline_save"))        saveFile = argument;
+            else if (takeOption(argument, "baseline_compare"))     compareFile = argument;
+            else if (takeOption(argument, "regression_threshold")) thresholdPercent = std::stod(argument);
+            else if (takeOption(argument, "benchmark_report_aggregates_only")
+                     || takeOption(argument, "benchmark_display_aggregates_only"))
+            {
+                aggregatesOnlyArgs.push_back(argv[i]);
+            }
+            else
+            {
+                repetitionsGiven = repetitionsGiven || takeOption(argument, "benchmark_repetitions");
+                benchmarkArgs.push_back(argv[i]);
+            }
+        }
+    }
+    catch (const std::exception &)
+    {
+        std::cerr << "Invalid --regression_threshold: it must be a percentage.\n";
+        return EXIT_FAILURE;
+    }
+
+    const bool baselineMode = ! saveFile.empty() || ! compareFile.empty();
+    if (baselineMode && ! repetitionsGiven) benchmarkArgs.push_back(const_cast<char*>(defaultRepetitions));
+    if (! baselineMode) benchmarkArgs.insert(benchmarkArgs.end(), aggregatesOnlyArgs.begin(), aggregatesOnlyArgs.end());
+
+    int benchmarkArgc = static_cast<int>(benchmarkArgs.size());
+    benchmarkArgs.push_back(nullptr);
+    benchmark::Initialize(&benchmarkArgc, benchmarkArgs.data());
+    if (benchmark::ReportUnrecognizedArguments(benchmarkArgc, benchmarkArgs.data())) return EXIT_FAILURE;
+
+    if (! baselineMode)
+    {
+        benchmark::RunSpecifiedBenchmarks();
+        benchmark::Shutdown();
+        return EXIT_SUCCESS;
+    }
+
+    SampleCollector collector;
+    benchmark::RunSpecifiedBenchmarks(&collector);
+    benchmark::Shutdown();
+
+    try
+    {
+        int status = EXIT_SUCCESS;
+        if (! compareFile.empty())
+        {
+            const std::vector<Comparison> comparisons = compare(loadBaseline(compareFile), collector.samples(),
+                                                                thresholdPercent / 100);
+            std::cout << "\nComparison with " << compareFile << " (threshold " << thresholdPercent << "%):\n";
+            printComparisons(std::cout, comparisons);
+            if (anyRegressed(comparisons))
+            {
+                std::cout << "\nPerformance has regressed.\n";
+                status = EXIT_FAILURE;
+            }
+        }
+        if (! saveFile.empty())
+        {
+            saveBaseline(saveFile, collector.samples());
+            std::cout << "\nBaseline saved to " << saveFile << "\n";
+        }
+        return status;
+    }
+    catch (const std::exception & e)
+    {
+        std::cerr << e.what() << "\n";
+        return EXIT_FAILURE;
+    }
+}
@@ -0,0 +1,49 @@
+#include <benchmark/benchmark.h>
+
+#include <random>
+
+#include "clustering.h"
+#include "earth.h"
+#include "geometry.h"
+#include "benchmark-inputs.h"
+
+using namespace GPS;
+using namespace GPS::Benchmarks;
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+/* The specified number of Positions, scattered up to 100m from random Positions of the
+ * input track, like the stops from many logs of vehicles on the same routes.
+ */
+std::vector<Position> scatteredAround(InputSet set, std::size_t count)
+{
+    const std::vector<Position> & track = positions(set);
+    std::mt19937_64 random(count);
+    std::uniform_int_distribution<std::size_t> index(0, track.size() - 1);
+    std::uniform_real_distribution<metres> offset(-100, 100);
+
+    std::vector<Position> scattered;
+    scattered.reserve(count);
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        scattered.push_back(Earth::offsetPositions({track[index(random)]}, offset(random), offset(random)).front());
+    }
+    return scattered;
+}
+
+// Clusters of at least 20 Positions within 25m of each other.
+void BM_clusterPositions(benchmark::State & state, InputSet set)
+{
+    const std::vector<Position> scattered = scatteredAround(set, state.range(0));
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(clusterPositions(scattered, 25, 20));
+    }
+    state.SetItemsProcessed(state.iterations() * scattered.size());
+}
+BENCHMARK_CAPTURE(BM_clusterPositions, realLogs, InputSet::realLogs)
+    ->Arg(10000)->Arg(100000)->Arg(1000000)->Unit(benchmark::kMillisecond)->UseRealTime();
+BENCHMARK_CAPTURE(BM_clusterPositions, synthetic, InputSet::synthetic)
+    ->Arg(10000)->Arg(100000)->Arg(1000000)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+/////////////////////////////////////////////////////////////////////////////////////////
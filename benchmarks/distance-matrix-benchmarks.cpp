@@ -0,0 +1,77 @@
+#include <benchmark/benchmark.h>
+
+#include "distance-matrix.h"
+#include "benchmark-inputs.h"
+
+using namespace GPS;
+using namespace GPS::Benchmarks;
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+// The input track split into the specified number of Tracks, like a fleet on the same roads.
+std::vector<Track> fleet(InputSet set, std::size_t trackCount)
+{
+    const std::vector<Position> & track = positions(set);
+    std::vector<Track> tracks(trackCount);
+    for (std::size_t i = 0; i < track.size(); ++i)
+    {
+        Track & t = tracks[i * trackCount / track.size()];
+        t.append(track[i], double(t.size()));
+    }
+    return tracks;
+}
+
+// The distances between every fix of one half of the input track and every fix of the other.
+void BM_distanceMatrix(benchmark::State & state, InputSet set)
+{
+    const std::vector<Track> halves = fleet(set, 2);
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(distanceMatrix(halves[0], halves[1]).data());
+    }
+    state.SetItemsProcessed(state.iterations() * halves[0].size() * halves[1].size());
+}
+BENCHMARK_CAPTURE(BM_distanceMatrix, realLogs, InputSet::realLogs)->Unit(benchmark::kMillisecond)->UseRealTime();
+BENCHMARK_CAPTURE(BM_distanceMatrix, synthetic, InputSet::synthetic)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+// The same distances, with Position::horizontalDistanceBetween() in nested loops.
+void BM_distanceMatrixByNestedLoops(benchmark::State & state, InputSet set)
+{
+    const std::vector<Track> halves = fleet(set, 2);
+    std::vector<metres> matrix(halves[0].size() * halves[1].size());
+    for (auto _ : state)
+    {
+        for (std::size_t i = 0; i < halves[0].size(); ++i)
+        {
+            for (std::size_t j = 0; j < halves[1].size(); ++j)
+            {
+                matrix[i * halves[1].size() + j] = Position::horizontalDistanceBetween(halves[0].position(i), halves[1].position(j));
+            }
+        }
+        benchmark::DoNotOptimize(matrix.data());
+    }
+    state.SetItemsProcessed(state.iterations() * matrix.size());
+}
+BENCHMARK_CAPTURE(BM_distanceMatrixByNestedLoops, realLogs, InputSet::realLogs)->Unit(benchmark::kMillisecond)->UseRealTime();
+BENCHMARK_CAPTURE(BM_distanceMatrixByNestedLoops, synthetic, InputSet::synthetic)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+// The pairs of fixes within 50m of each other, between 16 Tracks.
+void BM_closePairs(benchmark::State & state, InputSet set)
+{
+    const std::vector<Track> tracks = fleet(set, 16);
+    std::size_t fixes = 0;
+    for (const Track & track : tracks) fixes += track.size();
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(closePairs(tracks, 50).data());
+    }
+    // Items are pairs of fixes considered.
+    state.SetItemsProcessed(state.iterations() * (fixes * fixes - fixes * fixes / tracks.size()) / 2);
+}
+BENCHMARK_CAPTURE(BM_closePairs, realLogs, InputSet::realLogs)->Unit(benchmark::kMillisecond)->UseRealTime();
+BENCHMARK_CAPTURE(BM_closePairs, synthetic, InputSet::synthetic)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+/////////////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,69 @@
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+
+#include "geofence.h"
+#include "geometry.h"
+#include "benchmark-inputs.h"
+
+using namespace GPS;
+using namespace GPS::Benchmarks;
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+/* A geofence with the specified number of circles (of 50m to 2km radius), spread evenly
+ * over a square around the middle of the input track.  The square grows with the number of
+ * zones, so that the density of zones (about 10,000 per square degree) stays the same.
+ */
+Geofence zonesAround(InputSet set, std::size_t zoneCount)
+{
+    const std::vector<Position> & track = positions(set);
+    const Position & middle = track[track.size() / 2];
+    const degrees halfSide = std::sqrt(zoneCount / 10000.0) / 2;
+
+    std::mt19937_64 random(zoneCount);
+    std::uniform_real_distribution<degrees> offset(-halfSide, halfSide);
+    std::uniform_real_distribution<metres> radius(50, 2000);
+
+    Geofence geofence;
+    for (std::size_t i = 0; i < zoneCount; ++i)
+    {
+        const degrees lat = std::clamp(middle.latitude() + offset(random), -89.0, 89.0);
+        const degrees lon = normaliseDegrees(middle.longitude() + offset(random));
+        geofence.addCircle(Position(lat, lon, 0), radius(random));
+    }
+    return geofence;
+}
+
+void BM_Geofence_zonesContaining(benchmark::State & state, InputSet set)
+{
+    const Geofence geofence = zonesAround(set, state.range(0));
+    cycleThrough(state, positions(set), [&](const Position & p) { return geofence.zonesContaining(p); });
+}
+BENCHMARK_CAPTURE(BM_Geofence_zonesContaining, realLogs, InputSet::realLogs)->Arg(1000)->Arg(10000)->Arg(100000);
+BENCHMARK_CAPTURE(BM_Geofence_zonesContaining, synthetic, InputSet::synthetic)->Arg(1000)->Arg(10000)->Arg(100000);
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+// The whole input track as one batch of fixes for a single subject, one second apart.
+void BM_Geofence_update(benchmark::State & state, InputSet set)
+{
+    Geofence geofence = zonesAround(set, state.range(0));
+    const std::vector<Position> & track = positions(set);
+
+    std::vector<Fix> fixes;
+    for (std::size_t i = 0; i < track.size(); ++i) fixes.push_back({0, track[i], double(i)});
+
+    for (auto _ : state)
+    {
+        geofence.forget(0);
+        benchmark::DoNotOptimize(geofence.update(fixes));
+    }
+    state.SetItemsProcessed(state.iterations() * fixes.size());
+}
+BENCHMARK_CAPTURE(BM_Geofence_update, realLogs, InputSet::realLogs)->Arg(1000)->Arg(10000)->Arg(100000);
+BENCHMARK_CAPTURE(BM_Geofence_update, synthetic, InputSet::synthetic)->Arg(1000)->Arg(10000)->Arg(100000);
+
+/////////////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,195 @@
+#include <benchmark/benchmark.h>
+
+#include <cmath>
+
+#include "earth.h"
+#include "fix-filter.h"
+#include "position.h"
+#include "stay-points.h"
+#include "track.h"
+#include "track-statistics.h"
+#include "benchmark-inputs.h"
+
+using namespace GPS;
+using namespace GPS::Benchmarks;
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+void BM_ddmTodd(benchmark::State & state, InputSet set)
+{
+    cycleThrough(state, ddmAngles(set), [](const std::string & ddm) { return ddmTodd(ddm); });
+}
+BENCHMARK_CAPTURE(BM_ddmTodd, realLogs, InputSet::realLogs);
+BENCHMARK_CAPTURE(BM_ddmTodd, synthetic, InputSet::synthetic);
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+// The distance between each Position and the next along the track.
+void BM_horizontalDistanceBetween(benchmark::State & state, InputSet set)
+{
+    const std::vector<Position> & track = positions(set);
+    std::vector<std::pair<Position,Position>> legs;
+    for (std::size_t i = 1; i < track.size(); ++i) legs.emplace_back(track[i-1], track[i]);
+
+    cycleThrough(state, legs, [](const std::pair<Position,Position> & leg)
+    {
+        return Position::horizontalDistanceBetween(leg.first, leg.second);
+    });
+}
+BENCHMARK_CAPTURE(BM_horizontalDistanceBetween, realLogs, InputSet::realLogs);
+BENCHMARK_CAPTURE(BM_horizontalDistanceBetween, synthetic, InputSet::synthetic);
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+// A 1km box around every Position of the input track, one Position at a time.
+void BM_boundingBox(benchmark::State & state, InputSet set)
+{
+    const std::vector<Position> & track = positions(set);
+    std::vector<BoundingBox> boxes(track.size());
+    for (auto _ : state)
+    {
+        for (std::size_t i = 0; i < track.size(); ++i)
+        {
+            const degrees lat = track[i].latitude(), lon = track[i].longitude();
+            const degrees latitudeDistance = Earth::latitudeSubtendedBy(1000);
+            const degrees longitudeDistance = Earth::longitudeSubtendedBy(1000, lat);
+            boxes[i] = {lat - latitudeDistance, lat + latitudeDistance,
+                        normaliseDegrees(lon - longitudeDistance), normaliseDegrees(lon + longitudeDistance)};
+        }
+        benchmark::DoNotOptimize(boxes.data());
+    }
+    state.SetItemsProcessed(state.iterations() * track.size());
+}
+BENCHMARK_CAPTURE(BM_boundingBox, realLogs, InputSet::realLogs);
+BENCHMARK_CAPTURE(BM_boundingBox, synthetic, InputSet::synthetic);
+
+// A 1km box around every Position of the input track, as one batch.
+void BM_boundingBoxes(benchmark::State & state, InputSet set)
+{
+    const std::vector<Position> & track = positions(set);
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(Earth::boundingBoxes(track, 1000));
+    }
+    state.SetItemsProcessed(state.iterations() * track.size());
+}
+BENCHMARK_CAPTURE(BM_boundingBoxes, realLogs, InputSet::realLogs);
+BENCHMARK_CAPTURE(BM_boundingBoxes, synthetic, InputSet::synthetic);
+
+// Moving every Position of the input track 100m North and 100m East, as one batch.
+void BM_offsetPositions(benchmark::State & state, InputSet set)
+{
+    const std::vector<Position> & track = positions(set);
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(Earth::offsetPositions(track, 100, 100));
+    }
+    state.SetItemsProcessed(state.iterations() * track.size());
+}
+BENCHMARK_CAPTURE(BM_offsetPositions, realLogs, InputSet::realLogs);
+BENCHMARK_CAPTURE(BM_offsetPositions, synthetic, InputSet::synthetic);
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+// Adding each Position of the input track in turn.
+void BM_TrackStatistics_add(benchmark::State & state, InputSet set)
+{
+    const std::vector<Position> & track = positions(set);
+    TrackStatistics statistics;
+    auto p = track.begin();
+    for (auto _ : state)
+    {
+        statistics.add(*p);
+        if (++p == track.end()) p = track.begin();
+    }
+    benchmark::DoNotOptimize(statistics.totalDistance());
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK_CAPTURE(BM_TrackStatistics_add, realLogs, InputSet::realLogs);
+BENCHMARK_CAPTURE(BM_TrackStatistics_add, synthetic, InputSet::synthetic);
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+// The input track as fixes one second apart.
+Track timedTrack(InputSet set)
+{
+    const std::vector<Position> & track = positions(set);
+    Track timed;
+    for (std::size_t i = 0; i < track.size(); ++i) timed.append(track[i], double(i));
+    return timed;
+}
+
+// Filtering the whole input track, one fix at a time.
+void BM_FixFilter_add(benchmark::State & state, InputSet set)
+{
+    const Track fixes = timedTrack(set);
+    for (auto _ : state)
+    {
+        FixFilter filter;
+        for (std::size_t i = 0; i < fixes.size(); ++i) benchmark::DoNotOptimize(filter.add(fixes.position(i), fixes.time(i)));
+    }
+    state.SetItemsProcessed(state.iterations() * fixes.size());
+}
+BENCHMARK_CAPTURE(BM_FixFilter_add, realLogs, InputSet::realLogs);
+BENCHMARK_CAPTURE(BM_FixFilter_add, synthetic, InputSet::synthetic);
+
+// Filtering the whole input track as one batch.
+void BM_FixFilter_addBatch(benchmark::State & state, InputSet set)
+{
+    const Track fixes = timedTrack(set);
+    for (auto _ : state)
+    {
+        FixFilter filter;
+        benchmark::DoNotOptimize(filter.add(fixes));
+    }
+    state.SetItemsProcessed(state.iterations() * fixes.size());
+}
+BENCHMARK_CAPTURE(BM_FixFilter_addBatch, realLogs, InputSet::realLogs);
+BENCHMARK_CAPTURE(BM_FixFilter_addBatch, synthetic, InputSet::synthetic);
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+// Interpolating the input track at random times, one at a time.
+void BM_Track_positionAt(benchmark::State & state, InputSet set)
+{
+    const Track fixes = timedTrack(set);
+    std::vector<double> times;
+    for (std::size_t i = 0; i < 4096; ++i) times.push_back(std::fmod(i * 7919.37, fixes.time(fixes.size() - 1)));
+
+    cycleThrough(state, times, [&](double t) { return fixes.positionAt(t); });
+}
+BENCHMARK_CAPTURE(BM_Track_positionAt, realLogs, InputSet::realLogs);
+BENCHMARK_CAPTURE(BM_Track_positionAt, synthetic, InputSet::synthetic);
+
+// Resampling the whole input track every 0.25 seconds, as one batch.
+void BM_Track_resampled(benchmark::State & state, InputSet set)
+{
+    const Track fixes = timedTrack(set);
+    std::size_t samples = 0;
+    for (auto _ : state)
+    {
+        const Track resampled = fixes.resampled(0.25);
+        samples += resampled.size();
+        benchmark::DoNotOptimize(resampled.latitudes().data());
+    }
+    state.SetItemsProcessed(samples);
+}
+BENCHMARK_CAPTURE(BM_Track_resampled, realLogs, InputSet::realLogs);
+BENCHMARK_CAPTURE(BM_Track_resampled, synthetic, InputSet::synthetic);
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+// Finding the stay points of the whole input track.
+void BM_findStayPoints(benchmark::State & state, InputSet set)
+{
+    const Track fixes = timedTrack(set);
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(findStayPoints(fixes, 50, 60));
+    }
+    state.SetItemsProcessed(state.iterations() * fixes.size());
+}
+BENCHMARK_CAPTURE(BM_findStayPoints, realLogs, InputSet::realLogs);
+BENCHMARK_CAPTURE(BM_findStayPoints, synthetic, InputSet::synthetic);
+
+/////////////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,98 @@
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+
+#include "geometry.h"
+#include "landmarks.h"
+#include "benchmark-inputs.h"
+
+using namespace GPS;
+using namespace GPS::Benchmarks;
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+/* The specified number of depots, spread evenly over a square around the middle of the
+ * input track, which grows with the number of depots (about 1,000 per square degree).
+ */
+std::vector<Landmark> depotsAround(InputSet set, std::size_t depotCount)
+{
+    const std::vector<Position> & track = positions(set);
+    const Position & middle = track[track.size() / 2];
+    const degrees halfSide = std::sqrt(depotCount / 1000.0) / 2;
+
+    std::mt19937_64 random(depotCount);
+    std::uniform_real_distribution<degrees> offset(-halfSide, halfSide);
+
+    std::vector<Landmark> depots;
+    for (std::size_t i = 0; i < depotCount; ++i)
+    {
+        const degrees lat = std::clamp(middle.latitude() + offset(random), -89.0, 89.0);
+        const degrees lon = normaliseDegrees(middle.longitude() + offset(random));
+        depots.push_back({"Depot " + std::to_string(i), Position(lat, lon, 0)});
+    }
+    return depots;
+}
+
+// For comparison: the haversine distance to every depot.
+void BM_nearestLandmarkByScan(benchmark::State & state, InputSet set)
+{
+    const std::vector<Landmark> depots = depotsAround(set, state.range(0));
+    cycleThrough(state, positions(set), [&](const Position & p)
+    {
+        std::size_t nearest = 0;
+        metres nearestDistance = Position::horizontalDistanceBetween(depots[0].position, p);
+        for (std::size_t i = 1; i < depots.size(); ++i)
+        {
+            const metres distance = Position::horizontalDistanceBetween(depots[i].position, p);
+            if (distance < nearestDistance)
+            {
+                nearest = i;
+                nearestDistance = distance;
+            }
+        }
+        return nearest;
+    });
+}
+BENCHMARK_CAPTURE(BM_nearestLandmarkByScan, realLogs, InputSet::realLogs)->Arg(100)->Arg(1000)->Arg(10000);
+BENCHMARK_CAPTURE(BM_nearestLandmarkByScan, synthetic, InputSet::synthetic)->Arg(100)->Arg(1000)->Arg(10000);
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+void BM_LandmarkIndex_nearest(benchmark::State & state, InputSet set)
+{
+    const LandmarkIndex index(depotsAround(set, state.range(0)));
+    cycleThrough(state, positions(set), [&](const Position & p) { return index.nearest(p).landmark; });
+}
+BENCHMARK_CAPTURE(BM_LandmarkIndex_nearest, realLogs, InputSet::realLogs)->Arg(100)->Arg(1000)->Arg(10000);
+BENCHMARK_CAPTURE(BM_LandmarkIndex_nearest, synthetic, InputSet::synthetic)->Arg(100)->Arg(1000)->Arg(10000);
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+void BM_LandmarkIndex_kNearest(benchmark::State & state, InputSet set)
+{
+    const LandmarkIndex index(depotsAround(set, 10000));
+    const std::size_t k = state.range(0);
+    cycleThrough(state, positions(set), [&](const Position & p) { return index.nearest(p, k).size(); });
+}
+BENCHMARK_CAPTURE(BM_LandmarkIndex_kNearest, realLogs, InputSet::realLogs)->Arg(5)->Arg(50);
+BENCHMARK_CAPTURE(BM_LandmarkIndex_kNearest, synthetic, InputSet::synthetic)->Arg(5)->Arg(50);
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+// Annotating the whole input track with the nearest of 10,000 depots.
+void BM_LandmarkIndex_nearestToEach(benchmark::State & state, InputSet set)
+{
+    const LandmarkIndex index(depotsAround(set, 10000));
+    const std::vector<Position> & track = positions(set);
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(index.nearestToEach(track));
+    }
+    state.SetItemsProcessed(state.iterations() * track.size());
+}
+BENCHMARK_CAPTURE(BM_LandmarkIndex_nearestToEach, realLogs, InputSet::realLogs);
+BENCHMARK_CAPTURE(BM_LandmarkIndex_nearestToEach, synthetic, InputSet::synthetic);
+
+/////////////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,35 @@
+# The Google Benchmark suite (needs libbenchmark), built separately from the tests:
+#     cd benchmarks && qmake nmea-benchmarks.pro && make
+# and run from bin/, as the tests are:
+#     cd bin && ./nmea-benchmarks --benchmark_filter=readSentences
+
+TEMPLATE = app
+CONFIG += console
+CONFIG -= app_bundle
+CONFIG -= qt
+
+include(../gps.pri)
+
+HEADERS += \
+    allocation-counter.h \
+    baseline.h \
+    benchmark-inputs.h
+
+SOURCES += \
+    benchmark-main.cpp \
+    allocation-counter.cpp \
+    baseline.cpp \
+    benchmark-inputs.cpp \
+    clustering-benchmarks.cpp \
+    distance-matrix-benchmarks.cpp \
+    geofence-benchmarks.cpp \
+    geometry-benchmarks.cpp \
+    landmark-benchmarks.cpp \
+    parser-benchmarks.cpp \
+    track-similarity-benchmarks.cpp
+
+OBJECTS_DIR = $$_PRO_FILE_PWD_/../bin/nmea-benchmarks-obj/
+DESTDIR = $$_PRO_FILE_PWD_/../bin/
+TARGET = nmea-benchmarks
+
+LIBS += -lbenchmark
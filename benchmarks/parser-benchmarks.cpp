@@ -0,0 +1,276 @@
+#include <filesystem>
+#include <fstream>
+#include <memory_resource>
+#include <sstream>
+
+#include <benchmark/benchmark.h>
+
+#include "line-reader.h"
+#include "nmea-parser.h"
+#include "position-range.h"
+#include "sentence-scanner.h"
+#include "structural-index.h"
+#include "track-statistics-reader.h"
+#include "allocation-counter.h"
+#include "benchmark-inputs.h"
+
+using namespace GPS;
+using namespace GPS::NMEA;
+using namespace GPS::Benchmarks;
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+void BM_isSupportedFormat(benchmark::State & state, InputSet set)
+{
+    std::vector<std::string> formats;
+    for (const std::string & sentence : structuredSentences(set)) formats.push_back(sentence.substr(3,3));
+
+    cycleThrough(state, formats, [](const std::string & format) { return isSupportedFormat(format); });
+}
+BENCHMARK_CAPTURE(BM_isSupportedFormat, realLogs, InputSet::realLogs);
+BENCHMARK_CAPTURE(BM_isSupportedFormat, synthetic, InputSet::synthetic);
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+void BM_hasValidSentenceStructure(benchmark::State & state, InputSet set)
+{
+    cycleThrough(state, lines(set), [](const std::string & line) { return hasValidSentenceStructure(line); });
+}
+BENCHMARK_CAPTURE(BM_hasValidSentenceStructure, realLogs, InputSet::realLogs);
+BENCHMARK_CAPTURE(BM_hasValidSentenceStructure, synthetic, InputSet::synthetic);
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+void BM_checksumMatches(benchmark::State & state, InputSet set)
+{
+    cycleThrough(state, structuredSentences(set), [](const std::string & sentence) { return checksumMatches(sentence); });
+}
+BENCHMARK_CAPTURE(BM_checksumMatches, realLogs, InputSet::realLogs);
+BENCHMARK_CAPTURE(BM_checksumMatches, synthetic, InputSet::synthetic);
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+void BM_parseSentence(benchmark::State & state, InputSet set)
+{
+    cycleThrough(state, structuredSentences(set), [](const std::string & sentence) { return parseSentence(sentence); });
+}
+BENCHMARK_CAPTURE(BM_parseSentence, realLogs, InputSet::realLogs);
+BENCHMARK_CAPTURE(BM_parseSentence, synthetic, InputSet::synthetic);
+
+/* Every line checked and parsed into SentenceData, allocated either from the heap or from a
+ * SentenceArena that is released after each line.
+ */
+void BM_validSentenceData(benchmark::State & state, InputSet set, bool inArena)
+{
+    SentenceArena arena;
+    std::pmr::memory_resource * resource = inArena ? arena.resource() : std::pmr::new_delete_resource();
+
+    const std::size_t before = heapAllocations();
+    cycleThrough(state, lines(set), [&](const std::string & line)
+    {
+        const bool valid = validSentenceData(line, resource).has_value();
+        arena.release();
+        return valid;
+    });
+    reportHeapAllocations(state, before);
+}
+BENCHMARK_CAPTURE(BM_validSentenceData, heap/realLogs, InputSet::realLogs, false);
+BENCHMARK_CAPTURE(BM_validSentenceData, heap/synthetic, InputSet::synthetic, false);
+BENCHMARK_CAPTURE(BM_validSentenceData, arena/realLogs, InputSet::realLogs, true);
+BENCHMARK_CAPTURE(BM_validSentenceData, arena/synthetic, InputSet::synthetic, true);
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+void BM_positionFromSentenceData(benchmark::State & state, InputSet set)
+{
+    cycleThrough(state, sentenceData(set), [](const SentenceData & data) { return positionFromSentenceData(data); });
+}
+BENCHMARK_CAPTURE(BM_positionFromSentenceData, realLogs, InputSet::realLogs);
+BENCHMARK_CAPTURE(BM_positionFromSentenceData, synthetic, InputSet::synthetic);
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+// Splitting the whole input set into lines, as readSentences() does, or into tokens with operator>> as it used to.
+void BM_splitLines(benchmark::State & state, InputSet set, bool lineReader)
+{
+    const std::string & log = text(set);
+    for (auto _ : state)
+    {
+        std::istringstream stream(log);
+        std::size_t bytes = 0;
+        if (lineReader)
+        {
+            LineReader reader(stream);
+            std::string_view line;
+            while (reader.nextLine(line)) bytes += line.size();
+        }
+        else
+        {
+            std::string token;
+            while (stream >> token) bytes += token.size();
+        }
+        benchmark::DoNotOptimize(bytes);
+    }
+    state.SetBytesProcessed(state.iterations() * log.size());
+    state.SetItemsProcessed(state.iterations() * lines(set).size());
+}
+BENCHMARK_CAPTURE(BM_splitLines, lineReader/realLogs, InputSet::realLogs, true)->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(BM_splitLines, lineReader/synthetic, InputSet::synthetic, true)->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(BM_splitLines, tokens/realLogs, InputSet::realLogs, false)->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(BM_splitLines, tokens/synthetic, InputSet::synthetic, false)->Unit(benchmark::kMicrosecond);
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+// Reads the whole input set per iteration; reports the throughput in bytes and lines.
+void BM_readSentences(benchmark::State & state, InputSet set)
+{
+    const std::string & log = text(set);
+    const std::size_t before = heapAllocations();
+    for (auto _ : state)
+    {
+        std::istringstream stream(log);
+        benchmark::DoNotOptimize(readSentences(stream));
+    }
+    state.SetBytesProcessed(state.iterations() * log.size());
+    state.SetItemsProcessed(state.iterations() * lines(set).size());
+    reportHeapAllocations(state, before);
+}
+BENCHMARK_CAPTURE(BM_readSentences, realLogs, InputSet::realLogs)->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BM_readSentences, synthetic, InputSet::synthetic)->Unit(benchmark::kMillisecond);
+
+// As above, visiting each Position lazily through positions() instead of collecting them.
+void BM_positions(benchmark::State & state, InputSet set)
+{
+    const std::string & log = text(set);
+    const std::size_t before = heapAllocations();
+    for (auto _ : state)
+    {
+        std::istringstream stream(log);
+        double latitudes = 0;
+        for (const Position & position : positions(stream)) latitudes += position.latitude();
+        benchmark::DoNotOptimize(latitudes);
+    }
+    state.SetBytesProcessed(state.iterations() * log.size());
+    state.SetItemsProcessed(state.iterations() * lines(set).size());
+    reportHeapAllocations(state, before);
+}
+BENCHMARK_CAPTURE(BM_positions, realLogs, InputSet::realLogs)->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BM_positions, synthetic, InputSet::synthetic)->Unit(benchmark::kMillisecond);
+
+// As above, with the Positions in a monotonic arena that is released between batches.
+void BM_readSentencesIntoArena(benchmark::State & state, InputSet set)
+{
+    const std::string & log = text(set);
+    std::pmr::monotonic_buffer_resource arena;
+    const std::size_t before = heapAllocations();
+    for (auto _ : state)
+    {
+        {
+            std::istringstream stream(log);
+            const std::pmr::vector<Position> positions = readSentences(stream, &arena);
+            benchmark::DoNotOptimize(positions.data());
+        }
+        arena.release();
+    }
+    state.SetBytesProcessed(state.iterations() * log.size());
+    state.SetItemsProcessed(state.iterations() * lines(set).size());
+    reportHeapAllocations(state, before);
+}
+BENCHMARK_CAPTURE(BM_readSentencesIntoArena, realLogs, InputSet::realLogs)->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BM_readSentencesIntoArena, synthetic, InputSet::synthetic)->Unit(benchmark::kMillisecond);
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+// The input set as a serial capture that dropped every line break.
+std::string gluedCapture(InputSet set)
+{
+    std::string capture;
+    for (const std::string & line : lines(set)) capture += line;
+    return capture;
+}
+
+// Finding the candidate sentences only, without parsing them.
+void BM_SentenceScanner(benchmark::State & state, InputSet set)
+{
+    const std::string capture = gluedCapture(set);
+    for (auto _ : state)
+    {
+        SentenceScanner scanner(capture);
+        std::string_view sentence;
+        std::size_t count = 0;
+        while (scanner.nextSentence(sentence)) ++count;
+        benchmark::DoNotOptimize(count);
+    }
+    state.SetBytesProcessed(state.iterations() * capture.size());
+}
+BENCHMARK_CAPTURE(BM_SentenceScanner, realLogs, InputSet::realLogs)->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(BM_SentenceScanner, synthetic, InputSet::synthetic)->Unit(benchmark::kMicrosecond);
+
+// Recovering the Positions from the glued capture (readSentences() finds none of them).
+void BM_scanSentences(benchmark::State & state, InputSet set)
+{
+    const std::string capture = gluedCapture(set);
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(scanSentences(capture).data());
+    }
+    state.SetBytesProcessed(state.iterations() * capture.size());
+    state.SetItemsProcessed(state.iterations() * lines(set).size());
+}
+BENCHMARK_CAPTURE(BM_scanSentences, realLogs, InputSet::realLogs)->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BM_scanSentences, synthetic, InputSet::synthetic)->Unit(benchmark::kMillisecond);
+
+// Locating the structural characters of the whole input set, 64 bytes at a time or one at a time.
+void BM_structuralIndex(benchmark::State & state, InputSet set, bool scalar)
+{
+    const std::string & log = text(set);
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize((scalar ? structuralIndexScalar(log) : structuralIndex(log)).data());
+    }
+    state.SetBytesProcessed(state.iterations() * log.size());
+}
+BENCHMARK_CAPTURE(BM_structuralIndex, vector/realLogs, InputSet::realLogs, false)->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(BM_structuralIndex, vector/synthetic, InputSet::synthetic, false)->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(BM_structuralIndex, scalar/realLogs, InputSet::realLogs, true)->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(BM_structuralIndex, scalar/synthetic, InputSet::synthetic, true)->Unit(benchmark::kMicrosecond);
+
+// The same Positions as BM_readSentences, from the whole input set in memory.
+void BM_readSentencesIndexed(benchmark::State & state, InputSet set)
+{
+    const std::string & log = text(set);
+    const std::size_t before = heapAllocations();
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(readSentencesIndexed(log).data());
+    }
+    state.SetBytesProcessed(state.iterations() * log.size());
+    state.SetItemsProcessed(state.iterations() * lines(set).size());
+    reportHeapAllocations(state, before);
+}
+BENCHMARK_CAPTURE(BM_readSentencesIndexed, realLogs, InputSet::realLogs)->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BM_readSentencesIndexed, synthetic, InputSet::synthetic)->Unit(benchmark::kMillisecond);
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+/* Reads the whole input set from a file per iteration, with the specified number of
+ * threads, into TrackStatistics rather than a vector of Positions.
+ */
+void BM_readTrackStatisticsFromFile(benchmark::State & state, InputSet set)
+{
+    const std::string & log = text(set);
+    const std::string filepath = (std::filesystem::temp_directory_path() / "nmea-benchmarks-track.log").string();
+    std::ofstream(filepath, std::ios::binary) << log;
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(readTrackStatisticsFromFile(filepath, state.range(0), 64 * 1024).fixCount());
+    }
+    std::filesystem::remove(filepath);
+    state.SetBytesProcessed(state.iterations() * log.size());
+    state.SetItemsProcessed(state.iterations() * lines(set).size());
+}
+BENCHMARK_CAPTURE(BM_readTrackStatisticsFromFile, realLogs, InputSet::realLogs)->Arg(1)->Arg(4)->UseRealTime()->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BM_readTrackStatisticsFromFile, synthetic, InputSet::synthetic)->Arg(1)->Arg(4)->UseRealTime()->Unit(benchmark::kMillisecond);
+
+/////////////////////////////////////////////////////////////////////////////////////////
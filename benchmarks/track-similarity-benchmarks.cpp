@@ -0,0 +1,119 @@
+#include <benchmark/benchmark.h>
+
+#include "earth.h"
+#include "track-similarity.h"
+#include "benchmark-inputs.h"
+
+using namespace GPS;
+using namespace GPS::Benchmarks;
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+const std::size_t routeCount = 32;
+
+// The input track split into known routes.
+std::vector<Track> knownRoutes(InputSet set)
+{
+    const std::vector<Position> & track = positions(set);
+    std::vector<Track> routes(routeCount);
+    for (std::size_t i = 0; i < track.size(); ++i)
+    {
+        Track & route = routes[i * routeCount / track.size()];
+        route.append(track[i], double(route.size()));
+    }
+    return routes;
+}
+
+// A drive along one of the routes, 20m to the North of it, logging every other fix.
+Track drive(const std::vector<Track> & routes)
+{
+    const Track & route = routes[routeCount / 3];
+    std::vector<Position> fixes;
+    for (std::size_t i = 0; i < route.size(); i += 2) fixes.push_back(route.position(i));
+    Track track;
+    for (const Position & p : Earth::offsetPositions(fixes, 20, 0)) track.append(p, double(track.size()));
+    return track;
+}
+
+// A warping window of a tenth of the length of a route.
+std::size_t window(const std::vector<Track> & routes)
+{
+    return routes.front().size() / 10;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+// The Fréchet distance from the drive to each route in turn.
+void BM_frechetDistance(benchmark::State & state, InputSet set)
+{
+    const std::vector<Track> routes = knownRoutes(set);
+    const Track track = drive(routes);
+    cycleThrough(state, routes, [&track](const Track & route) { return frechetDistance(track, route); });
+}
+BENCHMARK_CAPTURE(BM_frechetDistance, realLogs, InputSet::realLogs)->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(BM_frechetDistance, synthetic, InputSet::synthetic)->Unit(benchmark::kMicrosecond);
+
+// The DTW distance from the drive to each route in turn, with a warping window.
+void BM_dtwDistance(benchmark::State & state, InputSet set)
+{
+    const std::vector<Track> routes = knownRoutes(set);
+    const Track track = drive(routes);
+    const std::size_t w = window(routes);
+    cycleThrough(state, routes, [&track, w](const Track & route) { return dtwDistance(track, route, w); });
+}
+BENCHMARK_CAPTURE(BM_dtwDistance, realLogs, InputSet::realLogs)->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(BM_dtwDistance, synthetic, InputSet::synthetic)->Unit(benchmark::kMicrosecond);
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+// The nearest 3 routes to the drive, by the Fréchet distance or by DTW.
+void BM_nearestRoutes(benchmark::State & state, InputSet set, RouteSearchOptions::Measure measure)
+{
+    const std::vector<Track> routes = knownRoutes(set);
+    const Track track = drive(routes);
+
+    RouteSearchOptions options;
+    options.measure = measure;
+    options.window = window(routes);
+    options.count = 3;
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(nearestRoutes(track, routes, options).data());
+    }
+    state.SetItemsProcessed(state.iterations() * routes.size());
+}
+BENCHMARK_CAPTURE(BM_nearestRoutes, frechet/realLogs, InputSet::realLogs, RouteSearchOptions::Measure::frechet)
+    ->Unit(benchmark::kMillisecond)->UseRealTime();
+BENCHMARK_CAPTURE(BM_nearestRoutes, frechet/synthetic, InputSet::synthetic, RouteSearchOptions::Measure::frechet)
+    ->Unit(benchmark::kMillisecond)->UseRealTime();
+BENCHMARK_CAPTURE(BM_nearestRoutes, dtw/realLogs, InputSet::realLogs, RouteSearchOptions::Measure::dtw)
+    ->Unit(benchmark::kMillisecond)->UseRealTime();
+BENCHMARK_CAPTURE(BM_nearestRoutes, dtw/synthetic, InputSet::synthetic, RouteSearchOptions::Measure::dtw)
+    ->Unit(benchmark::kMillisecond)->UseRealTime();
+
+// The same distances, computed in full for every route, without lower bounds or abandoning.
+void BM_nearestRoutesByFullComparison(benchmark::State & state, InputSet set, RouteSearchOptions::Measure measure)
+{
+    const std::vector<Track> routes = knownRoutes(set);
+    const Track track = drive(routes);
+    const std::size_t w = window(routes);
+    for (auto _ : state)
+    {
+        for (const Track & route : routes)
+        {
+            benchmark::DoNotOptimize(measure == RouteSearchOptions::Measure::frechet ? frechetDistance(track, route)
+                                                                                     : dtwDistance(track, route, w));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * routes.size());
+}
+BENCHMARK_CAPTURE(BM_nearestRoutesByFullComparison, frechet/realLogs, InputSet::realLogs, RouteSearchOptions::Measure::frechet)
+    ->Unit(benchmark::kMillisecond)->UseRealTime();
+BENCHMARK_CAPTURE(BM_nearestRoutesByFullComparison, frechet/synthetic, InputSet::synthetic, RouteSearchOptions::Measure::frechet)
+    ->Unit(benchmark::kMillisecond)->UseRealTime();
+BENCHMARK_CAPTURE(BM_nearestRoutesByFullComparison, dtw/realLogs, InputSet::realLogs, RouteSearchOptions::Measure::dtw)
+    ->Unit(benchmark::kMillisecond)->UseRealTime();
+BENCHMARK_CAPTURE(BM_nearestRoutesByFullComparison, dtw/synthetic, InputSet::synthetic, RouteSearchOptions::Measure::dtw)
+    ->Unit(benchmark::kMillisecond)->UseRealTime();
+
+/////////////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,88 @@
+# The GPS library: shared by the test program and the command-line tools.
+
+CONFIG += c++17 thread
+
+QMAKE_CXXFLAGS += -std=c++17 -Wall -Wfatal-errors
+
+HEADERS += \
+    $$PWD/headers/bounded-queue.h \
+    $$PWD/headers/clustering.h \
+    $$PWD/headers/dataFiles.h \
+    $$PWD/headers/distance-matrix.h \
+    $$PWD/headers/earth.h \
+    $$PWD/headers/fix-filter.h \
+    $$PWD/headers/geofence.h \
+    $$PWD/headers/geometry.h \
+    $$PWD/headers/landmarks.h \
+    $$PWD/headers/latency-histogram.h \
+    $$PWD/headers/position.h \
+    $$PWD/headers/spsc-queue.h \
+    $$PWD/headers/stay-points.h \
+    $$PWD/headers/thread-pool.h \
+    $$PWD/headers/track.h \
+    $$PWD/headers/track-similarity.h \
+    $$PWD/headers/track-statistics.h \
+    $$PWD/headers/types.h \
+    $$PWD/headers/unit-vectors.h \
+    $$PWD/headers/nmea/compressed-input.h \
+    $$PWD/headers/nmea/epoll-reader.h \
+    $$PWD/headers/nmea/fleet-ingestor.h \
+    $$PWD/headers/nmea/generator.h \
+    $$PWD/headers/nmea/instrumentation.h \
+    $$PWD/headers/nmea/line-reader.h \
+    $$PWD/headers/nmea/nmea-batch.h \
+    $$PWD/headers/nmea/nmea-parser.h \
+    $$PWD/headers/nmea/pipeline.h \
+    $$PWD/headers/nmea/position-range.h \
+    $$PWD/headers/nmea/replay.h \
+    $$PWD/headers/nmea/sentence-scanner.h \
+    $$PWD/headers/nmea/structural-index.h \
+    $$PWD/headers/nmea/track-reader.h \
+    $$PWD/headers/nmea/track-statistics-reader.h
+
+SOURCES += \
+    $$PWD/src/clustering.cpp \
+    $$PWD/src/dataFiles.cpp \
+    $$PWD/src/distance-matrix.cpp \
+    $$PWD/src/earth.cpp \
+    $$PWD/src/fix-filter.cpp \
+    $$PWD/src/geofence.cpp \
+    $$PWD/src/landmarks.cpp \
+    $$PWD/src/latency-histogram.cpp \
+    $$PWD/src/position.cpp \
+    $$PWD/src/stay-points.cpp \
+    $$PWD/src/thread-pool.cpp \
+    $$PWD/src/track.cpp \
+    $$PWD/src/track-similarity.cpp \
+    $$PWD/src/track-statistics.cpp \
+    $$PWD/src/nmea/compressed-input.cpp \
+    $$PWD/src/nmea/epoll-reader.cpp \
+    $$PWD/src/nmea/fleet-ingestor.cpp \
+    $$PWD/src/nmea/generator.cpp \
+    $$PWD/src/nmea/instrumentation.cpp \
+    $$PWD/src/nmea/line-reader.cpp \
+    $$PWD/src/nmea/nmea-batch.cpp \
+    $$PWD/src/nmea/nmea-parser.cpp \
+    $$PWD/src/nmea/pipeline.cpp \
+    $$PWD/src/nmea/position-range.cpp \
+    $$PWD/src/nmea/replay.cpp \
+    $$PWD/src/nmea/sentence-scanner.cpp \
+    $$PWD/src/nmea/structural-index.cpp \
+    $$PWD/src/nmea/track-reader.cpp \
+    $$PWD/src/nmea/track-statistics-reader.cpp
+
+INCLUDEPATH += $$PWD/headers/ $$PWD/headers/nmea/
+
+LIBS += -lz
+
+# Zstandard input is supported wherever pkg-config can find libzstd.
+packagesExist(libzstd) {
+    CONFIG += link_pkgconfig
+    PKGCONFIG += libzstd
+    DEFINES += GPS_HAVE_ZSTD
+}
+
+# Build with "qmake CONFIG+=nmea_instrument" to time the stages of sentence parsing.
+CONFIG(nmea_instrument) {
+    DEFINES += GPS_NMEA_INSTRUMENT
+}
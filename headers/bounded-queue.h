@@ -0,0 +1,72 @@
+#ifndef GPS_BOUNDED_QUEUE_H
+#define GPS_BOUNDED_QUEUE_H
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <mutex>
+#include <utility>
+
+namespace GPS
+{
+  /* A blocking first-in first-out queue with a fixed capacity, for handing work from
+   * producer threads to consumer threads.  Producers block while the queue is full, so
+   * a fast producer cannot run arbitrarily far ahead of a slow consumer.
+   *
+   * Either side may close() the queue: blocked and future push() calls then fail, and
+   * pop() fails once the remaining items have been drained.
+   */
+  template <typename T>
+  class BoundedQueue
+  {
+    public:
+
+      explicit BoundedQueue(std::size_t capacity) : capacity(capacity > 0 ? capacity : 1) {}
+
+      // Returns false (and discards the item) if the queue has been closed.
+      bool push(T item)
+      {
+          std::unique_lock<std::mutex> lock(mutex);
+          notFull.wait(lock, [this]{ return items.size() < capacity || closed; });
+          if (closed) return false;
+          items.push_back(std::move(item));
+          lock.unlock();
+          notEmpty.notify_one();
+          return true;
+      }
+
+      // Returns false if the queue is closed and empty.
+      bool pop(T & item)
+      {
+          std::unique_lock<std::mutex> lock(mutex);
+          notEmpty.wait(lock, [this]{ return ! items.empty() || closed; });
+          if (items.empty()) return false;
+          item = std::move(items.front());
+          items.pop_front();
+          lock.unlock();
+          notFull.notify_one();
+          return true;
+      }
+
+      void close()
+      {
+          {
+              std::lock_guard<std::mutex> lock(mutex);
+              closed = true;
+          }
+          notFull.notify_all();
+          notEmpty.notify_all();
+      }
+
+    private:
+
+      const std::size_t capacity;
+      std::deque<T> items;
+      bool closed = false;
+      std::mutex mutex;
+      std::condition_variable notFull;
+      std::condition_variable notEmpty;
+  };
+}
+
+#endif
@@ -0,0 +1,54 @@
+#ifndef GPS_CLUSTERING_H
+#define GPS_CLUSTERING_H
+
+#include <cstddef>
+#include <limits>
+#include <vector>
+
+#include "position.h"
+#include "types.h"
+
+namespace GPS
+{
+  struct Clusters
+  {
+      // The label of Positions that are not in any cluster.
+      static constexpr std::size_t noise = std::numeric_limits<std::size_t>::max();
+
+      /* The cluster of each Position, in order: from 0 to count-1, or 'noise'.
+       * Clusters are numbered in order of their first core Position.
+       */
+      std::vector<std::size_t> labels;
+
+      std::size_t count = 0;
+  };
+
+
+  /* Groups Positions into clusters of nearby Positions, using DBSCAN: a Position with at
+   * least 'minPoints' Positions (including itself) within 'radius' is a core Position,
+   * core Positions within 'radius' of each other are in the same cluster, and other
+   * Positions within 'radius' of a core Position join its cluster (the cluster of the
+   * earliest such core Position, if there are several).  The remaining Positions are noise.
+   * Distances are Position::horizontalDistanceBetween().
+   *
+   * For example, clustering the centres of the stay points from many logs finds the places
+   * where vehicles stop repeatedly.
+   *
+   * The Positions are indexed in a grid of cells half the radius across, so only the
+   * Positions in nearby cells are compared, instead of every pair of Positions.  As all the
+   * Positions in a cell are within the radius of each other, a cell with at least
+   * 'minPoints' Positions is all core Positions, and nearby cells' core Positions are in
+   * the same cluster if any one pair of them are within the radius, so dense clusters of
+   * millions of Positions are found without comparing most of them.  The work is shared
+   * between 'threadCount' threads (zero uses the number of hardware threads), with core
+   * Positions merged by a lock-free union-find.  The results do not depend on the number
+   * of threads.
+   *
+   * Throws a std::invalid_argument exception if the radius is not positive or is more than
+   * a quarter of the Earth's circumference, or 'minPoints' is zero.
+   */
+  Clusters clusterPositions(const std::vector<Position> &, metres radius, std::size_t minPoints,
+                            unsigned int threadCount = 0);
+}
+
+#endif
@@ -11,6 +11,7 @@ namespace GPS
       extern const std::string NMEADir;
       extern const std::string GPXRoutesDir;
       extern const std::string GPXTracksDir;
+      extern const std::string LandmarksDir;
   }
 }
 
@@ -0,0 +1,56 @@
+#ifndef GPS_DISTANCE_MATRIX_H
+#define GPS_DISTANCE_MATRIX_H
+
+#include <cstddef>
+#include <vector>
+
+#include "track.h"
+#include "types.h"
+
+namespace GPS
+{
+  /* These functions compute the distances between the fixes of different Tracks in tiles of
+   * a few hundred fixes by a few hundred fixes, so that each tile's coordinates stay in the
+   * cache, with the tiles shared between 'threadCount' threads (zero uses the number of
+   * hardware threads).
+   *
+   * The fixes are converted to 3D unit vectors (stored as separate x, y and z columns), so
+   * the inner loops are vectorisable straight-line (chord) distances, which are only
+   * converted to metres when they are needed.  The distances are the same as
+   * Position::horizontalDistanceBetween(), apart from rounding.
+   */
+
+
+  /* The distance between every fix of 'a' and every fix of 'b', in row-major order: the
+   * distance between fix 'i' of 'a' and fix 'j' of 'b' is element [i * b.size() + j].
+   */
+  std::vector<metres> distanceMatrix(const Track & a, const Track & b, unsigned int threadCount = 0);
+
+
+  struct ClosePair
+  {
+      std::size_t firstTrack;
+      std::size_t firstFix;
+      std::size_t secondTrack;
+      std::size_t secondFix;
+      metres distance;
+  };
+
+
+  /* The pairs of fixes from different Tracks that are within 'threshold' of each other, in
+   * order of first Track, second Track (with firstTrack < secondTrack), first fix and second
+   * fix.
+   *
+   * A bounding box is kept for each tile (and each Track), and tiles whose boxes are
+   * further apart than the threshold are skipped without computing any distances, so
+   * Tracks that are mostly far apart are compared in little more than linear time.
+   *
+   * Throws a std::invalid_argument exception if the threshold is negative.
+   */
+  std::vector<ClosePair> closePairs(const std::vector<Track> &, metres threshold, unsigned int threadCount = 0);
+
+  // As above, for two Tracks, numbered 0 and 1.
+  std::vector<ClosePair> closePairs(const Track & a, const Track & b, metres threshold, unsigned int threadCount = 0);
+}
+
+#endif
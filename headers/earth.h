@@ -1,22 +1,25 @@
 #ifndef GPS_EARTH_H
 #define GPS_EARTH_H
 
+#include <vector>
+
+#include "geometry.h"
 #include "position.h"
 
 namespace GPS
 {
   namespace Earth
   {
-      extern const Position NorthPole;
-      extern const Position EquatorialMeridian;
-      extern const Position EquatorialAntiMeridian;
-      extern const Position CliftonCampus;
-      extern const Position CityCampus;
-      extern const Position Pontianak;
+      inline constexpr Position NorthPole = Position(poleLatitude,0,0);
+      inline constexpr Position EquatorialMeridian = Position(0,0,0);
+      inline constexpr Position EquatorialAntiMeridian = Position(0,antiMeridianLongitude,0);
+      inline constexpr Position CliftonCampus = Position(52.91249953,-1.18402513,58);
+      inline constexpr Position CityCampus = Position(52.9581383,-1.1542364,53);
+      inline constexpr Position Pontianak = Position(0,109.322134,0);
 
-      extern const metres meanRadius;
-      extern const metres equatorialCircumference;
-      extern const metres polarCircumference;
+      inline constexpr metres meanRadius = 6371008.8;
+      inline constexpr metres equatorialCircumference = 40075160;
+      inline constexpr metres polarCircumference = 40008000;
 
 
       /* Determine the east/west circumference of the Earth at a specified latitude.
@@ -43,6 +46,41 @@ namespace GPS
        * specified latitude.
        */
       degrees longitudeSubtendedBy(metres eastWestDistance, degrees lat);
+
+
+      /* The following batch functions give the same results as calling the functions above
+       * for each Position (with longitude changes accurate to a few parts per billion), but
+       * look the cosines of the latitudes up in a precomputed table (with linear
+       * interpolation) instead of calling cos() for each Position, so they are much faster
+       * for large numbers of Positions.
+       */
+
+      /* Determine the box around each Position that extends the specified distance (in
+       * metres) North, South, East and West of it, using latitudeSubtendedBy() and
+       * longitudeSubtendedBy() at the Position's latitude.
+       * Boxes are clipped at the poles, and cover every longitude if they reach a pole or
+       * are wider than the Earth's circumference; otherwise, the longitudes are normalised
+       * to the (-180,180] range, so boxes crossing the anti-meridian have minLongitude
+       * greater than maxLongitude.
+       *
+       * Pre-condition: The distance is not negative, and no greater than the Earth's
+       * polar circumference.
+       */
+      std::vector<BoundingBox> boundingBoxes(const std::vector<Position> &, metres distance);
+
+
+      /* Determine the Positions reached by moving each Position the specified distances
+       * North (negative for South) and East (negative for West), using
+       * latitudeSubtendedBy() and longitudeSubtendedBy() at the starting latitude.
+       * Longitudes are normalised to the (-180,180] range, and elevations are unchanged.
+       *
+       * Throws a std::invalid_argument exception if a Position would be moved beyond a pole.
+       *
+       * Pre-condition: The North/South distance is no greater than the Earth's polar
+       * circumference, and the East/West distance is no greater than the Earth's
+       * circumference at the latitude of any of the Positions.
+       */
+      std::vector<Position> offsetPositions(const std::vector<Position> &, metres northDistance, metres eastDistance);
   }
 }
 
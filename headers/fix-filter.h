@@ -0,0 +1,108 @@
+#ifndef GPS_FIX_FILTER_H
+#define GPS_FIX_FILTER_H
+
+#include <cstdint>
+#include <optional>
+
+#include "position.h"
+#include "track.h"
+#include "types.h"
+
+namespace GPS
+{
+  struct FilterOptions
+  {
+      /* A fix is rejected as an outlier if reaching it from the last accepted fix would take
+       * more than 'maxSpeed' (metres per second), allowing an extra 'gateTolerance' metres
+       * for receiver noise (which also covers fixes with the same time).
+       */
+      speed maxSpeed = 70;
+      metres gateTolerance = 50;
+
+      /* After this many consecutive rejections, the receiver is taken to have genuinely moved
+       * (e.g. after a gap in reception), and the filter restarts from the next fix.
+       */
+      unsigned int maxConsecutiveRejections = 10;
+
+      // The standard deviation of the receiver's horizontal position errors.
+      metres measurementNoise = 10;
+
+      // The standard deviation of the unmodelled acceleration, in metres per second squared.
+      double accelerationNoise = 2;
+  };
+
+
+  /* Cleans up the fixes from one receiver as they arrive, in constant time and memory per
+   * fix: a speed gate rejects outliers (e.g. multi-kilometre jumps), and a constant-velocity
+   * Kalman filter smooths the horizontal positions of the remaining fixes.
+   *
+   * The filter works in a local east/north plane, re-centred on the latest estimate at
+   * every fix, so it is accurate anywhere on Earth, including across the anti-meridian.
+   * Elevations are passed through unfiltered.
+   *
+   * Use one FixFilter per stream of fixes.  Not thread-safe.
+   */
+  class FixFilter
+  {
+    public:
+
+      /* Throws a std::invalid_argument exception if any of the speed, noise or tolerance
+       * options is not positive.
+       */
+      explicit FixFilter(FilterOptions = {});
+
+      /* Returns the filtered Position, or no value if the fix is rejected.
+       * Fixes earlier than the last accepted fix are always rejected.
+       */
+      std::optional<Position> add(const Position &, double time);
+
+      /* Filters a batch of fixes, giving the same results as adding them one by one, and
+       * returns the accepted fixes with their filtered Positions.
+       *
+       * The speed gate is first applied to the whole batch in a vectorisable loop over the
+       * latitude, longitude and time columns, using approximate (equirectangular) distances
+       * between consecutive fixes.  Only fixes whose approximate speed is over half the
+       * limit, or that follow a rejected fix, are then checked exactly.
+       */
+      Track add(const Track &);
+
+      std::uint64_t acceptedCount() const;
+      std::uint64_t rejectedCount() const;
+
+      // Forget the state of the filter (but not the counts), so the next fix starts afresh.
+      void reset();
+
+    private:
+
+      // The state and covariance of a constant-velocity model along one axis.
+      struct AxisState
+      {
+          double velocity = 0;
+          double positionVariance = 0;
+          double covariance = 0;
+          double velocityVariance = 0;
+      };
+
+      bool passesGate(const Position &, double time) const;
+      Position accept(const Position &, double time);
+
+      const FilterOptions options;
+
+      bool started = false;
+      unsigned int consecutiveRejections = 0;
+
+      // The last accepted fix, before filtering, for the speed gate.
+      Position lastFix = Position(0,0,0);
+      double lastTime = 0;
+
+      // The filtered estimate, and the model along the east and north axes.
+      Position estimate = Position(0,0,0);
+      AxisState east;
+      AxisState north;
+
+      std::uint64_t accepted = 0;
+      std::uint64_t rejected = 0;
+  };
+}
+
+#endif
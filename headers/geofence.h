@@ -0,0 +1,147 @@
+#ifndef GPS_GEOFENCE_H
+#define GPS_GEOFENCE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include "position.h"
+#include "types.h"
+
+namespace GPS
+{
+  // Zones are numbered from zero, in the order they are added.
+  using ZoneId = std::size_t;
+
+  // Whatever is being tracked, e.g. a vehicle.
+  using SubjectId = std::uint64_t;
+
+
+  struct Fix
+  {
+      SubjectId subject;
+      Position position;
+      double time;  // seconds, e.g. since midnight (see NMEA::timeOfDay())
+  };
+
+  struct GeofenceEvent
+  {
+      enum class Type
+      {
+          enter,  // the first fix inside the zone
+          exit,   // the first fix outside the zone, after being inside
+          dwell   // the first fix still inside the zone at least the dwell time after entering
+      };
+
+      Type type;
+      SubjectId subject;
+      ZoneId zone;
+      double time;  // of the fix that caused the event
+  };
+
+
+  /* Checks fixes against many circular and polygonal zones, and reports when each subject
+   * enters, exits or dwells in a zone.
+   *
+   * Zones are indexed in a grid of latitude/longitude cells: each cell lists the zones whose
+   * bounding boxes overlap it, so a fix is only tested against the zones near it, and the
+   * cost per fix depends on how many zones overlap its cell rather than on the total number
+   * of zones.  Zones too wide to index (spanning more than 'maxCellsPerZone' cells, e.g.
+   * around the poles) are tested against every fix.
+   *
+   * Circles use the same (haversine) distance as Position::horizontalDistanceBetween().
+   * Polygon edges are straight lines in latitude/longitude, which is accurate for zones up
+   * to a few tens of kilometres across, away from the poles; polygons must not straddle the
+   * anti-meridian.
+   *
+   * Not thread-safe.
+   */
+  class Geofence
+  {
+    public:
+
+      static const std::size_t maxCellsPerZone = 4096;
+
+      /* 'dwellTime' is how long (in seconds) a subject must stay in a zone for a dwell event; 'cellSize'
+       * is the size of the grid cells, which works best at about the size of a typical zone.
+       *
+       * Throws a std::invalid_argument exception if the dwell time is negative, or the cell
+       * size is not in the range (0,90].
+       */
+      explicit Geofence(double dwellTime = 60, degrees cellSize = 0.05);
+
+      /* Throws a std::invalid_argument exception if the radius is not positive, or exceeds
+       * a quarter of the Earth's polar circumference.
+       */
+      ZoneId addCircle(Position centre, metres radius);
+
+      /* The vertices are in order around the polygon; the last is joined to the first.
+       *
+       * Throws a std::invalid_argument exception for fewer than three vertices, or if an
+       * edge spans more than 180 degrees of longitude.
+       */
+      ZoneId addPolygon(const std::vector<Position> & vertices);
+
+      std::size_t zoneCount() const;
+
+      // The zones containing a Position, in ascending order.
+      std::vector<ZoneId> zonesContaining(Position) const;
+
+      /* Checks a batch of fixes, in order, and returns the events they cause in the same
+       * order.  Fixes for each subject must be in time order, within and across batches.
+       * A subject's first fix can only cause enter (and dwell, for a zero dwell time) events.
+       */
+      std::vector<GeofenceEvent> update(const std::vector<Fix> &);
+
+      // The zones a subject was in at its latest fix, in ascending order.
+      std::vector<ZoneId> zonesOf(SubjectId) const;
+
+      // Forget a subject's zones, without any exit events.
+      void forget(SubjectId);
+
+    private:
+
+      struct Zone
+      {
+          enum class Shape { circle, polygon };
+
+          Shape shape;
+          degrees minLat, maxLat;
+          degrees minLon, maxLon;  // for circles crossing the anti-meridian, minLon > maxLon
+
+          Position centre = Position(0,0,0);
+          metres radius = 0;
+          std::vector<std::pair<degrees,degrees>> vertices;  // (latitude, longitude)
+
+          bool contains(Position) const;
+      };
+
+      struct Visit
+      {
+          ZoneId zone;
+          double entered;
+          bool dwellReported;
+      };
+
+      using CellKey = std::uint64_t;
+
+      ZoneId addZone(Zone);
+      CellKey cellKey(degrees lat, degrees lon) const;
+      const std::vector<ZoneId> * cellZones(CellKey) const;
+      void findZones(Position, const std::vector<ZoneId> * candidates, std::vector<ZoneId> & found) const;
+
+      const double dwellTime;
+      const degrees cellSize;
+      const std::uint64_t latitudeCells;
+      const std::uint64_t longitudeCells;
+
+      std::vector<Zone> zones;
+      std::unordered_map<CellKey, std::vector<ZoneId>> grid;
+      std::vector<ZoneId> wideZones;
+
+      std::unordered_map<SubjectId, std::vector<Visit>> visits;  // sorted by zone
+  };
+}
+
+#endif
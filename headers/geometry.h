@@ -1,42 +1,87 @@
 #ifndef GPS_GEOMETRY_H
 #define GPS_GEOMETRY_H
 
+#include <cmath>
+
 #include "types.h"
 
 namespace GPS
 {
-  extern const unsigned int minutesPerDegree;
-  extern const unsigned int secondsPerMinute;
-  extern const unsigned int degreesInACircle;
-  extern const double pi;
-  extern const degrees fullRotation;
-  extern const degrees halfRotation;
-  extern const degrees poleLatitude;
-  extern const degrees antiMeridianLongitude;
+  inline constexpr unsigned int minutesPerDegree = 60;
+  inline constexpr unsigned int secondsPerMinute = 60;
+  inline constexpr unsigned int degreesInACircle = 360;
+  inline constexpr double pi = 3.141592653589793;
+  inline constexpr degrees fullRotation = degreesInACircle;
+  inline constexpr degrees halfRotation = fullRotation/2;
+  inline constexpr degrees poleLatitude = fullRotation/4;
+  inline constexpr degrees antiMeridianLongitude = fullRotation/2;
+
+  /* These functions are defined here, rather than in a source file, so that they can be
+   * inlined into the loops that call them, and evaluated at compile time where possible.
+   */
 
   // Compute hypotenuse of right-angled triangle in two dimensions.
-  double pythagoras(double,double);
+  inline double pythagoras(double x, double y)
+  {
+      return std::sqrt(x*x + y*y);
+  }
 
   // Compute hypotenuse of right-angled triangle in three dimensions.
-  double pythagoras(double,double,double);
+  inline double pythagoras(double x, double y, double z)
+  {
+      return std::sqrt(x*x + y*y + z*z);
+  }
 
   // Convert from degrees to radians.
-  radians degToRad(degrees);
+  constexpr radians degToRad(degrees d)
+  {
+      return d * pi / halfRotation;
+  }
 
   // Convert from radians to degrees.
-  radians radToDeg(degrees);
+  constexpr degrees radToDeg(radians r)
+  {
+      return r * halfRotation / pi;
+  }
 
   // Sine squared function: sin^2(x)
-  double sinSqr(radians);
+  inline double sinSqr(radians x)
+  {
+      const double sx = std::sin(x);
+      return sx * sx;
+  }
 
   // Check if the angle is within the [-90,90] range.
-  bool isValidLatitude(degrees);
+  constexpr bool isValidLatitude(degrees lat)
+  {
+      return lat >= -poleLatitude && lat <= poleLatitude;
+  }
 
   // Check if the angle is within the [-180,180] range.
-  bool isValidLongitude(degrees);
+  constexpr bool isValidLongitude(degrees lon)
+  {
+      return lon >= -antiMeridianLongitude && lon <= antiMeridianLongitude;
+  }
 
   // Convert larger/smaller degrees into the (-180,180] range.
-  degrees normaliseDegrees(degrees);
+  inline degrees normaliseDegrees(degrees d)
+  {
+      d = std::fmod(d,fullRotation); // results in range (-360,360)
+      if (d <= -halfRotation) d += fullRotation; // results in range (-180,360)
+      if (d > halfRotation) d -= fullRotation; // results in range (-180,180]
+      return d;
+  }
+
+  /* A range of latitudes and longitudes.  For boxes that cross the anti-meridian,
+   * minLongitude is greater than maxLongitude.
+   */
+  struct BoundingBox
+  {
+      degrees minLatitude;
+      degrees maxLatitude;
+      degrees minLongitude;
+      degrees maxLongitude;
+  };
 }
 
 #endif
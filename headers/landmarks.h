@@ -0,0 +1,101 @@
+#ifndef GPS_LANDMARKS_H
+#define GPS_LANDMARKS_H
+
+#include <array>
+#include <cstddef>
+#include <istream>
+#include <string>
+#include <vector>
+
+#include "position.h"
+
+namespace GPS
+{
+  struct Landmark
+  {
+      std::string name;
+      Position position;
+  };
+
+
+  /* Read landmarks from text with one landmark per line, in the form:
+   *   name,latitude,longitude[,elevation]
+   * with the angles in decimal degrees (negative for South/West) and the elevation in
+   * metres (zero if omitted).  Blank lines and lines starting with '#' are ignored, and
+   * whitespace around each field is trimmed.
+   *
+   * Throws a std::domain_error exception, giving the line number, for ill-formed lines.
+   */
+  std::vector<Landmark> readLandmarks(std::istream &);
+
+  /* As above, reading from a file.
+   * Throws a std::invalid_argument exception if the file cannot be opened.
+   */
+  std::vector<Landmark> readLandmarks(const std::string & filepath);
+
+
+  /* Finds the nearest landmarks to a Position, without computing the distance to every one.
+   *
+   * The landmarks are stored as 3D unit vectors (points on a unit sphere) in a balanced k-d
+   * tree.  The straight-line (chord) distance between unit vectors increases with the
+   * distance over the surface, so the tree is searched with cheap squared chord distances,
+   * and only the distances of the matches are converted to metres.  The distances are the
+   * same as Position::horizontalDistanceBetween() (ignoring elevation).
+   *
+   * Searching is O(log N) for N landmarks (for well spread landmarks), instead of N
+   * haversine distances.  Safe to search from many threads at once.
+   */
+  class LandmarkIndex
+  {
+    public:
+
+      struct Match
+      {
+          std::size_t landmark;  // the index in landmarks()
+          metres distance;
+      };
+
+      explicit LandmarkIndex(std::vector<Landmark>);
+
+      const std::vector<Landmark> & landmarks() const;
+
+      /* The nearest landmark.  When several are equally near, any of them may be returned.
+       * Throws a std::domain_error exception if there are no landmarks.
+       */
+      Match nearest(Position) const;
+
+      // The 'k' nearest landmarks (or all of them, if fewer), nearest first.
+      std::vector<Match> nearest(Position, std::size_t k) const;
+
+      // The nearest landmark to each Position, in order.
+      std::vector<Match> nearestToEach(const std::vector<Position> &) const;
+
+    private:
+
+      struct Point
+      {
+          std::array<double,3> coordinates;
+          std::size_t landmark;
+      };
+
+      struct Candidates;
+
+      static Point unitVector(Position, std::size_t landmark);
+      void build(std::size_t begin, std::size_t end);
+      void search(const Point & query, Candidates &) const;
+      void search(std::size_t begin, std::size_t end, const Point & query, Candidates &,
+                  std::array<double,3> & offsets, double regionDistance) const;
+      std::vector<Match> matches(Candidates &) const;
+
+      std::vector<Landmark> stored;
+
+      /* The tree is implicit: the node for the range [begin,end) of 'points' is the middle
+       * element, which splits the range on the axis in 'splitAxes', so that the points before
+       * it are on one side of the split and the points after it are on the other.
+       */
+      std::vector<Point> points;
+      std::vector<unsigned char> splitAxes;
+  };
+}
+
+#endif
@@ -0,0 +1,58 @@
+#ifndef GPS_LATENCY_HISTOGRAM_H
+#define GPS_LATENCY_HISTOGRAM_H
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+
+namespace GPS
+{
+  /* A fixed-size histogram of durations, for latency measurements.
+   *
+   * Durations are counted in buckets whose width grows with the duration: every power-of-two
+   * range of nanoseconds is split into 16 equal buckets, so reported percentiles are within
+   * about 6% of the true value, from nanoseconds up to years.  Recording is a few integer
+   * operations and never allocates.  Negative durations are recorded as zero.
+   *
+   * Not thread-safe: use one histogram per thread, and merge them afterwards.
+   */
+  class LatencyHistogram
+  {
+    public:
+
+      void record(std::chrono::nanoseconds);
+
+      // Add all the durations recorded by another histogram.
+      void merge(const LatencyHistogram &);
+
+      std::uint64_t count() const;
+
+      // The following all return zero for an empty histogram.
+      std::chrono::nanoseconds min() const;
+      std::chrono::nanoseconds max() const;
+      std::chrono::nanoseconds mean() const;
+
+      /* The duration below which the specified percentage (0 to 100) of durations fall,
+       * rounded up to the end of its bucket (but never above max()).
+       * Throws a std::domain_error exception for percentages outside [0,100].
+       */
+      std::chrono::nanoseconds percentile(double percentage) const;
+
+    private:
+
+      static const unsigned int subBucketBits = 4;
+      static const unsigned int subBucketCount = 1u << subBucketBits;
+      static const unsigned int bucketCount = (64 - subBucketBits + 1) * subBucketCount;
+
+      static unsigned int bucketIndex(std::uint64_t nanoseconds);
+      static std::uint64_t bucketUpperBound(unsigned int index);
+
+      std::array<std::uint64_t, bucketCount> buckets = {};
+      std::uint64_t total = 0;
+      std::uint64_t minimum = UINT64_MAX;
+      std::uint64_t maximum = 0;
+      long double sum = 0;
+  };
+}
+
+#endif
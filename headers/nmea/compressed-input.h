@@ -0,0 +1,86 @@
+#ifndef GPS_NMEA_COMPRESSED_INPUT_H
+#define GPS_NMEA_COMPRESSED_INPUT_H
+
+#include <exception>
+#include <istream>
+#include <streambuf>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "bounded-queue.h"
+#include "position.h"
+
+namespace GPS::NMEA
+{
+  enum class Compression { none, gzip, zstd };
+
+
+  /* Determine the compression format of a file from its leading "magic" bytes.
+   * Zstandard files are only recognised if the library was built with GPS_HAVE_ZSTD.
+   *
+   * Throws a std::invalid_argument exception if the file cannot be opened.
+   */
+  Compression detectCompression(std::string filepath);
+
+  /* Determine the compression format of a stream from its leading "magic" bytes, which
+   * are put back so that the stream is then read from where it was.
+   *
+   * Throws a std::runtime_error exception if the stream buffer cannot put the bytes back.
+   */
+  Compression detectCompression(std::istream &);
+
+
+  /* A stream buffer that decompresses another stream on a background thread.
+   *
+   * Decompressed data is passed to the reading thread in fixed-size chunks through a
+   * bounded queue, so decompression of the next chunks overlaps with parsing of the
+   * current one, while memory use stays bounded however large the input is.
+   */
+  class DecompressingStreamBuf : public std::streambuf
+  {
+    public:
+
+      /* Pre-condition: the source stream outlives this stream buffer.
+       * Throws a std::invalid_argument exception if the compression format is not
+       * supported by this build.
+       */
+      DecompressingStreamBuf(std::istream & source, Compression);
+
+      // Stops and joins the decompression thread, even if the input was not fully read.
+      ~DecompressingStreamBuf() override;
+
+      /* After the decompressed data has been consumed: rethrows any error that ended
+       * decompression early (e.g. corrupt or truncated input) as a std::runtime_error.
+       */
+      void checkForErrors() const;
+
+    protected:
+
+      int_type underflow() override;
+
+    private:
+
+      void decompressGzip();
+      void decompressZstd();
+      void decompress();
+
+      std::istream & source;
+      const Compression compression;
+      BoundedQueue<std::string> chunks;
+      std::string currentChunk;
+      std::exception_ptr error;
+      std::thread worker;
+  };
+
+
+  /* Reads a NMEA log file with readSentences(), transparently decompressing gzip
+   * (and, if available, zstd) files without writing any temporary files.
+   *
+   * Throws a std::invalid_argument exception if the file cannot be opened, and a
+   * std::runtime_error exception if a compressed file is corrupt.
+   */
+  std::vector<Position> readSentencesFromFile(std::string filepath);
+}
+
+#endif
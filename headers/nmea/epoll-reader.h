@@ -0,0 +1,92 @@
+#ifndef GPS_NMEA_EPOLL_READER_H
+#define GPS_NMEA_EPOLL_READER_H
+
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "line-reader.h"
+#include "position.h"
+
+namespace GPS::NMEA
+{
+  /* An event loop that parses NMEA sentences from many file descriptors (serial devices,
+   * pseudo-terminals, pipes or sockets) without blocking on any one of them.  Linux only.
+   *
+   * The file descriptors are watched with epoll and switched to non-blocking mode.  When
+   * data arrives on a descriptor, it is read immediately, split into lines, and every
+   * valid sentence is passed straight to the callback, so a Position is delivered as soon
+   * as the line break that ends its sentence has been read.
+   *
+   * The callbacks are called on the thread that calls poll() or run().  They may call
+   * stop(), but must not call add() or remove().
+   */
+  class EpollReader
+  {
+    public:
+
+      using PositionCallback = std::function<void(int fd, const Position &)>;
+      using ClosedCallback = std::function<void(int fd)>;
+
+      /* The closed callback (optional) is called when a descriptor reaches end-of-file or
+       * fails, after any final unterminated line has been parsed.  The descriptor has
+       * then been removed from the reader, but not closed.
+       *
+       * Throws a std::system_error exception if the epoll instance cannot be created.
+       */
+      explicit EpollReader(PositionCallback, ClosedCallback = nullptr);
+
+      // Closes the epoll instance, but not the watched file descriptors.
+      ~EpollReader();
+
+      EpollReader(const EpollReader &) = delete;
+      EpollReader & operator=(const EpollReader &) = delete;
+
+      /* Start watching a readable file descriptor.  The caller retains ownership of it.
+       * Throws a std::system_error exception if it cannot be watched.
+       */
+      void add(int fd);
+
+      // Stop watching a file descriptor, discarding any incomplete line.
+      void remove(int fd);
+
+      std::size_t watchedCount() const;
+
+      /* Wait up to the timeout (in milliseconds; -1 waits indefinitely) for data, and
+       * process every descriptor that is ready.  Returns the number of Positions delivered.
+       */
+      std::size_t poll(int timeoutMilliseconds);
+
+      /* Process events until stop() is called or no descriptors remain.
+       * If stop() was called before run() started, run() returns immediately.
+       */
+      void run();
+
+      /* Make run() (or a blocking poll()) return.  Safe to call from any thread, or from
+       * within a callback.
+       */
+      void stop();
+
+    private:
+
+      void deliverLine(int fd, std::string_view line);
+      void readAvailable(int fd);
+      void closeDescriptor(int fd);
+
+      const PositionCallback onPosition;
+      const ClosedCallback onClosed;
+
+      int epollFd = -1;
+      int wakeFd = -1;
+      std::atomic<bool> stopRequested{false};
+
+      std::unordered_map<int, LineSplitter> descriptors;
+      std::vector<char> readBuffer;
+      std::size_t positionsDelivered = 0;
+  };
+}
+
+#endif
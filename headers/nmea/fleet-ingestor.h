@@ -0,0 +1,115 @@
+#ifndef GPS_NMEA_FLEET_INGESTOR_H
+#define GPS_NMEA_FLEET_INGESTOR_H
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "thread-pool.h"
+#include "line-reader.h"
+#include "position.h"
+
+namespace GPS::NMEA
+{
+  using StreamId = std::uint64_t;
+
+
+  struct StreamStatistics
+  {
+      std::uint64_t bytesReceived = 0;
+      std::uint64_t linesRead = 0;
+      std::uint64_t positionsRead = 0;
+  };
+
+
+  /* Parses NMEA sentences from many concurrent streams (e.g. one per vehicle receiver)
+   * without a thread per stream.
+   *
+   * Data for each stream is handed over with receive() as it arrives, in pieces of any
+   * size.  Each call to process() then parses the data received so far on a shared
+   * work-stealing thread pool, in batches of ready streams.  A line cut off at the end
+   * of the received data is kept with that stream's state until the rest arrives.
+   *
+   * The consumer is called for every valid sentence.  Calls for the same stream are made
+   * one at a time, in stream order; calls for different streams may be concurrent, so the
+   * consumer must be safe to call concurrently for different streams.
+   */
+  class FleetIngestor
+  {
+    public:
+
+      using Consumer = std::function<void(StreamId, const Position &)>;
+
+      /* A thread count of zero uses the number of hardware threads.
+       * 'streamsPerBatch' is the number of ready streams parsed by each pool task.
+       */
+      explicit FleetIngestor(Consumer, unsigned int threadCount = 0, std::size_t streamsPerBatch = 32);
+
+      /* Append data to a stream, starting a new stream if the id is not yet known.
+       * Safe to call from any thread, including while process() or closeStream() is running.
+       */
+      void receive(StreamId, std::string_view data);
+
+      /* Parse all the data received so far (by receive() calls that finished before this
+       * call started), blocking until it has been parsed.
+       * Must not be called concurrently with itself, closeStream() or statistics().
+       * If the consumer throws, the other streams are still parsed, and the first exception
+       * is rethrown here; the rest of the data being parsed for that stream is discarded.
+       */
+      void process();
+
+      /* Forget a stream, then parse any remaining data for it, including a final line
+       * without a line break.  Has no effect for unknown streams.
+       * Data received for the id once closeStream() has started (including by the consumer,
+       * which may call receive() while the stream is flushed) starts a new stream.
+       * Must not be called concurrently with process().
+       */
+      void closeStream(StreamId);
+
+      std::size_t streamCount() const;
+
+      /* Throws a std::invalid_argument exception for unknown streams.
+       * Must not be called concurrently with process().
+       */
+      StreamStatistics statistics(StreamId) const;
+
+    private:
+
+      struct StreamState
+      {
+          // Guarded by inboxMutex.
+          std::mutex inboxMutex;
+          std::string inbox;
+          bool queued = false;
+          std::uint64_t bytesReceived = 0;
+
+          // Only used by the single task processing the stream.
+          std::string working;
+          LineSplitter splitter;
+          std::uint64_t linesRead = 0;
+          std::uint64_t positionsRead = 0;
+      };
+
+      void processStream(StreamId, StreamState &);
+      void parseLine(StreamId, StreamState &, std::string_view line);
+
+      const Consumer consumer;
+      const std::size_t streamsPerBatch;
+      ThreadPool pool;
+
+      mutable std::shared_mutex streamsMutex;
+      std::unordered_map<StreamId, std::unique_ptr<StreamState>> streams;
+
+      std::mutex readyMutex;
+      std::vector<std::pair<StreamId, StreamState*>> readyStreams;
+  };
+}
+
+#endif
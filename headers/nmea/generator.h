@@ -0,0 +1,75 @@
+#ifndef GPS_NMEA_GENERATOR_H
+#define GPS_NMEA_GENERATOR_H
+
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <string_view>
+
+#include "earth.h"
+#include "position.h"
+
+namespace GPS::NMEA
+{
+  /* Construct a complete NMEA sentence from its body (the text between the '$' and the
+   * '*'), by adding the '$' prefix and the '*' checksum suffix.
+   * E.g. "GPGLL,5425.31,N,107.03,W,82610" becomes "$GPGLL,5425.31,N,107.03,W,82610*69".
+   */
+  std::string sentenceFromBody(std::string_view body);
+
+
+  struct GeneratorOptions
+  {
+      // The same seed (with the same options) always produces the same output.
+      std::uint64_t seed = 1;
+
+      // Generation stops at the first line break at or after this many bytes.
+      std::uint64_t targetBytes = 1024 * 1024;
+
+      // Where the simulated route starts.
+      Position start = Earth::CliftonCampus;
+
+      // The simulated vehicle's average speed, and the time between fixes.
+      speed metresPerSecond = 15;
+      double secondsPerFix = 1;
+
+      // Which sentence formats to emit for each fix (at least one must be enabled).
+      bool emitGLL = true;
+      bool emitGGA = true;
+      bool emitRMC = true;
+
+      /* The fraction of sentences (0 to 1) that are corrupted.  Each corrupted sentence
+       * gets one of: a wrong checksum; truncation part-way through; an invalid bearing
+       * character (with a correct checksum); or a missing field (with a correct checksum).
+       */
+      double corruptionRate = 0;
+  };
+
+
+  struct GeneratorStatistics
+  {
+      std::uint64_t bytesWritten = 0;
+      std::uint64_t fixes = 0;
+      std::uint64_t sentences = 0;
+      std::uint64_t validSentences = 0;
+
+      std::uint64_t badChecksums = 0;
+      std::uint64_t truncatedSentences = 0;
+      std::uint64_t badBearings = 0;
+      std::uint64_t wrongFieldCounts = 0;
+  };
+
+
+  /* Writes synthetic GLL, GGA and RMC sentences (one per line) along a simulated route,
+   * with correct checksums except where deliberately corrupted.
+   *
+   * The route is a random walk with gradually changing heading, speed and elevation,
+   * kept away from the poles.  Output is buffered and written in large blocks, so
+   * multi-gigabyte corpora can be generated quickly.
+   *
+   * Throws a std::invalid_argument exception for invalid options.
+   */
+  GeneratorStatistics generateSentences(std::ostream &, GeneratorOptions = {});
+}
+
+#endif
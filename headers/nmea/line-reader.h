@@ -0,0 +1,118 @@
+#ifndef GPS_NMEA_LINE_READER_H
+#define GPS_NMEA_LINE_READER_H
+
+#include <cstddef>
+#include <cstring>
+#include <istream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace GPS::NMEA
+{
+  /* Splits a stream into lines, using large block reads into a reusable buffer rather
+   * than per-character or per-token extraction.
+   *
+   * Lines may be terminated by "\n" or "\r\n"; the terminator is not included in the
+   * line.  A final line without a terminator is still returned.
+   */
+  class LineReader
+  {
+    public:
+
+      static constexpr std::size_t defaultBlockSize = 64 * 1024;
+
+      /* Pre-condition: the stream outlives the LineReader.
+       */
+      explicit LineReader(std::istream &, std::size_t blockSize = defaultBlockSize);
+
+      /* Reads the next line, returning false if there are no more lines.
+       * The line remains valid until the next call to nextLine().
+       */
+      bool nextLine(std::string_view & line);
+
+    private:
+
+      bool readBlock();
+
+      std::istream & stream;
+      std::vector<char> buffer;
+      std::size_t lineStart = 0; // start of the unconsumed data in the buffer
+      std::size_t dataEnd = 0;   // end of the valid data in the buffer
+      bool endOfStream = false;
+  };
+
+
+  /* Splits data that arrives in arbitrary pieces (e.g. from a socket or serial device) into
+   * lines, with the same line-ending rules as LineReader.
+   *
+   * Complete lines within a piece are passed on without copying; only a line that is cut
+   * off at the end of a piece is kept until the rest of it arrives.
+   */
+  class LineSplitter
+  {
+    public:
+
+      /* Calls onLine(std::string_view) for every line completed by the new data.
+       * Each line remains valid only for the duration of the call.
+       */
+      template <typename Function>
+      void feed(std::string_view data, Function onLine)
+      {
+          while (! data.empty())
+          {
+              const void * newline = std::memchr(data.data(), '\n', data.size());
+              if (newline == nullptr)
+              {
+                  partial.append(data);
+                  return;
+              }
+
+              const std::size_t length = static_cast<const char*>(newline) - data.data();
+              if (partial.empty())
+              {
+                  onLine(withoutCarriageReturn(data.substr(0, length)));
+              }
+              else
+              {
+                  partial.append(data.substr(0, length));
+                  onLine(withoutCarriageReturn(partial));
+                  partial.clear();
+              }
+              data.remove_prefix(length + 1);
+          }
+      }
+
+      /* At the end of the data: calls onLine(std::string_view) for any final line that
+       * was not terminated by a line break.
+       */
+      template <typename Function>
+      void finish(Function onLine)
+      {
+          if (! partial.empty())
+          {
+              onLine(withoutCarriageReturn(partial));
+              partial.clear();
+          }
+      }
+
+      // The length of the incomplete line currently held back.
+      std::size_t pendingBytes() const { return partial.size(); }
+
+    private:
+
+      static std::string_view withoutCarriageReturn(std::string_view line)
+      {
+          if (! line.empty() && line.back() == '\r') line.remove_suffix(1);
+          return line;
+      }
+
+      std::string partial;
+  };
+
+
+  // Remove leading and trailing whitespace (spaces, tabs, '\r' etc.) from a line.
+  std::string_view trimWhitespace(std::string_view);
+}
+
+#endif
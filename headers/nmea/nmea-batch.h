@@ -0,0 +1,61 @@
+#ifndef GPS_NMEA_BATCH_H
+#define GPS_NMEA_BATCH_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "position.h"
+
+namespace GPS::NMEA
+{
+  /* Stores the outcome of reading a single NMEA log file.
+   */
+  struct FileResult
+  {
+      std::string filepath;
+      std::uintmax_t fileSize = 0;
+
+      /* False if the file could not be opened, read or decompressed; the reason is stored
+       * in 'error'.  Invalid sentences within a readable file do not count as a failure.
+       */
+      bool succeeded = false;
+      std::string error;
+
+      std::vector<Position> positions;
+  };
+
+
+  /* Aggregate figures for a batch of NMEA log files.
+   */
+  struct BatchStatistics
+  {
+      unsigned int filesRead = 0;
+      unsigned int filesFailed = 0;
+      std::uintmax_t bytesRead = 0;
+      std::size_t positionsRead = 0;
+      double elapsedSeconds = 0;
+  };
+
+
+  struct BatchResult
+  {
+      // One entry per file, ordered by file path.
+      std::vector<FileResult> files;
+      BatchStatistics statistics;
+  };
+
+
+  /* Reads every regular file in a directory (non-recursively) as a log of NMEA sentences,
+   * using readSentencesFromFile() on each file, so compressed logs are also accepted.
+   *
+   * The files are read concurrently on a work-stealing thread pool, starting with the
+   * largest files so that one large file does not finish long after all the others.
+   * A thread count of zero uses the number of hardware threads.
+   *
+   * Throws a std::invalid_argument exception if the path is not a directory.
+   */
+  BatchResult readDirectory(std::string directory, unsigned int threadCount = 0);
+}
+
+#endif
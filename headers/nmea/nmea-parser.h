@@ -1,9 +1,14 @@
 #ifndef GPS_NMEA_PARSER_H
 #define GPS_NMEA_PARSER_H
 
+#include <array>
+#include <cstddef>
 #include <string>
+#include <string_view>
 #include <vector>
 #include <istream>
+#include <memory_resource>
+#include <optional>
 
 #include "position.h"
 
@@ -13,7 +18,7 @@ namespace GPS::NMEA
    * that is currently supported.
    * Currently the only supported sentence formats are "GLL", "GGA" and "RMC".
    */
-  bool isSupportedFormat(std::string);
+  bool isSupportedFormat(std::string_view);
 
 
   /* Determine whether the parameter conforms to the structure of a NMEA sentence.
@@ -31,7 +36,55 @@ namespace GPS::NMEA
    *
    * Note that this function does NOT check whether the sentence format is supported.
    */
-  bool hasValidSentenceStructure(std::string);
+  bool hasValidSentenceStructure(std::string_view);
+
+
+  /* The characters allowed in the data fields (word characters, '-', '.' and ','), indexed
+   * by unsigned character code.  This is the one definition shared by the structure check
+   * and the sentence scanners; a table lets the scanners test a run of characters without
+   * branching on each one.
+   */
+  inline constexpr std::array<bool, 256> fieldCharacters = []
+  {
+      std::array<bool, 256> table{};
+      for (char c = '0'; c <= '9'; ++c) table[static_cast<unsigned char>(c)] = true;
+      for (char c = 'A'; c <= 'Z'; ++c) table[static_cast<unsigned char>(c)] = true;
+      for (char c = 'a'; c <= 'z'; ++c) table[static_cast<unsigned char>(c)] = true;
+      for (char c : {'_', '-', '.', ','}) table[static_cast<unsigned char>(c)] = true;
+      return table;
+  }();
+
+  // Determine whether the character is allowed in the data fields.
+  constexpr bool isFieldCharacter(char c)
+  {
+      return fieldCharacters[static_cast<unsigned char>(c)];
+  }
+
+  // The value of a hexadecimal digit, or -1 for any other character.
+  constexpr int hexValue(char c)
+  {
+      if (c >= '0' && c <= '9') return c - '0';
+      if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+      if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+      return -1;
+  }
+
+  // The uppercase hexadecimal digit of a value in [0,15].
+  constexpr char hexDigit(int value)
+  {
+      return "0123456789ABCDEF"[value & 0xF];
+  }
+
+  /* The checksum of a sentence body (the characters between the '$' and the '*'): the XOR
+   * reduction of their character codes.  It is written after the '*' as two hexadecimal
+   * digits, the high digit first.
+   */
+  constexpr unsigned char checksumOf(std::string_view body)
+  {
+      unsigned char checksum = 0;
+      for (char c : body) checksum ^= static_cast<unsigned char>(c);
+      return checksum;
+  }
 
 
   /* Verify whether the checksum stored at the end of the sentence matches the sentence
@@ -41,33 +94,65 @@ namespace GPS::NMEA
    * Pre-condition: the argument string must conform to the structure of NMEA sentences.
    * Non-conforming arguments cause undefined behaviour.
    */
-  bool checksumMatches(std::string);
+  bool checksumMatches(std::string_view);
 
 
   /* Stores the format and fields of a NMEA sentence (the checksum is not stored).
+   *
+   * The strings and the vector use polymorphic allocators, so that sentences can be parsed
+   * into an arena (such as a SentenceArena, below) rather than the general-purpose heap.
    */
   struct SentenceData
   {
       /* Stores the NMEA sentence format, excluding the 'GP' prefix.
        * E.g. "GLL".
        */
-      std::string format;
+      std::pmr::string format;
 
       /* Stores the data fields.
        * E.g. the first element of the vector could be "5425.32",
        * and the second element could be "N".
        */
-      std::vector<std::string> dataFields;
+      std::pmr::vector<std::pmr::string> dataFields;
+  };
+
+
+  /* A small arena for parsing one sentence at a time without touching the heap: parse a
+   * sentence with resource(), and release() the arena once its SentenceData has been
+   * discarded.  The arena holds a typical sentence in a fixed buffer; sentences that need
+   * more (e.g. with unusually long fields) take the rest from the upstream resource.
+   */
+  class SentenceArena
+  {
+    public:
+
+      explicit SentenceArena(std::pmr::memory_resource * upstream = std::pmr::get_default_resource());
+
+      SentenceArena(const SentenceArena &) = delete;
+      SentenceArena & operator=(const SentenceArena &) = delete;
+
+      std::pmr::memory_resource * resource();
+
+      // Invalidates everything allocated from the arena.
+      void release();
+
+    private:
+
+      static const std::size_t bufferSize = 1024;
+
+      alignas(std::max_align_t) std::byte buffer[bufferSize];
+      std::pmr::monotonic_buffer_resource arena;
   };
 
 
   /* Extracts the sentence format and the field contents from a NMEA sentence string.
-   * The '$GP' and the checksum are ignored.
+   * The '$GP' and the checksum are ignored.  The SentenceData is allocated from the memory
+   * resource.
    *
    * Pre-condition: the argument string must conform to the structure of NMEA sentences.
    * Non-conforming arguments cause undefined behaviour.
    */
-  SentenceData parseSentence(std::string);
+  SentenceData parseSentence(std::string_view, std::pmr::memory_resource * = std::pmr::get_default_resource());
 
 
   /* Check whether the sentence data contains the correct number of fields for the
@@ -76,7 +161,7 @@ namespace GPS::NMEA
    * Pre-condition: the sentence data contains a supported format.
    * Unsupported formats cause undefined behaviour.
    */
-  bool hasCorrectNumberOfFields(SentenceData);
+  bool hasCorrectNumberOfFields(const SentenceData &);
 
 
   /* Computes a Position from NMEA sentence data.
@@ -91,11 +176,43 @@ namespace GPS::NMEA
    *   - the sentence data contains the correct number of fields for that format.
    * Unsupported formats or incorrect numbers of fields cause undefined behaviour.
    */
-  Position positionFromSentenceData(SentenceData);
+  Position positionFromSentenceData(const SentenceData &);
+
+
+  /* Extracts the UTC time of day from NMEA sentence data, in seconds since midnight.
+   * The time field is "hhmmss" with optional decimal fractions of a second; leading
+   * zeros of the hours may be omitted (e.g. "82610" is 08:26:10).
+   *
+   * If the format is unsupported, or the time field is missing or ill-formed, no value
+   * is returned.
+   */
+  std::optional<double> timeOfDay(const SentenceData &);
+
+
+  /* Extracts the sentence data from a single line containing a NMEA sentence, if the line
+   * meets the first four conditions for a valid sentence (see readSentences() below), i.e.
+   * all but the validity of the data in the fields.  Leading and trailing whitespace is
+   * ignored.  Otherwise, no value is returned.  The SentenceData is allocated from the
+   * memory resource.
+   */
+  std::optional<SentenceData> validSentenceData(std::string_view,
+                                                std::pmr::memory_resource * = std::pmr::get_default_resource());
+
+
+  /* Computes a Position from a single line containing a NMEA sentence, if it is a valid
+   * sentence.  Leading and trailing whitespace is ignored.
+   * For invalid sentences (see readSentences() below), no value is returned.
+   *
+   * The sentence is parsed in a per-thread SentenceArena, so it does not allocate from the
+   * heap.
+   */
+  std::optional<Position> positionFromSentence(std::string_view);
 
 
   /* Reads a stream of NMEA sentences (one sentence per line), and constructs a
    * vector of Positions, ignoring any lines that do not contain valid sentences.
+   * Leading and trailing whitespace (including '\r' from "\r\n" line endings) is
+   * ignored, and the final line need not end with a line break.
    *
    * A line is a valid sentence if all of the following are true:
    *  - the line conforms to the structure of NMEA sentences;
@@ -106,6 +223,11 @@ namespace GPS::NMEA
    */
   std::vector<Position> readSentences(std::istream &);
 
+  /* As above, with the Positions allocated from the memory resource, e.g. a monotonic
+   * arena that is released between batches of logs.
+   */
+  std::pmr::vector<Position> readSentences(std::istream &, std::pmr::memory_resource *);
+
 }
 
 #endif
@@ -0,0 +1,91 @@
+#ifndef GPS_NMEA_PIPELINE_H
+#define GPS_NMEA_PIPELINE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <istream>
+
+#include "position.h"
+
+namespace GPS::NMEA
+{
+  struct PipelineOptions
+  {
+      // The most bytes the reader stage reads from the stream at a time.
+      std::size_t blockSize = 64 * 1024;
+
+      // The capacity of the block queue (reader to parser).
+      std::size_t blockQueueCapacity = 64;
+
+      // The capacity of the Position queue (parser to consumer).
+      std::size_t positionQueueCapacity = 4096;
+  };
+
+
+  /* Timing figures for one stage of the pipeline.
+   * Latency is the time the stage spends on each item: a block for the reader stage,
+   * a line for the parser stage, and a Position for the consumer stage.
+   */
+  struct StageMetrics
+  {
+      std::uint64_t itemsProcessed = 0;
+      double busySeconds = 0;
+      double meanLatencyMicroseconds = 0;
+      double maxLatencyMicroseconds = 0;
+  };
+
+
+  /* Occupancy figures for one of the queues between stages, sampled on every push.
+   * 'fullWaits' counts the pushes that had to wait for the consumer (backpressure).
+   */
+  struct QueueMetrics
+  {
+      std::size_t capacity = 0;
+      std::size_t maxDepth = 0;
+      double meanDepth = 0;
+      std::uint64_t fullWaits = 0;
+  };
+
+
+  struct PipelineMetrics
+  {
+      StageMetrics reader;
+      StageMetrics parser;
+      StageMetrics consumer;
+
+      QueueMetrics blockQueue;
+      QueueMetrics positionQueue;
+
+      /* Time from a block being read to the consumer finishing with each Position
+       * parsed from that block.
+       */
+      double meanEndToEndMicroseconds = 0;
+      double maxEndToEndMicroseconds = 0;
+
+      double elapsedSeconds = 0;
+  };
+
+
+  /* Reads a stream of NMEA sentences through a three-stage pipeline:
+   *   - a reader thread reads blocks of bytes from the stream, taking whatever is available
+   *     without waiting, or else waiting only for the end of the next line, so that live
+   *     input is passed on as each sentence arrives;
+   *   - a parser thread splits the blocks into lines and parses them into Positions,
+   *     ignoring lines that are not valid sentences (as readSentences() does);
+   *   - the calling thread passes each Position, in stream order, to the consumer.
+   *
+   * The stages are connected by lock-free single-producer/single-consumer ring buffers;
+   * a stage whose output queue is full waits for the next stage to catch up.  A waiting
+   * stage spins briefly and then sleeps until it is woken, so an idle pipeline does not
+   * occupy any cores.
+   *
+   * If the consumer, or reading the stream, throws an exception, the pipeline is stopped
+   * and the exception is rethrown once the other stages have finished.
+   */
+  PipelineMetrics runPipeline(std::istream &,
+                              std::function<void(const Position &)> consumer,
+                              PipelineOptions = {});
+}
+
+#endif
@@ -0,0 +1,94 @@
+#ifndef GPS_NMEA_POSITION_RANGE_H
+#define GPS_NMEA_POSITION_RANGE_H
+
+#include <cstddef>
+#include <istream>
+#include <iterator>
+#include <optional>
+
+#include "line-reader.h"
+#include "position.h"
+
+namespace GPS::NMEA
+{
+  /* A single-pass range of the Positions in a stream of NMEA sentences.
+   *
+   * Unlike readSentences(), the Positions are parsed lazily, one at a time as the range is
+   * iterated, so memory use is constant however long the stream is, and each Position can
+   * be processed before the next sentence has been parsed.  Lines are accepted or ignored on
+   * exactly the same basis as readSentences().
+   *
+   * The iterators are input iterators, so the range works with range-based for loops and
+   * the standard algorithms, and (in C++20) with the <ranges> views such as
+   * std::views::filter and std::views::take.
+   */
+  class PositionRange
+  {
+    public:
+
+      class iterator
+      {
+        public:
+
+          using iterator_category = std::input_iterator_tag;
+          using value_type = Position;
+          using difference_type = std::ptrdiff_t;
+          using pointer = const Position *;
+          using reference = const Position &;
+
+          iterator() = default;
+
+          reference operator*() const { return *range->current; }
+          pointer operator->() const { return &*range->current; }
+
+          iterator & operator++() { range->readNext(); return *this; }
+          void operator++(int) { range->readNext(); }
+
+          // All iterators that have reached the end of the range compare equal.
+          friend bool operator==(const iterator & a, const iterator & b) { return a.atEnd() == b.atEnd(); }
+          friend bool operator!=(const iterator & a, const iterator & b) { return ! (a == b); }
+
+        private:
+
+          friend class PositionRange;
+          explicit iterator(PositionRange * range) : range(range) {}
+
+          bool atEnd() const { return range == nullptr || ! range->current.has_value(); }
+
+          PositionRange * range = nullptr;
+      };
+
+      /* Pre-condition: the stream outlives the range.
+       */
+      explicit PositionRange(std::istream &);
+
+      /* The iterators refer to the range itself, and a copy would share the stream, so a
+       * range cannot be copied.  It can be moved (e.g. returned from positions()) before
+       * iteration starts; moving it invalidates any iterators.
+       */
+      PositionRange(const PositionRange &) = delete;
+      PositionRange & operator=(const PositionRange &) = delete;
+      PositionRange(PositionRange &&) = default;
+
+      /* Reads up to the first valid sentence, unless iteration has already started.
+       * As with any single-pass range, begin() does not rewind the stream.
+       */
+      iterator begin();
+      iterator end();
+
+    private:
+
+      void readNext();
+
+      LineReader lines;
+      std::optional<Position> current;
+      bool started = false;
+  };
+
+
+  /* Lazily reads the Positions from a stream of NMEA sentences; see PositionRange.
+   */
+  PositionRange positions(std::istream &);
+}
+
+#endif
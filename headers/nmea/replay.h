@@ -0,0 +1,111 @@
+#ifndef GPS_NMEA_REPLAY_H
+#define GPS_NMEA_REPLAY_H
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <istream>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace GPS::NMEA
+{
+  struct ReplayOptions
+  {
+      enum class Pace
+      {
+          recorded,    // at the times recorded in the sentences, divided by 'speedFactor'
+          fixedRate,   // evenly spaced, at 'sentencesPerSecond'
+          unthrottled  // as fast as the file descriptor accepts them
+      };
+
+      Pace pace = Pace::recorded;
+      double speedFactor = 1;
+      double sentencesPerSecond = 1000;
+  };
+
+
+  struct ReplayStatistics
+  {
+      std::uint64_t linesWritten = 0;
+      std::uint64_t bytesWritten = 0;
+      double elapsedSeconds = 0;
+
+      // How far the writes fell behind the schedule, at worst.
+      double maxLagSeconds = 0;
+  };
+
+
+  /* Replays a recorded NMEA log into a file descriptor (a pipe, pseudo-terminal or socket)
+   * at its original pace, at a multiple of it, or at a fixed rate, so that the streaming
+   * parsers can be load-tested against a local stand-in for a live receiver.
+   *
+   * The whole log is read into memory when the LogReplayer is constructed.  Every line is
+   * replayed verbatim, byte for byte with its original "\n" or "\r\n" terminator (or none,
+   * for a final unterminated line), including invalid sentences (which the consumer should
+   * reject).
+   * The recorded time of a line is the time of day in its sentence; lines without a
+   * valid time take the time of the previous line, and a time more than 12 hours earlier
+   * than the previous one is taken to have crossed midnight.
+   *
+   * To measure end-to-end latency, the consumer calls latencyOf() for each Position it
+   * parses: the n-th Position parsed comes from the n-th valid sentence written.
+   */
+  class LogReplayer
+  {
+    public:
+
+      explicit LogReplayer(std::istream & log);
+
+      std::size_t lineCount() const;
+      std::size_t validSentenceCount() const;
+
+      // The time between the first and last recorded times in the log.
+      double recordedDurationSeconds() const;
+
+      /* The time at which each line is due to be written, relative to the start of the
+       * replay.  Throws a std::invalid_argument exception if the speed factor or rate is
+       * not positive.
+       */
+      std::vector<std::chrono::nanoseconds> schedule(const ReplayOptions &) const;
+
+      /* Write every line (with its original terminator) to the file descriptor at its
+       * scheduled time, blocking until the whole log has been written.  A line that falls
+       * behind schedule is written immediately.  The descriptor is not closed.
+       *
+       * Throws a std::invalid_argument exception for invalid options, or a std::system_error
+       * exception if writing fails.
+       */
+      ReplayStatistics replay(int fd, const ReplayOptions & = {});
+
+      /* The time elapsed since the specified valid sentence (counting from zero) started to
+       * be written.  Safe to call from another thread while replay() is running, for any
+       * sentence that has already been received.
+       * Throws a std::out_of_range exception for an index beyond the valid sentences.
+       */
+      std::chrono::nanoseconds latencyOf(std::size_t validSentenceIndex) const;
+
+    private:
+
+      struct Line
+      {
+          std::size_t offset;
+          std::size_t length; // including the terminator
+          bool valid;
+          double recordedSeconds;
+      };
+
+      void writeAll(int fd, const char * data, std::size_t length);
+
+      std::string text;
+      std::vector<Line> lines;
+      std::size_t validCount = 0;
+
+      // Steady clock times (in nanoseconds) at which each valid sentence was written.
+      std::unique_ptr<std::atomic<std::int64_t>[]> writeTimes;
+  };
+}
+
+#endif
@@ -0,0 +1,68 @@
+#ifndef GPS_NMEA_SENTENCE_SCANNER_H
+#define GPS_NMEA_SENTENCE_SCANNER_H
+
+#include <cstddef>
+#include <istream>
+#include <string_view>
+#include <vector>
+
+#include "position.h"
+
+namespace GPS::NMEA
+{
+  /* Finds the NMEA sentences in a buffer of raw bytes, such as a capture from a serial
+   * port, which may contain garbage between sentences, missing line breaks, and sentences
+   * glued together (e.g. "...*6F$GPGGA,...").
+   *
+   * Each '$' (found with memchr()) starts a candidate sentence, which is accepted if it
+   * conforms to the structure of NMEA sentences (see hasValidSentenceStructure()) up to
+   * its "*hh", and its checksum matches, whatever follows it.  Scanning resumes after the
+   * checksum of an accepted sentence, or at the next '$' after a rejected one, so every
+   * byte is examined at most twice.  Candidates longer than maxSentenceLength are rejected.
+   */
+  class SentenceScanner
+  {
+    public:
+
+      static constexpr std::size_t maxSentenceLength = 1024;
+
+      /* Pre-condition: the buffer outlives the SentenceScanner.
+       */
+      explicit SentenceScanner(std::string_view buffer);
+
+      /* Finds the next sentence, returning false if there are no more.
+       * The sentence is a view of the buffer, from the '$' to the end of the checksum.
+       */
+      bool nextSentence(std::string_view & sentence);
+
+      /* Once nextSentence() has returned false: the offset of the first byte that could
+       * still begin a sentence if more data were appended to the buffer, i.e. the start of a
+       * candidate that was cut off by the end of the buffer, or else the end of the buffer.
+       */
+      std::size_t resumeOffset() const;
+
+    private:
+
+      enum class Candidate { accepted, rejected, incomplete };
+
+      // Checks the candidate starting at the '$' at 'start', setting its length if accepted.
+      Candidate candidateAt(std::size_t start, std::size_t & length) const;
+
+      std::string_view buffer;
+      std::size_t position = 0;
+      std::size_t resume = 0;
+  };
+
+
+  /* The Positions of the valid sentences (see readSentences()) found by a SentenceScanner
+   * in a buffer, in order.
+   */
+  std::vector<Position> scanSentences(std::string_view buffer);
+
+  /* As above, for a stream, which is read in blocks of 'blockSize' bytes.  Only a candidate
+   * sentence that is cut off at the end of a block is kept until the next block.
+   */
+  std::vector<Position> scanSentences(std::istream &, std::size_t blockSize = 64 * 1024);
+}
+
+#endif
@@ -0,0 +1,43 @@
+#ifndef GPS_NMEA_STRUCTURAL_INDEX_H
+#define GPS_NMEA_STRUCTURAL_INDEX_H
+
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+#include "position.h"
+
+namespace GPS::NMEA
+{
+  /* The offsets, in order, of every structural character ('$', ',', '*' and '\n') in a
+   * buffer of NMEA sentences.
+   *
+   * The buffer is scanned 64 bytes at a time: with SSE2 (where the compiler targets it),
+   * each block is compared against the four characters in 16-byte vectors, giving a 64-bit
+   * mask of the structural positions, which is then flattened into offsets by repeatedly
+   * taking the lowest set bit.  Without SSE2 the masks are built a byte at a time.
+   *
+   * Throws a std::invalid_argument exception if the buffer is 4GiB or larger, as the
+   * offsets are 32-bit.
+   */
+  std::vector<std::uint32_t> structuralIndex(std::string_view buffer);
+
+  // The same offsets, found one character at a time, for cross-checking.
+  std::vector<std::uint32_t> structuralIndexScalar(std::string_view buffer);
+
+
+  /* The Positions of the valid sentences in a buffer of NMEA sentences (one per line), as
+   * readSentences() would read them from a stream of the same text, but with the lines,
+   * the fields and the checksum located from the structural index rather than by
+   * examining each character in turn.
+   *
+   * A line is accepted on exactly the same basis as by readSentences(): the index gives the
+   * sentence's structure (a '$' at the start, a '*' three characters from the end, and
+   * only ','s in between), and the remaining characters are checked against a lookup
+   * table and XORed into the checksum in straight-line loops.  The fields are then views
+   * between consecutive structural offsets.
+   */
+  std::vector<Position> readSentencesIndexed(std::string_view buffer);
+}
+
+#endif
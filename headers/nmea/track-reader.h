@@ -0,0 +1,28 @@
+#ifndef GPS_NMEA_TRACK_READER_H
+#define GPS_NMEA_TRACK_READER_H
+
+#include <istream>
+
+#include "fix-filter.h"
+#include "track.h"
+
+namespace GPS::NMEA
+{
+  /* Reads the Positions and times of the valid sentences in a stream of NMEA sentences
+   * into a Track.  Lines are accepted or ignored on the same basis as readSentences(), and
+   * sentences without a valid time of day (see timeOfDay()) are also ignored.
+   *
+   * Times are in seconds since midnight (UTC) at the start of the first sentence's day.
+   * As sentences only give the time of day, a time more than 12 hours earlier than the
+   * previous one is taken to be on the following day; any other earlier time is taken to be
+   * out of order, and that sentence is ignored.
+   */
+  Track readTrack(std::istream &);
+
+  /* As above, passing each fix through a filter as soon as it has been parsed.
+   * The Track contains only the accepted fixes, with their filtered Positions.
+   */
+  Track readTrack(std::istream &, FixFilter &);
+}
+
+#endif
@@ -0,0 +1,34 @@
+#ifndef GPS_NMEA_TRACK_STATISTICS_READER_H
+#define GPS_NMEA_TRACK_STATISTICS_READER_H
+
+#include <cstddef>
+#include <istream>
+#include <string>
+
+#include "track-statistics.h"
+
+namespace GPS::NMEA
+{
+  /* The statistics of the Positions in a stream of NMEA sentences, computed in a single
+   * pass without storing the Positions.  Lines are accepted or ignored on exactly the same
+   * basis as readSentences().
+   */
+  TrackStatistics readTrackStatistics(std::istream &);
+
+
+  /* As above, for a NMEA log file.
+   *
+   * An uncompressed file is split into chunks of about 'chunkSize' bytes, which are parsed
+   * concurrently on a work-stealing thread pool, and the statistics of the chunks are
+   * merged in file order.  Each chunk starts at a line boundary, so every line is parsed
+   * exactly once.  Compressed files (see readSentencesFromFile()) are read on one thread.
+   * A thread count of zero uses the number of hardware threads.
+   *
+   * Throws a std::invalid_argument exception if the file cannot be opened, and a
+   * std::runtime_error exception if a compressed file is corrupt.
+   */
+  TrackStatistics readTrackStatisticsFromFile(std::string filepath, unsigned int threadCount = 0,
+                                              std::size_t chunkSize = 1024 * 1024);
+}
+
+#endif
@@ -3,6 +3,7 @@
 
 #include <string>
 
+#include "geometry.h"
 #include "types.h"
 
 namespace GPS
@@ -14,8 +15,16 @@ namespace GPS
       /* Construct a Position from degrees latitude, degrees longitude, and elevation in metres.
        *
        * Throws a std::invalid_argument exception for invalid latitude and longitude values.
+       *
+       * Can be evaluated at compile time, so Positions can be constexpr constants (where an
+       * invalid angle is a compile-time error).
        */
-      Position(degrees lat, degrees lon, metres ele);
+      constexpr Position(degrees lat, degrees lon, metres ele)
+          : lat(lat), lon(lon), ele(ele)
+      {
+          if (! isValidLatitude(lat)) throwInvalidLatitude();
+          if (! isValidLongitude(lon)) throwInvalidLongitude();
+      }
 
 
       /* Construct a Position from strings containing a DDM (degrees and decimal minutes)
@@ -28,9 +37,9 @@ namespace GPS
                std::string ddmLonStr, char lonBearing,
                std::string eleStr);
 
-      degrees latitude() const;
-      degrees longitude() const;
-      metres  elevation() const;
+      constexpr degrees latitude() const { return lat; }
+      constexpr degrees longitude() const { return lon; }
+      constexpr metres  elevation() const { return ele; }
 
       /* Computes an approximation of the horizontal distance between two Positions on the
        * Earth's surface. Does NOT take into account elevation.
@@ -38,6 +47,9 @@ namespace GPS
       static metres horizontalDistanceBetween(Position, Position);
 
     private:
+      [[noreturn]] static void throwInvalidLatitude();
+      [[noreturn]] static void throwInvalidLongitude();
+
       degrees lat;
       degrees lon;
       metres  ele;
@@ -0,0 +1,93 @@
+#ifndef GPS_SPSC_QUEUE_H
+#define GPS_SPSC_QUEUE_H
+
+#include <atomic>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+namespace GPS
+{
+  /* A lock-free, fixed-capacity ring buffer for passing items from exactly one producer
+   * thread to exactly one consumer thread.
+   *
+   * The producer's and consumer's indices live on separate cache lines, and each side
+   * keeps a private copy of the other side's index, so in the common case a push or pop
+   * touches no cache line that the other thread is writing.
+   *
+   * T must be default-constructible and movable.  The capacity is rounded up to a power
+   * of two.
+   */
+  template <typename T>
+  class SpscQueue
+  {
+    public:
+
+      explicit SpscQueue(std::size_t minimumCapacity)
+          : slots(roundUpToPowerOfTwo(minimumCapacity)), mask(slots.size() - 1)
+      {}
+
+      SpscQueue(const SpscQueue &) = delete;
+      SpscQueue & operator=(const SpscQueue &) = delete;
+
+      std::size_t capacity() const { return slots.size(); }
+
+      // Producer only.  Returns false, leaving the item unchanged, if the queue is full.
+      bool tryPush(T & item)
+      {
+          const std::size_t tail = producer.index.load(std::memory_order_relaxed);
+          if (tail - producer.otherIndexCache == slots.size())
+          {
+              producer.otherIndexCache = consumer.index.load(std::memory_order_acquire);
+              if (tail - producer.otherIndexCache == slots.size()) return false;
+          }
+          slots[tail & mask] = std::move(item);
+          producer.index.store(tail + 1, std::memory_order_release);
+          return true;
+      }
+
+      // Consumer only.  Returns false if the queue is empty.
+      bool tryPop(T & item)
+      {
+          const std::size_t head = consumer.index.load(std::memory_order_relaxed);
+          if (head == consumer.otherIndexCache)
+          {
+              consumer.otherIndexCache = producer.index.load(std::memory_order_acquire);
+              if (head == consumer.otherIndexCache) return false;
+          }
+          item = std::move(slots[head & mask]);
+          consumer.index.store(head + 1, std::memory_order_release);
+          return true;
+      }
+
+      // The number of queued items; only approximate while the other thread is active.
+      std::size_t size() const
+      {
+          return producer.index.load(std::memory_order_acquire) - consumer.index.load(std::memory_order_acquire);
+      }
+
+    private:
+
+      static constexpr std::size_t cacheLineSize = 64;
+
+      static std::size_t roundUpToPowerOfTwo(std::size_t n)
+      {
+          std::size_t capacity = 1;
+          while (capacity < n) capacity *= 2;
+          return capacity;
+      }
+
+      struct alignas(cacheLineSize) Side
+      {
+          std::atomic<std::size_t> index{0};  // written only by this side
+          std::size_t otherIndexCache = 0;    // this side's last view of the other index
+      };
+
+      std::vector<T> slots;
+      const std::size_t mask;
+      Side producer;
+      Side consumer;
+  };
+}
+
+#endif
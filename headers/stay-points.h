@@ -0,0 +1,80 @@
+#ifndef GPS_STAY_POINTS_H
+#define GPS_STAY_POINTS_H
+
+#include <cstddef>
+#include <deque>
+#include <optional>
+#include <vector>
+
+#include "position.h"
+#include "track.h"
+#include "types.h"
+
+namespace GPS
+{
+  // A place where a receiver stayed, e.g. where a vehicle stopped.
+  struct StayPoint
+  {
+      Position centre;        // the mean Position of the fixes of the stay
+      double arrival;         // the time of the first fix of the stay
+      double departure;       // the time of the last fix of the stay
+      std::size_t fixCount;
+  };
+
+
+  /* Finds stay points in the fixes from one receiver as they arrive.
+   *
+   * A stay is a run of consecutive fixes that are all within 'maxDistance' of the first
+   * fix of the run, and that spans at least 'minDuration' seconds.  Each run is as long as
+   * possible, and the next run starts at the first fix that is too far away, whether or
+   * not the previous run was a stay.  (This is the stay-point algorithm of Li et al., 2008.)
+   *
+   * Only the fixes of the current candidate run are stored, and each new fix is compared
+   * only with the first fix of the run, so adding a fix takes constant time (apart from
+   * computing the centre of a stay).  Distances are Position::horizontalDistanceBetween().
+   *
+   * Use one StayPointDetector per stream of fixes.  Not thread-safe.
+   */
+  class StayPointDetector
+  {
+    public:
+
+      /* Throws a std::invalid_argument exception if the distance is not positive, or the
+       * duration is negative.
+       */
+      explicit StayPointDetector(metres maxDistance = 200, double minDuration = 20 * 60);
+
+      /* Returns the stay point that ended before this fix, if any.
+       * Throws a std::invalid_argument exception if the time is earlier than the time of the
+       * previous fix.
+       */
+      std::optional<StayPoint> add(const Position &, double time);
+
+      /* Returns the stay point at the end of the fixes (e.g. a vehicle parked at the end of a
+       * log), if any, and starts afresh.
+       */
+      std::optional<StayPoint> finish();
+
+    private:
+
+      struct Fix
+      {
+          Position position;
+          double time;
+      };
+
+      StayPoint stayPoint(std::size_t fixCount) const;
+
+      const metres maxDistance;
+      const double minDuration;
+
+      // The candidate run, starting at its first fix.
+      std::deque<Fix> fixes;
+  };
+
+
+  // The stay points of a whole Track, in order (including one at the end of the Track).
+  std::vector<StayPoint> findStayPoints(const Track &, metres maxDistance = 200, double minDuration = 20 * 60);
+}
+
+#endif
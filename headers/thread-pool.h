@@ -0,0 +1,81 @@
+#ifndef GPS_THREAD_POOL_H
+#define GPS_THREAD_POOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace GPS
+{
+  /* A fixed-size pool of worker threads, each with its own task queue.
+   *
+   * A worker runs the tasks in its own queue in submission order.  When its own queue
+   * is empty, it steals the oldest task from another worker's queue, so a worker that
+   * is handed a few long tasks does not hold up the rest of the work.
+   */
+  class ThreadPool
+  {
+    public:
+
+      using Task = std::function<void()>;
+
+      /* Start a pool with the specified number of worker threads.
+       * A thread count of zero uses the number of hardware threads (at least one).
+       */
+      explicit ThreadPool(unsigned int threadCount = 0);
+
+      // Waits for all submitted tasks, then stops the workers.
+      ~ThreadPool();
+
+      ThreadPool(const ThreadPool &) = delete;
+      ThreadPool & operator=(const ThreadPool &) = delete;
+
+      unsigned int size() const;
+
+      /* Queue a task, distributing successive tasks round-robin between the workers.
+       * Tasks submitted in decreasing order of cost are therefore started largest-first.
+       */
+      void submit(Task);
+
+      // Queue a task on a specific worker (modulo the pool size).
+      void submit(Task, unsigned int worker);
+
+      /* Block until every task submitted so far has finished.
+       * If any task threw an exception, the first such exception is rethrown here.
+       */
+      void wait();
+
+    private:
+
+      struct WorkerQueue
+      {
+          std::mutex mutex;
+          std::deque<Task> tasks;
+      };
+
+      bool tryTakeTask(unsigned int worker, Task &);
+      void workerLoop(unsigned int worker);
+
+      std::vector<std::unique_ptr<WorkerQueue>> queues;
+      std::vector<std::thread> workers;
+
+      std::mutex stateMutex;
+      std::condition_variable taskAvailable;
+      std::condition_variable allTasksDone;
+      std::size_t queuedTasks = 0;
+      std::size_t unfinishedTasks = 0;
+      bool stopping = false;
+      std::exception_ptr firstException;
+
+      std::atomic<unsigned int> nextWorker{0};
+  };
+}
+
+#endif
@@ -0,0 +1,93 @@
+#ifndef GPS_TRACK_SIMILARITY_H
+#define GPS_TRACK_SIMILARITY_H
+
+#include <cstddef>
+#include <limits>
+#include <optional>
+#include <vector>
+
+#include "track.h"
+#include "types.h"
+
+namespace GPS
+{
+  /* Measures of how far apart two Tracks are, as sequences of Positions (ignoring times and
+   * elevations), using Position::horizontalDistanceBetween() between fixes.
+   *
+   * Both are computed by dynamic programming over the pairs of fixes, keeping only one row
+   * of the table at a time, so they take O(N*M) time but only O(M) memory for Tracks of N
+   * and M fixes.  Each can also be abandoned early, as soon as it is bound to exceed a limit.
+   *
+   * Throws a std::domain_error exception if either Track is empty.
+   */
+
+
+  /* The discrete Fréchet distance: the least possible maximum distance between two walkers
+   * who step through the fixes of each Track in order (each stepping forward, or staying put
+   * while the other steps).  Unlike a comparison of the nearest points, it takes the order
+   * of the fixes into account, so a Track that follows a route backwards is not close to it.
+   */
+  metres frechetDistance(const Track &, const Track &);
+
+  // As above, or no value if the distance is more than 'limit'.
+  std::optional<metres> frechetDistanceWithin(const Track &, const Track &, metres limit);
+
+
+  // Allows dynamic time warping to match any fix of one Track with any fix of the other.
+  inline constexpr std::size_t noWarpingWindow = std::numeric_limits<std::size_t>::max();
+
+  /* The dynamic time warping (DTW) distance: the least possible total of the distances
+   * between matched fixes, where every fix of each Track is matched to at least one fix of
+   * the other, and the matches keep the fixes in order.
+   *
+   * With a warping window, fix 'i' of the first Track can only be matched with the fixes of
+   * the second Track within 'window' of fix i*(M-1)/(N-1) (the same fraction of the way
+   * along).  The window is widened if necessary, so that the Tracks can always be matched
+   * from end to end.
+   */
+  metres dtwDistance(const Track &, const Track &, std::size_t window = noWarpingWindow);
+
+  // As above, or no value if the distance is more than 'limit'.
+  std::optional<metres> dtwDistanceWithin(const Track &, const Track &, metres limit, std::size_t window = noWarpingWindow);
+
+
+  struct RouteSearchOptions
+  {
+      enum class Measure { frechet, dtw };
+
+      Measure measure = Measure::frechet;
+
+      // The warping window, for dynamic time warping.
+      std::size_t window = noWarpingWindow;
+
+      // The number of nearest routes to find.
+      std::size_t count = 1;
+
+      // The number of threads to search on (zero uses the number of hardware threads).
+      unsigned int threadCount = 0;
+  };
+
+  struct RouteMatch
+  {
+      std::size_t route;  // the index in the routes
+      metres distance;
+  };
+
+  /* The routes nearest to a Track, nearest first (and in order of index, for equal
+   * distances).
+   *
+   * A cheap lower bound on the distance to every route is computed first: for dynamic time
+   * warping, the LB_Keogh bound (the total distance from each fix of the Track to the
+   * bounding box of the route's fixes that it could be matched with), and for the Fréchet
+   * distance, the greatest distance from a fix of the Track (or the distance between the
+   * ends) to the bounding box of the route.  The routes are then compared in order of their
+   * lower bounds, on several threads at once, skipping routes whose lower bound is more
+   * than the distance to the furthest of the nearest routes found so far, and abandoning
+   * comparisons as soon as they exceed that distance.
+   *
+   * Throws a std::domain_error exception if the Track or any route is empty.
+   */
+  std::vector<RouteMatch> nearestRoutes(const Track &, const std::vector<Track> & routes, RouteSearchOptions = {});
+}
+
+#endif
@@ -0,0 +1,68 @@
+#ifndef GPS_TRACK_STATISTICS_H
+#define GPS_TRACK_STATISTICS_H
+
+#include <cstddef>
+#include <optional>
+
+#include "geometry.h"
+#include "position.h"
+#include "types.h"
+
+namespace GPS
+{
+  /* Summary figures for a track, accumulated one Position at a time in a single pass, in
+   * constant time and memory per Position.
+   *
+   * The statistics of consecutive pieces of a track (e.g. chunks of a log parsed on
+   * different threads) can be combined with merge().  Merging is associative, so merging the
+   * pieces' statistics in track order, in any grouping, gives the same figures as adding
+   * every Position to a single TrackStatistics (up to floating-point rounding).
+   *
+   * The bounding box does not handle tracks that cross the anti-meridian.
+   */
+  class TrackStatistics
+  {
+    public:
+
+      void add(const Position &);
+
+      // Append the statistics of the piece of track that follows this one.
+      void merge(const TrackStatistics & following);
+
+      std::size_t fixCount() const;
+
+      // The sum of the horizontal distances between consecutive Positions.
+      metres totalDistance() const;
+
+      // The sums of the rises and falls in elevation between consecutive Positions.
+      metres elevationGain() const;
+      metres elevationLoss() const;
+
+      // The following all throw a std::domain_error exception if there are no Positions.
+      BoundingBox boundingBox() const;
+      metres minElevation() const;
+      metres maxElevation() const;
+      metres meanElevation() const;
+      Position first() const;
+      Position last() const;
+
+    private:
+
+      void checkNotEmpty() const;
+
+      std::size_t count = 0;
+      std::optional<Position> firstPosition;
+      std::optional<Position> lastPosition;
+
+      metres distance = 0;
+      metres gain = 0;
+      metres loss = 0;
+
+      BoundingBox box = {0, 0, 0, 0};
+      metres lowest = 0;
+      metres highest = 0;
+      long double elevationSum = 0;
+  };
+}
+
+#endif
@@ -0,0 +1,84 @@
+#ifndef GPS_TRACK_H
+#define GPS_TRACK_H
+
+#include <cstddef>
+#include <vector>
+
+#include "position.h"
+#include "types.h"
+
+namespace GPS
+{
+  /* A sequence of timed Positions, stored as separate columns of latitudes, longitudes,
+   * elevations and times, so that loops over one or two columns read contiguous memory and
+   * can be vectorised by the compiler.
+   *
+   * Times are in seconds (e.g. since midnight of the first fix), and never decrease.
+   */
+  class Track
+  {
+    public:
+
+      /* Throws a std::invalid_argument exception if the time is earlier than the time of
+       * the last Position.
+       */
+      void append(const Position &, double time);
+
+      std::size_t size() const;
+      bool empty() const;
+      void reserve(std::size_t);
+      void clear();
+
+      // Pre-condition: the index is less than size().
+      Position position(std::size_t) const;
+      double time(std::size_t) const;
+
+      /* The Position at the specified time, interpolated between the fixes before and after
+       * it, found by binary search.  Fixes that are close together are interpolated linearly
+       * in latitude and longitude (taking the shorter way around, across the anti-meridian if
+       * necessary), and fixes more than about a kilometre apart are interpolated along the
+       * great circle between them.  Elevations are interpolated linearly.
+       * At a time with several fixes, the last of them is used.
+       *
+       * Throws a std::domain_error exception if the Track is empty, and a
+       * std::invalid_argument exception if the time is outside the Track's time span.
+       */
+      Position positionAt(double time) const;
+
+      /* The Positions at each of the specified times (which must not decrease), as if from
+       * positionAt(), but found in a single pass through the Track.  The linear
+       * interpolations are computed for all the times in vectorisable loops over the columns.
+       *
+       * Throws the same exceptions as positionAt(), and a std::invalid_argument exception if
+       * the times decrease.
+       */
+      Track positionsAt(const std::vector<double> & times) const;
+
+      /* The Track resampled at a fixed interval (in seconds), from the time of the first fix
+       * up to the time of the last.
+       *
+       * Throws a std::domain_error exception if the Track is empty, and a
+       * std::invalid_argument exception if the interval is not positive.
+       */
+      Track resampled(double interval) const;
+
+      const std::vector<degrees> & latitudes() const;
+      const std::vector<degrees> & longitudes() const;
+      const std::vector<metres> & elevations() const;
+      const std::vector<double> & times() const;
+
+    private:
+
+      // The index of the first fix after the time, or the last fix if there are none after.
+      std::size_t fixAfter(double time) const;
+
+      Position interpolate(std::size_t fixAfter, double time) const;
+
+      std::vector<degrees> lats;
+      std::vector<degrees> lons;
+      std::vector<metres> eles;
+      std::vector<double> timeColumn;
+  };
+}
+
+#endif
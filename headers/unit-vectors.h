@@ -0,0 +1,140 @@
+#ifndef GPS_UNIT_VECTORS_H
+#define GPS_UNIT_VECTORS_H
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <vector>
+
+#include "earth.h"
+#include "geometry.h"
+#include "track.h"
+#include "types.h"
+
+namespace GPS
+{
+  /* Fixes as unit vectors on the sphere, and the chords between them.  The chord between two
+   * unit vectors increases with the distance over the surface, so distances can be compared
+   * (and bounded) as squared chords, converting only the results to metres.  This is the
+   * kernel shared by the distance matrix, track similarity and the landmark index.
+   *
+   * These functions are defined here, rather than in a source file, so that they can be
+   * inlined into the loops that call them.
+   */
+
+  // The unit vector of a latitude and longitude, with the z-axis through the North Pole.
+  inline std::array<double,3> unitVector(degrees latitude, degrees longitude)
+  {
+      const radians lat = degToRad(latitude);
+      const radians lon = degToRad(longitude);
+      return {std::cos(lat) * std::cos(lon), std::cos(lat) * std::sin(lon), std::sin(lat)};
+  }
+
+  // The distance over the surface for a squared chord between unit vectors.
+  inline metres distanceFromSquaredChord(double squaredChord)
+  {
+      return 2 * Earth::meanRadius * std::asin(std::min(1.0, std::sqrt(squaredChord) / 2));
+  }
+
+  // The squared chord for a distance over the surface, rounded up slightly.
+  inline double squaredChordFromDistance(metres distance)
+  {
+      if (distance >= pi * Earth::meanRadius) return std::numeric_limits<double>::infinity();
+      const double chord = 2 * std::sin(distance / Earth::meanRadius / 2);
+      return chord * chord * (1 + 1e-12);
+  }
+
+  // The fixes of a Track as unit vectors, stored as separate x, y and z columns.
+  struct UnitVectors
+  {
+      std::vector<double> x, y, z;
+
+      explicit UnitVectors(const Track & track)
+      {
+          const std::size_t size = track.size();
+          x.resize(size);
+          y.resize(size);
+          z.resize(size);
+          for (std::size_t i = 0; i < size; ++i)
+          {
+              const std::array<double,3> v = unitVector(track.latitudes()[i], track.longitudes()[i]);
+              x[i] = v[0];
+              y[i] = v[1];
+              z[i] = v[2];
+          }
+      }
+
+      std::size_t size() const
+      {
+          return x.size();
+      }
+  };
+
+  // The squared chord from fix 'i' of 'a' to each of the fixes [begin,end) of 'b'.
+  inline void squaredChords(const UnitVectors & a, std::size_t i, const UnitVectors & b,
+                            std::size_t begin, std::size_t end, double * out)
+  {
+      const double ax = a.x[i], ay = a.y[i], az = a.z[i];
+      const double * bx = b.x.data(), * by = b.y.data(), * bz = b.z.data();
+      for (std::size_t j = begin; j < end; ++j)
+      {
+          const double dx = ax - bx[j], dy = ay - by[j], dz = az - bz[j];
+          out[j - begin] = dx*dx + dy*dy + dz*dz;
+      }
+  }
+
+  // An axis-aligned bounding box of unit vectors, initially empty.
+  struct UnitVectorBox
+  {
+      double min[3] = {2, 2, 2};
+      double max[3] = {-2, -2, -2};
+
+      void add(const UnitVectors & v, std::size_t i)
+      {
+          const double coordinates[3] = {v.x[i], v.y[i], v.z[i]};
+          for (int axis = 0; axis < 3; ++axis)
+          {
+              min[axis] = std::min(min[axis], coordinates[axis]);
+              max[axis] = std::max(max[axis], coordinates[axis]);
+          }
+      }
+
+      void add(const UnitVectorBox & other)
+      {
+          for (int axis = 0; axis < 3; ++axis)
+          {
+              min[axis] = std::min(min[axis], other.min[axis]);
+              max[axis] = std::max(max[axis], other.max[axis]);
+          }
+      }
+
+      // The squared straight-line distance from fix 'i' of 'v' to the nearest point of the box.
+      double squaredDistanceFrom(const UnitVectors & v, std::size_t i) const
+      {
+          const double coordinates[3] = {v.x[i], v.y[i], v.z[i]};
+          double squaredDistance = 0;
+          for (int axis = 0; axis < 3; ++axis)
+          {
+              const double gap = std::max({0.0, min[axis] - coordinates[axis], coordinates[axis] - max[axis]});
+              squaredDistance += gap * gap;
+          }
+          return squaredDistance;
+      }
+
+      // The squared straight-line distance between the nearest points of two boxes.
+      double squaredDistanceFrom(const UnitVectorBox & other) const
+      {
+          double squaredDistance = 0;
+          for (int axis = 0; axis < 3; ++axis)
+          {
+              const double gap = std::max({0.0, min[axis] - other.max[axis], other.min[axis] - max[axis]});
+              squaredDistance += gap * gap;
+          }
+          return squaredDistance;
+      }
+  };
+}
+
+#endif
@@ -0,0 +1,445 @@
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <stdexcept>
+#include <unordered_map>
+#include <utility>
+
+#include "earth.h"
+#include "geometry.h"
+#include "thread-pool.h"
+#include "clustering.h"
+
+namespace GPS
+{
+  namespace
+  {
+      // Widens the search ranges, so that rounding errors never exclude a neighbour on the edge.
+      const degrees searchMargin = 1e-9;
+
+      // Smaller cells would need more rows and columns than fit in a cell key.
+      const degrees minCellSize = 1e-7;
+
+      /* The Positions, sorted by grid cell, so that the Positions in each cell are contiguous.
+       *
+       * The rows of cells are half the radius high, and each row is divided into as many
+       * columns as needed for its cells to be at most half the radius wide (at the row's
+       * equatorward edge).  Any two Positions in a cell are therefore within the radius of
+       * each other, as there is a path between them of at most one cell width plus one cell
+       * height.
+       */
+      class Grid
+      {
+        public:
+
+          struct Cell
+          {
+              std::uint64_t row;
+              std::uint64_t column;
+              std::size_t begin;  // the range of 'points' in the cell
+              std::size_t end;
+          };
+
+          std::vector<Position> points;
+          std::vector<std::size_t> originalIndices;
+          std::vector<Cell> cells;
+
+          // Whether any two Positions in a cell are known to be within the radius of each other.
+          const bool cellsWithinRadius;
+
+          Grid(const std::vector<Position> & positions, metres radius)
+              : cellsWithinRadius(radToDeg(radius / Earth::meanRadius) / 2 > minCellSize),
+                angularRadius(radius / Earth::meanRadius),
+                latitudeRadius(radToDeg(angularRadius) + searchMargin),
+                // Slightly less than half, so that rounding errors do not matter.
+                cellSize(std::max(radToDeg(angularRadius) / 2 * (1 - 1e-9), minCellSize)),
+                rows(static_cast<std::uint64_t>(std::ceil(halfRotation / cellSize))),
+                radius(radius)
+          {
+              std::vector<std::pair<CellKey,std::size_t>> keys;
+              keys.reserve(positions.size());
+              for (std::size_t i = 0; i < positions.size(); ++i)
+              {
+                  const std::uint64_t r = row(positions[i].latitude());
+                  keys.emplace_back(cellKey(r, column(r, positions[i].longitude())), i);
+              }
+              std::sort(keys.begin(), keys.end());
+
+              points.reserve(positions.size());
+              originalIndices.reserve(positions.size());
+              for (std::size_t i = 0; i < keys.size(); ++i)
+              {
+                  const CellKey key = keys[i].first;
+                  if (i == 0 || key != keys[i-1].first)
+                  {
+                      cellIndices.emplace(key, cells.size());
+                      cells.push_back({key >> 32, key & UINT32_MAX, i, i});
+                  }
+                  ++cells.back().end;
+                  points.push_back(positions[keys[i].second]);
+                  originalIndices.push_back(keys[i].second);
+              }
+          }
+
+          /* Calls 'visit' with the (sorted) index of each point within the radius of point 'i',
+           * including 'i' itself, until 'visit' returns false.
+           */
+          template <typename Visitor>
+          void forEachNeighbour(std::size_t i, Visitor visit) const
+          {
+              const Position & p = points[i];
+              const degrees lat = p.latitude();
+              const degrees lon = p.longitude();
+
+              bool stopped = false;
+              forEachCellNear(lat, lat, lon, lon, [&](const Cell & cell)
+              {
+                  for (std::size_t j = cell.begin; j < cell.end && ! stopped; ++j)
+                  {
+                      stopped = std::abs(points[j].latitude() - lat) <= latitudeRadius
+                                && Position::horizontalDistanceBetween(p, points[j]) <= radius
+                                && ! visit(j);
+                  }
+                  return ! stopped;
+              });
+          }
+
+          struct Bounds
+          {
+              degrees south;
+              degrees north;
+              degrees west;
+              degrees east;
+          };
+
+          Bounds bounds(const Cell & cell) const
+          {
+              const degrees south = cell.row * cellSize - poleLatitude;
+              const degrees west = cell.column * columnWidth(cell.row) - antiMeridianLongitude;
+              return {south, south + cellSize, west, west + columnWidth(cell.row)};
+          }
+
+          /* The greatest difference in longitude between a point in the range of latitudes and a
+           * point within the radius of it (or a half rotation, if that could be any longitude).
+           * The widest point of a circle is not at its centre's latitude, but nearer the pole.
+           */
+          degrees longitudeRadius(degrees south, degrees north) const
+          {
+              const degrees poleward = std::max(std::abs(south), std::abs(north));
+              if (poleward + latitudeRadius >= poleLatitude) return halfRotation;
+
+              const double s = std::sin(angularRadius) / std::cos(degToRad(poleward));
+              return s >= 1 ? halfRotation : radToDeg(std::asin(s)) + searchMargin;
+          }
+
+          // Whether the point may be within the radius of a point in the bounds (but not necessarily).
+          bool mayBeNear(const Position & p, const Bounds & b, degrees lonRadius) const
+          {
+              const degrees lat = p.latitude();
+              if (lat < b.south - latitudeRadius || lat > b.north + latitudeRadius) return false;
+              if (lonRadius >= halfRotation) return true;
+
+              const degrees middle = (b.west + b.east) / 2;
+              return std::abs(normaliseDegrees(p.longitude() - middle)) <= (b.east - b.west) / 2 + lonRadius;
+          }
+
+          /* Calls 'visit' with the index of each later cell that may contain a point within the
+           * radius of a point in cell 'c'.
+           */
+          template <typename Visitor>
+          void forEachLaterCellNear(std::size_t c, Visitor visit) const
+          {
+              const Bounds b = bounds(cells[c]);
+              forEachCellNear(b.south, b.north, b.west, b.east, [&](const Cell & cell)
+              {
+                  const std::size_t d = &cell - cells.data();
+                  if (d > c) visit(d);
+                  return true;
+              });
+          }
+
+        private:
+
+          using CellKey = std::uint64_t;
+
+          /* Calls 'visit' with each cell that may contain a point within the radius of a point
+           * in the specified range of latitudes and longitudes, until 'visit' returns false.
+           */
+          template <typename Visitor>
+          void forEachCellNear(degrees south, degrees north, degrees west, degrees east, Visitor visit) const
+          {
+              const degrees lonRadius = longitudeRadius(south, north);
+              const bool allLongitudes = lonRadius >= halfRotation;
+
+              const std::uint64_t firstRow = row(std::max(south - latitudeRadius, -poleLatitude));
+              const std::uint64_t lastRow = row(std::min(north + latitudeRadius, poleLatitude));
+              for (std::uint64_t r = firstRow; r <= lastRow; ++r)
+              {
+                  const std::uint64_t n = columns(r);
+                  std::uint64_t firstColumn = 0, count = n;
+                  if (! allLongitudes && (east - west) + 2 * lonRadius < fullRotation - columnWidth(r))
+                  {
+                      // Ranges crossing the anti-meridian wrap around from the last column to the first.
+                      firstColumn = column(r, normaliseDegrees(west - lonRadius));
+                      const std::uint64_t lastColumn = column(r, normaliseDegrees(east + lonRadius));
+                      count = (lastColumn + n - firstColumn) % n + 1;
+                  }
+
+                  for (std::uint64_t c = 0; c < count; ++c)
+                  {
+                      const auto cell = cellIndices.find(cellKey(r, (firstColumn + c) % n));
+                      if (cell != cellIndices.end() && ! visit(cells[cell->second])) return;
+                  }
+              }
+          }
+
+          std::uint64_t row(degrees lat) const
+          {
+              return std::min(rows - 1, static_cast<std::uint64_t>(std::max(0.0, (lat + poleLatitude) / cellSize)));
+          }
+
+          std::uint64_t columns(std::uint64_t r) const
+          {
+              const degrees bottom = r * cellSize - poleLatitude;
+              const degrees top = bottom + cellSize;
+              const degrees equatorward = (bottom <= 0 && top >= 0) ? 0 : std::min(std::abs(bottom), std::abs(top));
+              const double n = std::ceil(fullRotation * std::cos(degToRad(equatorward)) / cellSize);
+              return static_cast<std::uint64_t>(std::clamp(n, 1.0, double(UINT32_MAX)));
+          }
+
+          degrees columnWidth(std::uint64_t r) const
+          {
+              return fullRotation / columns(r);
+          }
+
+          std::uint64_t column(std::uint64_t r, degrees lon) const
+          {
+              const std::uint64_t n = columns(r);
+              return static_cast<std::uint64_t>(std::max(0.0, (lon + antiMeridianLongitude) / fullRotation * n)) % n;
+          }
+
+          static CellKey cellKey(std::uint64_t r, std::uint64_t c)
+          {
+              return (r << 32) | c;
+          }
+
+          const radians angularRadius;
+          const degrees latitudeRadius;
+          const degrees cellSize;
+          const std::uint64_t rows;
+          const metres radius;
+
+          std::unordered_map<CellKey, std::size_t> cellIndices;
+      };
+
+      /* A union-find forest that can be updated from many threads at once.  Each tree is
+       * linked under its smallest element, so the roots do not depend on the order of updates.
+       */
+      class ConcurrentUnionFind
+      {
+        public:
+
+          explicit ConcurrentUnionFind(std::size_t size)
+              : parents(size)
+          {
+              for (std::size_t i = 0; i < size; ++i) parents[i].store(i, std::memory_order_relaxed);
+          }
+
+          std::size_t find(std::size_t x)
+          {
+              while (true)
+              {
+                  std::size_t parent = parents[x].load();
+                  if (parent == x) return x;
+
+                  // Path halving: skipping a level is harmless if another thread has changed it.
+                  const std::size_t grandparent = parents[parent].load();
+                  if (grandparent != parent) parents[x].compare_exchange_weak(parent, grandparent);
+                  x = grandparent;
+              }
+          }
+
+          void unite(std::size_t a, std::size_t b)
+          {
+              while (true)
+              {
+                  a = find(a);
+                  b = find(b);
+                  if (a == b) return;
+                  if (a < b) std::swap(a, b);
+
+                  // Link the larger root under the smaller, unless another thread has just linked it.
+                  std::size_t expected = a;
+                  if (parents[a].compare_exchange_strong(expected, b)) return;
+              }
+          }
+
+        private:
+
+          std::vector<std::atomic<std::size_t>> parents;
+      };
+
+      // Runs 'work' on each of the ranges that [0,size) is divided into, and waits for them all.
+      template <typename Work>
+      void forEachRange(ThreadPool & pool, std::size_t size, Work work)
+      {
+          const std::size_t tasks = std::min<std::size_t>(size, pool.size() * 8);
+          for (std::size_t t = 0; t < tasks; ++t)
+          {
+              pool.submit([&work, t, tasks, size] { work(size * t / tasks, size * (t + 1) / tasks); });
+          }
+          pool.wait();
+      }
+  }
+
+  Clusters clusterPositions(const std::vector<Position> & positions, metres radius, std::size_t minPoints,
+                            unsigned int threadCount)
+  {
+      if (! (radius > 0 && radius <= Earth::polarCircumference / 4))
+          throw std::invalid_argument("The cluster radius must be positive, and at most a quarter of the Earth's circumference.");
+
+      if (minPoints == 0)
+          throw std::invalid_argument("The minimum number of Positions in a cluster must be positive.");
+
+      const std::size_t size = positions.size();
+      const Grid grid(positions, radius);
+      ThreadPool pool(threadCount);
+
+      // Core points have at least 'minPoints' neighbours, so the search can stop there.
+      std::vector<char> isCore(size);
+      forEachRange(pool, grid.cells.size(), [&](std::size_t begin, std::size_t end)
+      {
+          for (std::size_t c = begin; c < end; ++c)
+          {
+              const Grid::Cell & cell = grid.cells[c];
+              const bool denseCell = grid.cellsWithinRadius && cell.end - cell.begin >= minPoints;
+              for (std::size_t i = cell.begin; i < cell.end; ++i)
+              {
+                  std::size_t neighbours = denseCell ? minPoints : 0;
+                  if (! denseCell) grid.forEachNeighbour(i, [&](std::size_t) { return ++neighbours < minPoints; });
+                  isCore[i] = neighbours >= minPoints;
+              }
+          }
+      });
+
+      /* Core points join the clusters of their core neighbours.  The core points in a cell are
+       * all neighbours, so two cells' core points are in the same cluster if any pair of them
+       * are neighbours, and only one such pair has to be found.  (Unless the radius is too
+       * small for the cells, when every pair of neighbours is checked.)
+       */
+      ConcurrentUnionFind forest(size);
+      forEachRange(pool, grid.cells.size(), [&](std::size_t begin, std::size_t end)
+      {
+          for (std::size_t c = begin; c < end; ++c)
+          {
+              const Grid::Cell & cell = grid.cells[c];
+              std::vector<std::size_t> cores;
+              for (std::size_t i = cell.begin; i < cell.end; ++i)
+              {
+                  if (isCore[i]) cores.push_back(i);
+              }
+              if (cores.empty()) continue;
+
+              if (! grid.cellsWithinRadius)
+              {
+                  for (std::size_t i : cores)
+                  {
+                      grid.forEachNeighbour(i, [&](std::size_t j)
+                      {
+                          if (j > i && isCore[j]) forest.unite(i, j);
+                          return true;
+                      });
+                  }
+                  continue;
+              }
+
+              for (std::size_t i : cores) forest.unite(cores.front(), i);
+
+              // Only the core points near the other cell need to be compared.
+              const Grid::Bounds bounds = grid.bounds(cell);
+              std::vector<std::size_t> nearCores, otherNearCores;
+              grid.forEachLaterCellNear(c, [&](std::size_t d)
+              {
+                  const Grid::Cell & other = grid.cells[d];
+                  const Grid::Bounds otherBounds = grid.bounds(other);
+                  const degrees longitudeRadius = grid.longitudeRadius(std::min(bounds.south, otherBounds.south),
+                                                                       std::max(bounds.north, otherBounds.north));
+
+                  otherNearCores.clear();
+                  for (std::size_t j = other.begin; j < other.end; ++j)
+                  {
+                      if (isCore[j] && grid.mayBeNear(grid.points[j], bounds, longitudeRadius)) otherNearCores.push_back(j);
+                  }
+                  if (otherNearCores.empty() || forest.find(cores.front()) == forest.find(otherNearCores.front())) return;
+
+                  nearCores.clear();
+                  for (std::size_t i : cores)
+                  {
+                      if (grid.mayBeNear(grid.points[i], otherBounds, longitudeRadius)) nearCores.push_back(i);
+                  }
+
+                  for (std::size_t i : nearCores)
+                  {
+                      for (std::size_t j : otherNearCores)
+                      {
+                          if (Position::horizontalDistanceBetween(grid.points[i], grid.points[j]) <= radius)
+                          {
+                              forest.unite(i, j);
+                              return;
+                          }
+                      }
+                  }
+              });
+          }
+      });
+
+      // Border points join the cluster of their earliest core neighbour.
+      const std::size_t none = size;
+      std::vector<std::size_t> borderCores(size, none);
+      forEachRange(pool, size, [&](std::size_t begin, std::size_t end)
+      {
+          for (std::size_t i = begin; i < end; ++i)
+          {
+              if (isCore[i]) continue;
+
+              std::size_t & earliest = borderCores[i];
+              grid.forEachNeighbour(i, [&](std::size_t j)
+              {
+                  if (isCore[j] && (earliest == none || grid.originalIndices[j] < grid.originalIndices[earliest])) earliest = j;
+                  return true;
+              });
+          }
+      });
+
+      // Number the clusters in order of their first Position.
+      std::vector<std::size_t> firstIndices(size, none);
+      for (std::size_t i = 0; i < size; ++i)
+      {
+          if (isCore[i])
+          {
+              std::size_t & first = firstIndices[forest.find(i)];
+              first = std::min(first, grid.originalIndices[i]);
+          }
+      }
+      std::vector<std::pair<std::size_t,std::size_t>> roots;
+      for (std::size_t i = 0; i < size; ++i)
+      {
+          if (firstIndices[i] != none) roots.emplace_back(firstIndices[i], i);
+      }
+      std::sort(roots.begin(), roots.end());
+
+      std::vector<std::size_t> rootLabels(size, Clusters::noise);
+      for (std::size_t label = 0; label < roots.size(); ++label) rootLabels[roots[label].second] = label;
+
+      Clusters clusters;
+      clusters.count = roots.size();
+      clusters.labels.assign(size, Clusters::noise);
+      for (std::size_t i = 0; i < size; ++i)
+      {
+          const std::size_t core = isCore[i] ? i : borderCores[i];
+          if (core != none) clusters.labels[grid.originalIndices[i]] = rootLabels[forest.find(core)];
+      }
+      return clusters;
+  }
+}
@@ -10,5 +10,6 @@ namespace GPS
       const std::string NMEADir  = dataDir + "NMEA/";
       const std::string GPXRoutesDir = dataDir + "GPX/routes/";
       const std::string GPXTracksDir = dataDir + "GPX/tracks/";
+      const std::string LandmarksDir = dataDir + "landmarks/";
   }
 }
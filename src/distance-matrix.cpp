@@ -0,0 +1,164 @@
+#include <algorithm>
+#include <stdexcept>
+#include <tuple>
+
+#include "thread-pool.h"
+#include "unit-vectors.h"
+#include "distance-matrix.h"
+
+namespace GPS
+{
+  namespace
+  {
+      // 256 fixes of 3 coordinates, for each side of a tile, fit in a 32KiB L1 cache.
+      const std::size_t tileSize = 256;
+
+      // The fixes of a Track as unit vectors, with the bounding box of each tile of them.
+      struct TiledVectors : UnitVectors
+      {
+          std::vector<UnitVectorBox> tiles;
+          UnitVectorBox all;
+
+          explicit TiledVectors(const Track & track)
+            : UnitVectors(track)
+          {
+              for (std::size_t begin = 0; begin < size(); begin += tileSize)
+              {
+                  UnitVectorBox box;
+                  for (std::size_t i = begin; i < std::min(size(), begin + tileSize); ++i) box.add(*this, i);
+                  tiles.push_back(box);
+                  all.add(box);
+              }
+          }
+      };
+
+      // The close pairs between the tile of 'a' starting at fix 'begin' and every tile of 'b'.
+      void closePairsOfTile(const TiledVectors & a, std::size_t firstTrack, std::size_t begin,
+                            const TiledVectors & b, std::size_t secondTrack,
+                            double squaredThreshold, std::vector<ClosePair> & pairs)
+      {
+          const std::size_t end = std::min(a.size(), begin + tileSize);
+          const UnitVectorBox & box = a.tiles[begin / tileSize];
+          double chords[tileSize];
+
+          const std::size_t firstPair = pairs.size();
+          for (std::size_t tile = 0; tile < b.tiles.size(); ++tile)
+          {
+              if (box.squaredDistanceFrom(b.tiles[tile]) > squaredThreshold) continue;
+
+              const std::size_t otherBegin = tile * tileSize;
+              const std::size_t otherEnd = std::min(b.size(), otherBegin + tileSize);
+              for (std::size_t i = begin; i < end; ++i)
+              {
+                  squaredChords(a, i, b, otherBegin, otherEnd, chords);
+                  for (std::size_t j = otherBegin; j < otherEnd; ++j)
+                  {
+                      const double squaredChord = chords[j - otherBegin];
+                      if (squaredChord <= squaredThreshold)
+                      {
+                          pairs.push_back({firstTrack, i, secondTrack, j, distanceFromSquaredChord(squaredChord)});
+                      }
+                  }
+              }
+          }
+
+          // The pairs were found tile by tile, rather than in order of the first fix.
+          std::sort(pairs.begin() + firstPair, pairs.end(), [](const ClosePair & p, const ClosePair & q)
+          {
+              return std::tie(p.firstFix, p.secondFix) < std::tie(q.firstFix, q.secondFix);
+          });
+      }
+
+      std::vector<ClosePair> closePairsBetween(const std::vector<const Track *> & tracks, metres threshold,
+                                               unsigned int threadCount)
+      {
+          if (! (threshold >= 0))
+              throw std::invalid_argument("The distance threshold must not be negative.");
+
+          const double squaredThreshold = squaredChordFromDistance(threshold);
+
+          std::vector<TiledVectors> vectors;
+          vectors.reserve(tracks.size());
+          for (const Track * track : tracks) vectors.emplace_back(*track);
+
+          // One task per tile of the first Track of each pair, each with its own results.
+          struct Task
+          {
+              std::size_t first;
+              std::size_t second;
+              std::size_t begin;
+              std::vector<ClosePair> pairs;
+          };
+          std::vector<Task> tasks;
+          for (std::size_t first = 0; first < vectors.size(); ++first)
+          {
+              for (std::size_t second = first + 1; second < vectors.size(); ++second)
+              {
+                  if (vectors[first].all.squaredDistanceFrom(vectors[second].all) > squaredThreshold) continue;
+
+                  for (std::size_t begin = 0; begin < vectors[first].size(); begin += tileSize)
+                  {
+                      tasks.push_back({first, second, begin, {}});
+                  }
+              }
+          }
+
+          ThreadPool pool(threadCount);
+          for (Task & task : tasks)
+          {
+              pool.submit([&task, &vectors, squaredThreshold]
+              {
+                  closePairsOfTile(vectors[task.first], task.first, task.begin,
+                                   vectors[task.second], task.second, squaredThreshold, task.pairs);
+              });
+          }
+          pool.wait();
+
+          std::vector<ClosePair> pairs;
+          for (const Task & task : tasks) pairs.insert(pairs.end(), task.pairs.begin(), task.pairs.end());
+          return pairs;
+      }
+  }
+
+  std::vector<metres> distanceMatrix(const Track & a, const Track & b, unsigned int threadCount)
+  {
+      const UnitVectors first(a);
+      const UnitVectors second(b);
+      const std::size_t columns = second.size();
+      std::vector<metres> matrix(first.size() * columns);
+
+      // Each task fills the rows of one tile of 'a', tile by tile across 'b'.
+      ThreadPool pool(threadCount);
+      for (std::size_t begin = 0; begin < first.size(); begin += tileSize)
+      {
+          pool.submit([&, begin]
+          {
+              const std::size_t end = std::min(first.size(), begin + tileSize);
+              for (std::size_t otherBegin = 0; otherBegin < columns; otherBegin += tileSize)
+              {
+                  const std::size_t otherEnd = std::min(columns, otherBegin + tileSize);
+                  for (std::size_t i = begin; i < end; ++i)
+                  {
+                      metres * row = &matrix[i * columns + otherBegin];
+                      squaredChords(first, i, second, otherBegin, otherEnd, row);
+                      for (std::size_t j = 0; j < otherEnd - otherBegin; ++j) row[j] = distanceFromSquaredChord(row[j]);
+                  }
+              }
+          });
+      }
+      pool.wait();
+      return matrix;
+  }
+
+  std::vector<ClosePair> closePairs(const std::vector<Track> & tracks, metres threshold, unsigned int threadCount)
+  {
+      std::vector<const Track *> pointers;
+      for (const Track & track : tracks) pointers.push_back(&track);
+      return closePairsBetween(pointers, threshold, threadCount);
+  }
+
+  std::vector<ClosePair> closePairs(const Track & a, const Track & b, metres threshold, unsigned int threadCount)
+  {
+      return closePairsBetween({&a, &b}, threshold, threadCount);
+  }
+}
@@ -1,5 +1,7 @@
+#include <algorithm>
 #include <cmath>
 #include <cassert>
+#include <vector>
 
 #include "geometry.h"
 #include "earth.h"
@@ -8,16 +10,33 @@ namespace GPS
 {
   namespace Earth
   {
-      const Position NorthPole = Position(poleLatitude,0,0);
-      const Position EquatorialMeridian = Position(0,0,0);
-      const Position EquatorialAntiMeridian = Position(0,antiMeridianLongitude,0);
-      const Position CliftonCampus = Position(52.91249953,-1.18402513,58);
-      const Position CityCampus = Position(52.9581383,-1.1542364,53);
-      const Position Pontianak = Position(0,109.322134,0);
+      namespace
+      {
+          // The cosines of latitudes from 0 to 90 degrees, at intervals of cosineTableStep degrees.
+          const degrees cosineTableStep = 0.01;
+
+          const std::vector<double> & cosineTable()
+          {
+              static const std::vector<double> table = []
+              {
+                  const std::size_t size = static_cast<std::size_t>(std::round(poleLatitude / cosineTableStep)) + 1;
+                  std::vector<double> cosines(size);
+                  for (std::size_t i = 0; i < size; ++i) cosines[i] = std::cos(degToRad(i * cosineTableStep));
+                  cosines.back() = 0; // Exactly, so that there is no longitude at the poles.
+                  return cosines;
+              }();
+              return table;
+          }
+
+          // Pre-condition: The latitude is a valid latitude angle.
+          double tableCosine(const std::vector<double> & table, degrees lat)
+          {
+              const double x = std::abs(lat) / cosineTableStep;
+              const std::size_t i = std::min(static_cast<std::size_t>(x), table.size() - 2);
+              return table[i] + (table[i+1] - table[i]) * (x - i);
+          }
+      }
 
-      const metres meanRadius = 6371008.8;
-      const metres equatorialCircumference = 40075160;
-      const metres polarCircumference = 40008000;
 
       metres circumferenceAtLatitude(degrees lat)
       {
@@ -50,5 +69,56 @@ namespace GPS
               return (eastWestDistance / circumferenceAtThisLatitude) * fullRotation;
           }
       }
+
+      std::vector<BoundingBox> boundingBoxes(const std::vector<Position> & centres, metres distance)
+      {
+          assert (distance >= 0 && distance <= polarCircumference);
+
+          const std::vector<double> & table = cosineTable();
+          const degrees latitudeDistance = latitudeSubtendedBy(distance);
+          const double circumferenceFraction = distance / equatorialCircumference;
+
+          std::vector<BoundingBox> boxes;
+          boxes.reserve(centres.size());
+          for (const Position & centre : centres)
+          {
+              const degrees lat = centre.latitude();
+              BoundingBox box = {lat - latitudeDistance, lat + latitudeDistance, -antiMeridianLongitude, antiMeridianLongitude};
+
+              const double cosine = tableCosine(table, lat);
+              if (box.minLatitude <= -poleLatitude || box.maxLatitude >= poleLatitude || circumferenceFraction >= cosine / 2)
+              {
+                  box.minLatitude = std::max(box.minLatitude, -poleLatitude);
+                  box.maxLatitude = std::min(box.maxLatitude, poleLatitude);
+              }
+              else
+              {
+                  const degrees longitudeDistance = circumferenceFraction / cosine * fullRotation;
+                  box.minLongitude = normaliseDegrees(centre.longitude() - longitudeDistance);
+                  box.maxLongitude = normaliseDegrees(centre.longitude() + longitudeDistance);
+              }
+              boxes.push_back(box);
+          }
+          return boxes;
+      }
+
+      std::vector<Position> offsetPositions(const std::vector<Position> & origins, metres northDistance, metres eastDistance)
+      {
+          const std::vector<double> & table = cosineTable();
+          const degrees latitudeChange = latitudeSubtendedBy(northDistance);
+          const double circumferenceFraction = eastDistance / equatorialCircumference;
+
+          std::vector<Position> destinations;
+          destinations.reserve(origins.size());
+          for (const Position & origin : origins)
+          {
+              const double cosine = tableCosine(table, origin.latitude());
+              const degrees longitudeChange = cosine == 0 ? 0 : circumferenceFraction / cosine * fullRotation;
+              destinations.emplace_back(origin.latitude() + latitudeChange,
+                                        normaliseDegrees(origin.longitude() + longitudeChange),
+                                        origin.elevation());
+          }
+          return destinations;
+      }
   }
 }
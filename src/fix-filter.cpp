@@ -0,0 +1,170 @@
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <vector>
+
+#include "earth.h"
+#include "geometry.h"
+#include "fix-filter.h"
+
+namespace GPS
+{
+  namespace
+  {
+      const metres metresPerDegree = Earth::meanRadius * pi / halfRotation;
+
+      /* Advances one axis of the model by 'dt' seconds, then corrects it with a measured
+       * offset from the predicted position.  Returns the correction to the position.
+       */
+      template <typename AxisState>
+      double predictAndCorrect(AxisState & s, double dt, double measuredOffset, double accelerationVariance,
+                               double measurementVariance)
+      {
+          // Predict: the position moves by velocity * dt, and the uncertainty grows.
+          const double dt2 = dt * dt;
+          const double predictedOffset = s.velocity * dt;
+          double p00 = s.positionVariance + 2 * dt * s.covariance + dt2 * s.velocityVariance
+                       + accelerationVariance * dt2 * dt2 / 4;
+          double p01 = s.covariance + dt * s.velocityVariance + accelerationVariance * dt2 * dt / 2;
+          double p11 = s.velocityVariance + accelerationVariance * dt2;
+
+          // Correct, weighting the measurement by the Kalman gain.
+          const double innovation = measuredOffset - predictedOffset;
+          const double innovationVariance = p00 + measurementVariance;
+          const double positionGain = p00 / innovationVariance;
+          const double velocityGain = p01 / innovationVariance;
+
+          s.velocity += velocityGain * innovation;
+          s.positionVariance = (1 - positionGain) * p00;
+          s.covariance = (1 - positionGain) * p01;
+          s.velocityVariance = p11 - velocityGain * p01;
+
+          return predictedOffset + positionGain * innovation;
+      }
+  }
+
+  FixFilter::FixFilter(FilterOptions options)
+      : options(options)
+  {
+      if (! (options.maxSpeed > 0 && options.gateTolerance > 0 &&
+             options.measurementNoise > 0 && options.accelerationNoise > 0))
+          throw std::invalid_argument("Filter speeds, noise levels and tolerances must be positive.");
+  }
+
+  bool FixFilter::passesGate(const Position & p, double time) const
+  {
+      if (time < lastTime) return false;
+      const metres allowed = options.maxSpeed * (time - lastTime) + options.gateTolerance;
+      return Position::horizontalDistanceBetween(lastFix, p) <= allowed;
+  }
+
+  Position FixFilter::accept(const Position & p, double time)
+  {
+      const double measurementVariance = options.measurementNoise * options.measurementNoise;
+
+      if (! started)
+      {
+          started = true;
+          estimate = p;
+          const double initialVelocityVariance = options.maxSpeed * options.maxSpeed;
+          east = north = AxisState{0, measurementVariance, 0, initialVelocityVariance};
+      }
+      else
+      {
+          // The offsets of the fix from the previous estimate, in metres east and north.
+          const double dt = time - lastTime;
+          const double scale = std::cos(degToRad(estimate.latitude()));
+          const metres eastOffset = normaliseDegrees(p.longitude() - estimate.longitude()) * scale * metresPerDegree;
+          const metres northOffset = (p.latitude() - estimate.latitude()) * metresPerDegree;
+          const double accelerationVariance = options.accelerationNoise * options.accelerationNoise;
+
+          const metres eastMove = predictAndCorrect(east, dt, eastOffset, accelerationVariance, measurementVariance);
+          const metres northMove = predictAndCorrect(north, dt, northOffset, accelerationVariance, measurementVariance);
+
+          const degrees lat = std::clamp(estimate.latitude() + northMove / metresPerDegree, -poleLatitude, poleLatitude);
+          const degrees lon = scale > 0 ? normaliseDegrees(estimate.longitude() + eastMove / (scale * metresPerDegree))
+                                        : p.longitude();
+          estimate = Position(lat, lon, p.elevation());
+      }
+
+      lastFix = p;
+      lastTime = time;
+      consecutiveRejections = 0;
+      ++accepted;
+      return estimate;
+  }
+
+  std::optional<Position> FixFilter::add(const Position & p, double time)
+  {
+      if (started && ! passesGate(p, time))
+      {
+          ++rejected;
+          if (++consecutiveRejections >= options.maxConsecutiveRejections) reset();
+          return std::nullopt;
+      }
+      return accept(p, time);
+  }
+
+  Track FixFilter::add(const Track & batch)
+  {
+      const std::size_t n = batch.size();
+      const degrees * lats = batch.latitudes().data();
+      const degrees * lons = batch.longitudes().data();
+      const double * times = batch.times().data();
+
+      /* Approximate distances, in degrees of latitude, scaling longitudes by the cosine of
+       * the latitude nearest the equator, so that east/west distances are never underestimated.
+       */
+      degrees smallestLatitude = poleLatitude;
+      for (std::size_t i = 0; i < n; ++i) smallestLatitude = std::min(smallestLatitude, std::abs(lats[i]));
+      const double scale = std::cos(degToRad(smallestLatitude));
+      const double speedLimit = options.maxSpeed / metresPerDegree / 2;
+      const double toleranceLimit = options.gateTolerance / metresPerDegree / 2;
+
+      std::vector<unsigned char> suspect(n, 1);
+      for (std::size_t i = 1; i < n; ++i)
+      {
+          const double dy = lats[i] - lats[i-1];
+          const double dx = (lons[i] - lons[i-1]) * scale;
+          const double allowed = speedLimit * (times[i] - times[i-1]) + toleranceLimit;
+          suspect[i] = dx*dx + dy*dy > allowed * allowed;
+      }
+
+      Track result;
+      result.reserve(n);
+      bool previousAccepted = false;
+      for (std::size_t i = 0; i < n; ++i)
+      {
+          const Position p = batch.position(i);
+          std::optional<Position> filtered;
+          if (started && previousAccepted && ! suspect[i])
+          {
+              filtered = accept(p, times[i]);
+          }
+          else
+          {
+              filtered = add(p, times[i]);
+          }
+
+          previousAccepted = filtered.has_value();
+          if (filtered) result.append(*filtered, times[i]);
+      }
+      return result;
+  }
+
+  std::uint64_t FixFilter::acceptedCount() const
+  {
+      return accepted;
+  }
+
+  std::uint64_t FixFilter::rejectedCount() const
+  {
+      return rejected;
+  }
+
+  void FixFilter::reset()
+  {
+      started = false;
+      consecutiveRejections = 0;
+  }
+}
@@ -0,0 +1,300 @@
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+#include "earth.h"
+#include "geometry.h"
+#include "geofence.h"
+
+namespace GPS
+{
+  namespace
+  {
+      // Widens bounding boxes, so that rounding errors never exclude a Position on the edge of a zone.
+      const degrees boundingBoxMargin = 1e-9;
+  }
+
+  Geofence::Geofence(double dwellTime, degrees cellSize)
+      : dwellTime(dwellTime),
+        cellSize(cellSize),
+        latitudeCells(cellSize > 0 ? static_cast<std::uint64_t>(std::ceil(halfRotation / cellSize)) : 0),
+        longitudeCells(cellSize > 0 ? static_cast<std::uint64_t>(std::ceil(fullRotation / cellSize)) : 0)
+  {
+      if (! (dwellTime >= 0))
+          throw std::invalid_argument("The dwell time must not be negative.");
+
+      if (! (cellSize > 0 && cellSize <= poleLatitude))
+          throw std::invalid_argument("The cell size must be more than 0 and at most " + std::to_string(poleLatitude) + " degrees.");
+  }
+
+  ZoneId Geofence::addCircle(Position centre, metres radius)
+  {
+      if (! (radius > 0 && radius <= Earth::polarCircumference / 4))
+          throw std::invalid_argument("Circle radii must be positive, and at most a quarter of the Earth's circumference.");
+
+      Zone zone;
+      zone.shape = Zone::Shape::circle;
+      zone.centre = centre;
+      zone.radius = radius;
+
+      const radians angularRadius = radius / Earth::meanRadius;
+      const degrees latitudeRadius = radToDeg(angularRadius) + boundingBoxMargin;
+      zone.minLat = centre.latitude() - latitudeRadius;
+      zone.maxLat = centre.latitude() + latitudeRadius;
+
+      if (zone.minLat <= -poleLatitude || zone.maxLat >= poleLatitude)
+      {
+          // The circle contains a pole, so it covers every longitude.
+          zone.minLat = std::max(zone.minLat, -poleLatitude);
+          zone.maxLat = std::min(zone.maxLat, poleLatitude);
+          zone.minLon = -antiMeridianLongitude;
+          zone.maxLon = antiMeridianLongitude;
+      }
+      else
+      {
+          // The widest point of a circle is not at its centre's latitude, but nearer the pole.
+          const degrees longitudeRadius =
+              radToDeg(std::asin(std::sin(angularRadius) / std::cos(degToRad(centre.latitude())))) + boundingBoxMargin;
+          if (longitudeRadius >= halfRotation)
+          {
+              zone.minLon = -antiMeridianLongitude;
+              zone.maxLon = antiMeridianLongitude;
+          }
+          else
+          {
+              zone.minLon = normaliseDegrees(centre.longitude() - longitudeRadius);
+              zone.maxLon = normaliseDegrees(centre.longitude() + longitudeRadius);
+          }
+      }
+
+      return addZone(std::move(zone));
+  }
+
+  ZoneId Geofence::addPolygon(const std::vector<Position> & vertices)
+  {
+      if (vertices.size() < 3)
+          throw std::invalid_argument("Polygons must have at least three vertices.");
+
+      Zone zone;
+      zone.shape = Zone::Shape::polygon;
+      zone.minLat = zone.minLon = halfRotation;
+      zone.maxLat = zone.maxLon = -halfRotation;
+
+      for (std::size_t i = 0; i < vertices.size(); ++i)
+      {
+          const Position & vertex = vertices[i];
+          const Position & previous = vertices[i == 0 ? vertices.size() - 1 : i - 1];
+          if (std::abs(vertex.longitude() - previous.longitude()) > halfRotation)
+              throw std::invalid_argument("Polygon edges must not span more than " + std::to_string(halfRotation) + " degrees of longitude.");
+
+          zone.vertices.emplace_back(vertex.latitude(), vertex.longitude());
+          zone.minLat = std::min(zone.minLat, vertex.latitude());
+          zone.maxLat = std::max(zone.maxLat, vertex.latitude());
+          zone.minLon = std::min(zone.minLon, vertex.longitude());
+          zone.maxLon = std::max(zone.maxLon, vertex.longitude());
+      }
+
+      zone.minLat -= boundingBoxMargin;
+      zone.maxLat += boundingBoxMargin;
+      zone.minLon -= boundingBoxMargin;
+      zone.maxLon += boundingBoxMargin;
+
+      return addZone(std::move(zone));
+  }
+
+  ZoneId Geofence::addZone(Zone zone)
+  {
+      const ZoneId id = zones.size();
+
+      const CellKey first = cellKey(zone.minLat, zone.minLon);
+      const CellKey last = cellKey(zone.maxLat, zone.maxLon);
+      const std::uint64_t firstRow = first / longitudeCells, lastRow = last / longitudeCells;
+      const std::uint64_t firstColumn = first % longitudeCells, lastColumn = last % longitudeCells;
+
+      // Boxes crossing the anti-meridian wrap around from the last column to the first.
+      std::uint64_t columns = (lastColumn + longitudeCells - firstColumn) % longitudeCells + 1;
+      if (zone.maxLon - zone.minLon >= fullRotation - cellSize) columns = longitudeCells;
+      const std::uint64_t rows = lastRow - firstRow + 1;
+
+      if (rows * columns > maxCellsPerZone)
+      {
+          wideZones.push_back(id);
+      }
+      else
+      {
+          for (std::uint64_t row = firstRow; row <= lastRow; ++row)
+          {
+              for (std::uint64_t column = 0; column < columns; ++column)
+              {
+                  grid[row * longitudeCells + (firstColumn + column) % longitudeCells].push_back(id);
+              }
+          }
+      }
+
+      zones.push_back(std::move(zone));
+      return id;
+  }
+
+  Geofence::CellKey Geofence::cellKey(degrees lat, degrees lon) const
+  {
+      const std::uint64_t row = std::min(latitudeCells - 1,
+                                         static_cast<std::uint64_t>(std::max(0.0, (lat + poleLatitude) / cellSize)));
+      const std::uint64_t column = static_cast<std::uint64_t>(std::max(0.0, (lon + antiMeridianLongitude) / cellSize))
+                                   % longitudeCells;
+      return row * longitudeCells + column;
+  }
+
+  const std::vector<ZoneId> * Geofence::cellZones(CellKey key) const
+  {
+      const auto cell = grid.find(key);
+      return cell == grid.end() ? nullptr : &cell->second;
+  }
+
+  bool Geofence::Zone::contains(Position p) const
+  {
+      const degrees lat = p.latitude();
+      const degrees lon = p.longitude();
+
+      if (lat < minLat || lat > maxLat) return false;
+      if (minLon <= maxLon ? (lon < minLon || lon > maxLon) : (lon < minLon && lon > maxLon)) return false;
+
+      if (shape == Shape::circle)
+      {
+          return Position::horizontalDistanceBetween(centre, p) <= radius;
+      }
+
+      // Counts the edges crossed by a line from the Position towards increasing longitude.
+      bool inside = false;
+      for (std::size_t i = 0, j = vertices.size() - 1; i < vertices.size(); j = i++)
+      {
+          const auto [latI, lonI] = vertices[i];
+          const auto [latJ, lonJ] = vertices[j];
+          if ((latI > lat) != (latJ > lat) && lon < (lonJ - lonI) * (lat - latI) / (latJ - latI) + lonI)
+          {
+              inside = ! inside;
+          }
+      }
+      return inside;
+  }
+
+  void Geofence::findZones(Position p, const std::vector<ZoneId> * candidates, std::vector<ZoneId> & found) const
+  {
+      found.clear();
+      if (candidates)
+      {
+          for (ZoneId id : *candidates)
+          {
+              if (zones[id].contains(p)) found.push_back(id);
+          }
+      }
+
+      const std::size_t indexedCount = found.size();
+      for (ZoneId id : wideZones)
+      {
+          if (zones[id].contains(p)) found.push_back(id);
+      }
+      std::inplace_merge(found.begin(), found.begin() + indexedCount, found.end());
+  }
+
+  std::size_t Geofence::zoneCount() const
+  {
+      return zones.size();
+  }
+
+  std::vector<ZoneId> Geofence::zonesContaining(Position p) const
+  {
+      std::vector<ZoneId> found;
+      findZones(p, cellZones(cellKey(p.latitude(), p.longitude())), found);
+      return found;
+  }
+
+  std::vector<GeofenceEvent> Geofence::update(const std::vector<Fix> & fixes)
+  {
+      std::vector<GeofenceEvent> events;
+      std::vector<ZoneId> found;
+      std::vector<Visit> nextVisits;
+
+      // Consecutive fixes are usually in the same cell, so the last lookup is kept.
+      CellKey lastKey = latitudeCells * longitudeCells;
+      const std::vector<ZoneId> * candidates = nullptr;
+
+      for (const Fix & fix : fixes)
+      {
+          const CellKey key = cellKey(fix.position.latitude(), fix.position.longitude());
+          if (key != lastKey)
+          {
+              candidates = cellZones(key);
+              lastKey = key;
+          }
+          findZones(fix.position, candidates, found);
+
+          const auto subject = visits.find(fix.subject);
+          if (found.empty() && subject == visits.end()) continue;
+
+          static const std::vector<Visit> noVisits;
+          const std::vector<Visit> & previousVisits = subject == visits.end() ? noVisits : subject->second;
+
+          // Both lists are sorted by zone, so they can be merged to find the changes.
+          nextVisits.clear();
+          auto previous = previousVisits.begin();
+          auto current = found.begin();
+          while (previous != previousVisits.end() || current != found.end())
+          {
+              if (current == found.end() || (previous != previousVisits.end() && previous->zone < *current))
+              {
+                  events.push_back({GeofenceEvent::Type::exit, fix.subject, previous->zone, fix.time});
+                  ++previous;
+                  continue;
+              }
+
+              Visit visit = {*current, fix.time, false};
+              if (previous != previousVisits.end() && previous->zone == *current)
+              {
+                  visit = *previous++;
+              }
+              else
+              {
+                  events.push_back({GeofenceEvent::Type::enter, fix.subject, visit.zone, fix.time});
+              }
+              ++current;
+
+              if (! visit.dwellReported && fix.time - visit.entered >= dwellTime)
+              {
+                  events.push_back({GeofenceEvent::Type::dwell, fix.subject, visit.zone, fix.time});
+                  visit.dwellReported = true;
+              }
+              nextVisits.push_back(visit);
+          }
+
+          if (nextVisits.empty())
+          {
+              visits.erase(subject);
+          }
+          else if (subject == visits.end())
+          {
+              visits.emplace(fix.subject, nextVisits);
+          }
+          else
+          {
+              subject->second.swap(nextVisits);
+          }
+      }
+      return events;
+  }
+
+  std::vector<ZoneId> Geofence::zonesOf(SubjectId subject) const
+  {
+      std::vector<ZoneId> result;
+      const auto found = visits.find(subject);
+      if (found != visits.end())
+      {
+          for (const Visit & visit : found->second) result.push_back(visit.zone);
+      }
+      return result;
+  }
+
+  void Geofence::forget(SubjectId subject)
+  {
+      visits.erase(subject);
+  }
+}
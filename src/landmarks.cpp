@@ -0,0 +1,242 @@
+#include <algorithm>
+#include <fstream>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+
+#include "landmarks.h"
+#include "unit-vectors.h"
+
+namespace GPS
+{
+  namespace
+  {
+      std::string trim(const std::string & text)
+      {
+          const auto first = text.find_first_not_of(" \t\r");
+          if (first == std::string::npos) return "";
+          return text.substr(first, text.find_last_not_of(" \t\r") - first + 1);
+      }
+
+      // Throws a std::invalid_argument exception unless the whole text is a number.
+      double toNumber(const std::string & text)
+      {
+          std::size_t used;
+          const double value = std::stod(text, &used);
+          if (used != text.size()) throw std::invalid_argument("'" + text + "' is not a number.");
+          return value;
+      }
+
+      double squaredDistance(const std::array<double,3> & a, const std::array<double,3> & b)
+      {
+          const double dx = a[0] - b[0], dy = a[1] - b[1], dz = a[2] - b[2];
+          return dx*dx + dy*dy + dz*dz;
+      }
+  }
+
+  std::vector<Landmark> readLandmarks(std::istream & stream)
+  {
+      std::vector<Landmark> landmarks;
+      std::string line;
+      for (unsigned long lineNumber = 1; std::getline(stream, line); ++lineNumber)
+      {
+          line = trim(line);
+          if (line.empty() || line.front() == '#') continue;
+
+          std::vector<std::string> fields;
+          std::istringstream fieldStream(line);
+          for (std::string field; std::getline(fieldStream, field, ','); ) fields.push_back(trim(field));
+
+          try
+          {
+              if (fields.size() < 3 || fields.size() > 4 || fields[0].empty())
+                  throw std::invalid_argument("Expected a name, latitude, longitude and optional elevation.");
+
+              const metres elevation = fields.size() == 4 ? toNumber(fields[3]) : 0;
+              landmarks.push_back({fields[0], Position(toNumber(fields[1]), toNumber(fields[2]), elevation)});
+          }
+          catch (const std::exception & e)
+          {
+              throw std::domain_error("Ill-formed landmark on line " + std::to_string(lineNumber) + ": " + e.what());
+          }
+      }
+      return landmarks;
+  }
+
+  std::vector<Landmark> readLandmarks(const std::string & filepath)
+  {
+      std::ifstream file(filepath);
+      if (! file.is_open())
+      {
+          throw std::invalid_argument("Could not open file: " + filepath);
+      }
+      return readLandmarks(file);
+  }
+
+  /////////////////////////////////////////////////////////////////////////////////////////
+
+  // The 'capacity' nearest points found so far, as a max-heap of squared chord distances.
+  struct LandmarkIndex::Candidates
+  {
+      std::size_t capacity;
+      std::vector<std::pair<double,std::size_t>> heap;
+
+      double worstDistance() const
+      {
+          return heap.size() < capacity ? std::numeric_limits<double>::infinity() : heap.front().first;
+      }
+
+      void offer(double distance, std::size_t landmark)
+      {
+          if (heap.size() < capacity)
+          {
+              heap.emplace_back(distance, landmark);
+              std::push_heap(heap.begin(), heap.end());
+          }
+          else if (distance < heap.front().first)
+          {
+              std::pop_heap(heap.begin(), heap.end());
+              heap.back() = {distance, landmark};
+              std::push_heap(heap.begin(), heap.end());
+          }
+      }
+  };
+
+  LandmarkIndex::LandmarkIndex(std::vector<Landmark> landmarks)
+      : stored(std::move(landmarks)),
+        splitAxes(stored.size())
+  {
+      points.reserve(stored.size());
+      for (std::size_t i = 0; i < stored.size(); ++i) points.push_back(unitVector(stored[i].position, i));
+      build(0, points.size());
+  }
+
+  LandmarkIndex::Point LandmarkIndex::unitVector(Position p, std::size_t landmark)
+  {
+      return {GPS::unitVector(p.latitude(), p.longitude()), landmark};
+  }
+
+  // Splits each range at its median, on the axis along which the points are most spread out.
+  void LandmarkIndex::build(std::size_t begin, std::size_t end)
+  {
+      if (end - begin <= 1) return;
+
+      std::array<double,3> lowest, highest;
+      lowest.fill(std::numeric_limits<double>::infinity());
+      highest.fill(-std::numeric_limits<double>::infinity());
+      for (std::size_t i = begin; i < end; ++i)
+      {
+          for (unsigned int axis = 0; axis < 3; ++axis)
+          {
+              lowest[axis] = std::min(lowest[axis], points[i].coordinates[axis]);
+              highest[axis] = std::max(highest[axis], points[i].coordinates[axis]);
+          }
+      }
+      unsigned char axis = 0;
+      for (unsigned char a = 1; a < 3; ++a)
+      {
+          if (highest[a] - lowest[a] > highest[axis] - lowest[axis]) axis = a;
+      }
+
+      const std::size_t middle = begin + (end - begin) / 2;
+      std::nth_element(points.begin() + begin, points.begin() + middle, points.begin() + end,
+                       [axis](const Point & a, const Point & b) { return a.coordinates[axis] < b.coordinates[axis]; });
+      splitAxes[middle] = axis;
+
+      build(begin, middle);
+      build(middle + 1, end);
+  }
+
+  /* 'offsets' holds the distance along each axis from the query to the region of space
+   * covered by the range, and 'regionDistance' the sum of their squares: the squared distance
+   * to the nearest point that the range could contain.  The far side of a split is only
+   * searched if that region is nearer than the worst candidate found so far.
+   */
+  void LandmarkIndex::search(std::size_t begin, std::size_t end, const Point & query, Candidates & candidates,
+                             std::array<double,3> & offsets, double regionDistance) const
+  {
+      if (begin >= end) return;
+
+      const std::size_t middle = begin + (end - begin) / 2;
+      const Point & node = points[middle];
+      candidates.offer(squaredDistance(node.coordinates, query.coordinates), node.landmark);
+
+      const unsigned char axis = splitAxes[middle];
+      const double offset = query.coordinates[axis] - node.coordinates[axis];
+      const std::size_t nearBegin = offset < 0 ? begin : middle + 1, nearEnd = offset < 0 ? middle : end;
+      const std::size_t farBegin = offset < 0 ? middle + 1 : begin, farEnd = offset < 0 ? end : middle;
+
+      search(nearBegin, nearEnd, query, candidates, offsets, regionDistance);
+
+      const double previousOffset = offsets[axis];
+      const double farDistance = regionDistance - previousOffset * previousOffset + offset * offset;
+      if (farDistance < candidates.worstDistance())
+      {
+          offsets[axis] = offset;
+          search(farBegin, farEnd, query, candidates, offsets, farDistance);
+          offsets[axis] = previousOffset;
+      }
+  }
+
+  void LandmarkIndex::search(const Point & query, Candidates & candidates) const
+  {
+      std::array<double,3> offsets = {0, 0, 0};
+      search(0, points.size(), query, candidates, offsets, 0);
+  }
+
+  // Sorts the candidates, nearest first.
+  std::vector<LandmarkIndex::Match> LandmarkIndex::matches(Candidates & candidates) const
+  {
+      std::sort_heap(candidates.heap.begin(), candidates.heap.end());
+
+      std::vector<Match> result;
+      result.reserve(candidates.heap.size());
+      for (const auto & [squaredChord, landmark] : candidates.heap)
+      {
+          result.push_back({landmark, distanceFromSquaredChord(squaredChord)});
+      }
+      return result;
+  }
+
+  const std::vector<Landmark> & LandmarkIndex::landmarks() const
+  {
+      return stored;
+  }
+
+  LandmarkIndex::Match LandmarkIndex::nearest(Position p) const
+  {
+      if (stored.empty())
+      {
+          throw std::domain_error("There are no landmarks to search.");
+      }
+      return nearest(p, 1).front();
+  }
+
+  std::vector<LandmarkIndex::Match> LandmarkIndex::nearest(Position p, std::size_t k) const
+  {
+      Candidates candidates = {k, {}};
+      candidates.heap.reserve(std::min(k, points.size()));
+      if (k > 0) search(unitVector(p, 0), candidates);
+      return matches(candidates);
+  }
+
+  std::vector<LandmarkIndex::Match> LandmarkIndex::nearestToEach(const std::vector<Position> & positions) const
+  {
+      if (stored.empty() && ! positions.empty())
+      {
+          throw std::domain_error("There are no landmarks to search.");
+      }
+
+      std::vector<Match> result;
+      result.reserve(positions.size());
+      Candidates candidates = {1, {}};
+      for (const Position & p : positions)
+      {
+          candidates.heap.clear();
+          search(unitVector(p, 0), candidates);
+          const auto & [squaredChord, landmark] = candidates.heap.front();
+          result.push_back({landmark, distanceFromSquaredChord(squaredChord)});
+      }
+      return result;
+  }
+}
@@ -0,0 +1,88 @@
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+#include "latency-histogram.h"
+
+namespace GPS
+{
+  /* Values below subBucketCount have a bucket each.  Above that, a value whose highest set
+   * bit is bit (subBucketBits + s) goes in group (s + 1), and its next subBucketBits bits
+   * select the bucket within the group.
+   */
+  unsigned int LatencyHistogram::bucketIndex(std::uint64_t nanoseconds)
+  {
+      if (nanoseconds < subBucketCount) return static_cast<unsigned int>(nanoseconds);
+
+      const unsigned int highestBit = 63 - __builtin_clzll(nanoseconds);
+      const unsigned int shift = highestBit - subBucketBits;
+      const unsigned int subBucket = (nanoseconds >> shift) & (subBucketCount - 1);
+      return (shift + 1) * subBucketCount + subBucket;
+  }
+
+  std::uint64_t LatencyHistogram::bucketUpperBound(unsigned int index)
+  {
+      if (index < subBucketCount) return index;
+
+      const unsigned int shift = index / subBucketCount - 1;
+      const std::uint64_t lowerBound = std::uint64_t(subBucketCount + index % subBucketCount) << shift;
+      return lowerBound + ((std::uint64_t(1) << shift) - 1);
+  }
+
+  void LatencyHistogram::record(std::chrono::nanoseconds duration)
+  {
+      const std::uint64_t nanoseconds = std::max<std::chrono::nanoseconds::rep>(0, duration.count());
+      ++buckets[bucketIndex(nanoseconds)];
+      ++total;
+      minimum = std::min(minimum, nanoseconds);
+      maximum = std::max(maximum, nanoseconds);
+      sum += nanoseconds;
+  }
+
+  void LatencyHistogram::merge(const LatencyHistogram & other)
+  {
+      for (unsigned int i = 0; i < bucketCount; ++i) buckets[i] += other.buckets[i];
+      total += other.total;
+      minimum = std::min(minimum, other.minimum);
+      maximum = std::max(maximum, other.maximum);
+      sum += other.sum;
+  }
+
+  std::uint64_t LatencyHistogram::count() const
+  {
+      return total;
+  }
+
+  std::chrono::nanoseconds LatencyHistogram::min() const
+  {
+      return std::chrono::nanoseconds(total == 0 ? 0 : minimum);
+  }
+
+  std::chrono::nanoseconds LatencyHistogram::max() const
+  {
+      return std::chrono::nanoseconds(maximum);
+  }
+
+  std::chrono::nanoseconds LatencyHistogram::mean() const
+  {
+      return std::chrono::nanoseconds(total == 0 ? 0 : std::llround(sum / total));
+  }
+
+  std::chrono::nanoseconds LatencyHistogram::percentile(double percentage) const
+  {
+      if (! (percentage >= 0 && percentage <= 100))
+      {
+          throw std::domain_error("Percentiles must be between 0 and 100.");
+      }
+      if (total == 0) return std::chrono::nanoseconds(0);
+
+      const std::uint64_t rank = std::max<std::uint64_t>(1, std::ceil(percentage / 100 * total));
+      std::uint64_t seen = 0;
+      for (unsigned int i = 0; i < bucketCount; ++i)
+      {
+          seen += buckets[i];
+          if (seen >= rank) return std::chrono::nanoseconds(std::min(bucketUpperBound(i), maximum));
+      }
+      return max();
+  }
+}
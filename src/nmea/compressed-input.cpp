@@ -0,0 +1,263 @@
+#include <fstream>
+#include <stdexcept>
+
+#include <zlib.h>
+#ifdef GPS_HAVE_ZSTD
+#include <zstd.h>
+#endif
+
+#include "nmea-parser.h"
+#include "compressed-input.h"
+
+namespace GPS::NMEA
+{
+  const std::size_t compressedBlockSize = 64 * 1024;
+  const std::size_t decompressedChunkSize = 256 * 1024;
+  const std::size_t queuedChunks = 8;
+
+  Compression detectCompression(std::istream & stream)
+  {
+      // Read the magic bytes straight from the stream buffer, then put them back, so that
+      // the caller goes on to read the stream from its start.
+      using traits = std::streambuf::traits_type;
+      std::streambuf & buffer = *stream.rdbuf();
+
+      unsigned char magic[4] = {};
+      std::size_t bytesRead = 0;
+      for (; bytesRead < sizeof(magic); ++bytesRead)
+      {
+          const traits::int_type c = buffer.sbumpc();
+          if (traits::eq_int_type(c, traits::eof())) break;
+          magic[bytesRead] = static_cast<unsigned char>(traits::to_char_type(c));
+      }
+      for (std::size_t i = 0; i < bytesRead; ++i)
+      {
+          if (traits::eq_int_type(buffer.sungetc(), traits::eof()))
+          {
+              throw std::runtime_error("Could not put back the leading bytes of the stream.");
+          }
+      }
+
+      if (bytesRead >= 2 && magic[0] == 0x1F && magic[1] == 0x8B)
+      {
+          return Compression::gzip;
+      }
+#ifdef GPS_HAVE_ZSTD
+      if (bytesRead >= 4 && magic[0] == 0x28 && magic[1] == 0xB5 && magic[2] == 0x2F && magic[3] == 0xFD)
+      {
+          return Compression::zstd;
+      }
+#endif
+      return Compression::none;
+  }
+
+  Compression detectCompression(std::string filepath)
+  {
+      std::ifstream file(filepath, std::ios::binary);
+      if (! file.is_open())
+      {
+          throw std::invalid_argument("Could not open file: " + filepath);
+      }
+      return detectCompression(file);
+  }
+
+  DecompressingStreamBuf::DecompressingStreamBuf(std::istream & source, Compression compression)
+      : source(source), compression(compression), chunks(queuedChunks)
+  {
+#ifndef GPS_HAVE_ZSTD
+      if (compression == Compression::zstd)
+      {
+          throw std::invalid_argument("This build does not support zstd-compressed input.");
+      }
+#endif
+      worker = std::thread(&DecompressingStreamBuf::decompress, this);
+  }
+
+  DecompressingStreamBuf::~DecompressingStreamBuf()
+  {
+      chunks.close(); // unblocks the worker if the reader stopped early
+      worker.join();
+  }
+
+  void DecompressingStreamBuf::checkForErrors() const
+  {
+      if (error) std::rethrow_exception(error);
+  }
+
+  DecompressingStreamBuf::int_type DecompressingStreamBuf::underflow()
+  {
+      if (gptr() < egptr())
+      {
+          return traits_type::to_int_type(*gptr());
+      }
+
+      do
+      {
+          if (! chunks.pop(currentChunk)) return traits_type::eof();
+      }
+      while (currentChunk.empty());
+
+      char * begin = currentChunk.data();
+      setg(begin, begin, begin + currentChunk.size());
+      return traits_type::to_int_type(*gptr());
+  }
+
+  void DecompressingStreamBuf::decompress()
+  {
+      try
+      {
+          switch (compression)
+          {
+              case Compression::gzip: decompressGzip(); break;
+              case Compression::zstd: decompressZstd(); break;
+              case Compression::none:
+              {
+                  std::string chunk(decompressedChunkSize, '\0');
+                  while (source.read(chunk.data(), chunk.size()) || source.gcount() > 0)
+                  {
+                      chunk.resize(source.gcount());
+                      if (! chunks.push(chunk)) break;
+                      chunk.resize(decompressedChunkSize);
+                  }
+                  break;
+              }
+          }
+      }
+      catch (const std::exception & e)
+      {
+          error = std::make_exception_ptr(std::runtime_error(e.what()));
+      }
+      chunks.close();
+  }
+
+  void DecompressingStreamBuf::decompressGzip()
+  {
+      z_stream zs = {};
+      // 15 window bits, +32 to accept both gzip and zlib headers.
+      if (inflateInit2(&zs, 15 + 32) != Z_OK)
+      {
+          throw std::runtime_error("Could not initialise gzip decompression.");
+      }
+
+      std::string input(compressedBlockSize, '\0');
+      std::string output(decompressedChunkSize, '\0');
+      bool streamEnded = false;
+      bool stopped = false;
+
+      try
+      {
+          while (! stopped)
+          {
+              if (zs.avail_in == 0)
+              {
+                  source.read(input.data(), input.size());
+                  zs.avail_in = source.gcount();
+                  zs.next_in = reinterpret_cast<Bytef*>(input.data());
+                  if (zs.avail_in == 0) break;
+              }
+
+              zs.avail_out = output.size();
+              zs.next_out = reinterpret_cast<Bytef*>(output.data());
+              const int status = inflate(&zs, Z_NO_FLUSH);
+
+              if (status != Z_OK && status != Z_STREAM_END && status != Z_BUF_ERROR)
+              {
+                  throw std::runtime_error(std::string("Corrupt gzip data: ") + (zs.msg ? zs.msg : "inflate failed"));
+              }
+
+              const std::size_t produced = output.size() - zs.avail_out;
+              if (produced > 0)
+              {
+                  stopped = ! chunks.push(output.substr(0, produced));
+              }
+
+              streamEnded = (status == Z_STREAM_END);
+              if (streamEnded)
+              {
+                  inflateReset(&zs); // a gzip file may hold several concatenated members
+              }
+          }
+      }
+      catch (...)
+      {
+          inflateEnd(&zs);
+          throw;
+      }
+      inflateEnd(&zs);
+
+      if (! stopped && ! streamEnded)
+      {
+          throw std::runtime_error("Truncated gzip data.");
+      }
+  }
+
+  void DecompressingStreamBuf::decompressZstd()
+  {
+#ifdef GPS_HAVE_ZSTD
+      ZSTD_DStream * zs = ZSTD_createDStream();
+      if (zs == nullptr)
+      {
+          throw std::runtime_error("Could not initialise zstd decompression.");
+      }
+      if (ZSTD_isError(ZSTD_initDStream(zs)))
+      {
+          ZSTD_freeDStream(zs);
+          throw std::runtime_error("Could not initialise zstd decompression.");
+      }
+
+      std::string input(compressedBlockSize, '\0');
+      std::string output(decompressedChunkSize, '\0');
+      std::size_t lastStatus = 0;
+      bool stopped = false;
+
+      while (! stopped && (source.read(input.data(), input.size()) || source.gcount() > 0))
+      {
+          ZSTD_inBuffer in = { input.data(), static_cast<std::size_t>(source.gcount()), 0 };
+          ZSTD_outBuffer out = { output.data(), output.size(), 0 };
+          // A full output buffer may leave decompressed data inside zstd, even once all the input is consumed.
+          while (! stopped && (in.pos < in.size || out.pos == out.size))
+          {
+              out.pos = 0;
+              lastStatus = ZSTD_decompressStream(zs, &out, &in);
+              if (ZSTD_isError(lastStatus))
+              {
+                  ZSTD_freeDStream(zs);
+                  throw std::runtime_error(std::string("Corrupt zstd data: ") + ZSTD_getErrorName(lastStatus));
+              }
+              if (out.pos > 0)
+              {
+                  stopped = ! chunks.push(output.substr(0, out.pos));
+              }
+          }
+      }
+      ZSTD_freeDStream(zs);
+
+      if (! stopped && lastStatus != 0)
+      {
+          throw std::runtime_error("Truncated zstd data.");
+      }
+#endif
+  }
+
+  std::vector<Position> readSentencesFromFile(std::string filepath)
+  {
+      std::ifstream file(filepath, std::ios::binary);
+      if (! file.is_open())
+      {
+          throw std::invalid_argument("Could not open file: " + filepath);
+      }
+
+      const Compression compression = detectCompression(file);
+
+      if (compression == Compression::none)
+      {
+          return readSentences(file);
+      }
+
+      DecompressingStreamBuf buffer(file, compression);
+      std::istream decompressed(&buffer);
+      std::vector<Position> positions = readSentences(decompressed);
+      buffer.checkForErrors();
+      return positions;
+  }
+}
@@ -0,0 +1,179 @@
+#include <cerrno>
+#include <cstdint>
+#include <string_view>
+#include <system_error>
+
+#include <fcntl.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+
+#include "nmea-parser.h"
+#include "epoll-reader.h"
+
+namespace GPS::NMEA
+{
+  namespace
+  {
+      const std::size_t readBufferSize = 64 * 1024;
+      const int maxEventsPerWait = 64;
+
+      std::system_error systemError(const char * what)
+      {
+          return std::system_error(errno, std::generic_category(), what);
+      }
+  }
+
+  EpollReader::EpollReader(PositionCallback onPosition, ClosedCallback onClosed)
+      : onPosition(std::move(onPosition)), onClosed(std::move(onClosed)), readBuffer(readBufferSize)
+  {
+      epollFd = epoll_create1(EPOLL_CLOEXEC);
+      if (epollFd < 0) throw systemError("epoll_create1");
+
+      wakeFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+      if (wakeFd < 0)
+      {
+          const std::system_error error = systemError("eventfd");
+          ::close(epollFd);
+          throw error;
+      }
+
+      epoll_event event = {};
+      event.events = EPOLLIN;
+      event.data.fd = wakeFd;
+      epoll_ctl(epollFd, EPOLL_CTL_ADD, wakeFd, &event);
+  }
+
+  EpollReader::~EpollReader()
+  {
+      ::close(wakeFd);
+      ::close(epollFd);
+  }
+
+  void EpollReader::add(int fd)
+  {
+      const int flags = fcntl(fd, F_GETFL);
+      if (flags < 0 || fcntl(fd, F_SETFL, flags | O_NONBLOCK) < 0) throw systemError("fcntl");
+
+      epoll_event event = {};
+      event.events = EPOLLIN | EPOLLRDHUP;
+      event.data.fd = fd;
+      if (epoll_ctl(epollFd, EPOLL_CTL_ADD, fd, &event) < 0)
+      {
+          const std::system_error error = systemError("epoll_ctl");
+          fcntl(fd, F_SETFL, flags); // leave the descriptor as it was
+          throw error;
+      }
+
+      descriptors[fd] = LineSplitter();
+  }
+
+  void EpollReader::remove(int fd)
+  {
+      if (descriptors.erase(fd) > 0)
+      {
+          epoll_ctl(epollFd, EPOLL_CTL_DEL, fd, nullptr);
+      }
+  }
+
+  std::size_t EpollReader::watchedCount() const
+  {
+      return descriptors.size();
+  }
+
+  std::size_t EpollReader::poll(int timeoutMilliseconds)
+  {
+      positionsDelivered = 0;
+
+      epoll_event events[maxEventsPerWait];
+      const int eventCount = epoll_wait(epollFd, events, maxEventsPerWait, timeoutMilliseconds);
+      if (eventCount < 0)
+      {
+          if (errno == EINTR) return 0;
+          throw systemError("epoll_wait");
+      }
+
+      for (int i = 0; i < eventCount; ++i)
+      {
+          const int fd = events[i].data.fd;
+          if (fd == wakeFd)
+          {
+              std::uint64_t count;
+              while (::read(wakeFd, &count, sizeof(count)) > 0) {}
+          }
+          else
+          {
+              readAvailable(fd);
+          }
+      }
+      return positionsDelivered;
+  }
+
+  void EpollReader::run()
+  {
+      while (! stopRequested && ! descriptors.empty())
+      {
+          poll(-1);
+      }
+      stopRequested = false; // cleared on return, so a stop() made before run() starts is not lost
+  }
+
+  void EpollReader::stop()
+  {
+      stopRequested = true;
+      const std::uint64_t one = 1;
+      [[maybe_unused]] ssize_t written = ::write(wakeFd, &one, sizeof(one));
+  }
+
+  void EpollReader::deliverLine(int fd, std::string_view line)
+  {
+      if (std::optional<Position> position = positionFromSentence(line))
+      {
+          ++positionsDelivered;
+          onPosition(fd, *position);
+      }
+  }
+
+  void EpollReader::readAvailable(int fd)
+  {
+      LineSplitter & splitter = descriptors.at(fd);
+      auto deliver = [this, fd](std::string_view line) { deliverLine(fd, line); };
+
+      // Read until the descriptor would block, so the loop is not woken again for data
+      // that has already arrived.
+      while (true)
+      {
+          const ssize_t bytesRead = ::read(fd, readBuffer.data(), readBuffer.size());
+          if (bytesRead > 0)
+          {
+              splitter.feed(std::string_view(readBuffer.data(), bytesRead), deliver);
+          }
+          else if (bytesRead < 0 && (errno == EAGAIN || errno == EWOULDBLOCK))
+          {
+              return;
+          }
+          else if (bytesRead < 0 && errno == EINTR)
+          {
+              continue;
+          }
+          else
+          {
+              // End-of-file, or an error such as EIO from a pseudo-terminal whose other end closed.
+              closeDescriptor(fd);
+              return;
+          }
+      }
+  }
+
+  void EpollReader::closeDescriptor(int fd)
+  {
+      auto it = descriptors.find(fd);
+      if (it == descriptors.end()) return;
+
+      LineSplitter splitter = std::move(it->second);
+      remove(fd);
+      splitter.finish([this, fd](std::string_view line) { deliverLine(fd, line); });
+
+      if (onClosed) onClosed(fd);
+  }
+}
@@ -0,0 +1,154 @@
+#include <algorithm>
+#include <exception>
+#include <stdexcept>
+#include <utility>
+
+#include "nmea-parser.h"
+#include "fleet-ingestor.h"
+
+namespace GPS::NMEA
+{
+  FleetIngestor::FleetIngestor(Consumer consumer, unsigned int threadCount, std::size_t streamsPerBatch)
+      : consumer(std::move(consumer)),
+        streamsPerBatch(std::max<std::size_t>(1, streamsPerBatch)),
+        pool(threadCount)
+  {}
+
+  void FleetIngestor::receive(StreamId id, std::string_view data)
+  {
+      // Held until the stream is queued, so that closeStream() cannot remove it in between.
+      std::shared_lock<std::shared_mutex> lock(streamsMutex);
+      auto it = streams.find(id);
+      while (it == streams.end())
+      {
+          lock.unlock();
+          {
+              std::unique_lock<std::shared_mutex> writeLock(streamsMutex);
+              std::unique_ptr<StreamState> & slot = streams[id];
+              if (! slot) slot = std::make_unique<StreamState>();
+          }
+          lock.lock();
+          it = streams.find(id); // the stream may have been closed again in the meantime
+      }
+      StreamState * state = it->second.get();
+
+      bool becameReady;
+      {
+          std::lock_guard<std::mutex> lock(state->inboxMutex);
+          state->inbox.append(data);
+          state->bytesReceived += data.size();
+          becameReady = ! state->queued;
+          state->queued = true;
+      }
+
+      if (becameReady)
+      {
+          std::lock_guard<std::mutex> lock(readyMutex);
+          readyStreams.emplace_back(id, state);
+      }
+  }
+
+  void FleetIngestor::process()
+  {
+      std::vector<std::pair<StreamId, StreamState*>> batch;
+      {
+          std::lock_guard<std::mutex> lock(readyMutex);
+          batch.swap(readyStreams);
+      }
+
+      // Each stream appears at most once, so no stream is parsed by two tasks at once.
+      for (std::size_t start = 0; start < batch.size(); start += streamsPerBatch)
+      {
+          const std::size_t end = std::min(batch.size(), start + streamsPerBatch);
+          pool.submit([this, &batch, start, end]
+          {
+              // The other streams must still be processed if the consumer throws for one,
+              // as they have been taken off the ready list and would never be queued again.
+              std::exception_ptr firstException;
+              for (std::size_t i = start; i < end; ++i)
+              {
+                  try
+                  {
+                      processStream(batch[i].first, *batch[i].second);
+                  }
+                  catch (...)
+                  {
+                      if (! firstException) firstException = std::current_exception();
+                  }
+              }
+              if (firstException) std::rethrow_exception(firstException);
+          });
+      }
+      pool.wait();
+  }
+
+  void FleetIngestor::processStream(StreamId id, StreamState & state)
+  {
+      state.working.clear(); // keeps its capacity, which the inbox takes over in the swap
+      {
+          std::lock_guard<std::mutex> lock(state.inboxMutex);
+          state.working.swap(state.inbox);
+          state.queued = false;
+      }
+
+      state.splitter.feed(state.working, [&](std::string_view line) { parseLine(id, state, line); });
+  }
+
+  void FleetIngestor::parseLine(StreamId id, StreamState & state, std::string_view line)
+  {
+      ++state.linesRead;
+      if (std::optional<Position> position = positionFromSentence(line))
+      {
+          ++state.positionsRead;
+          consumer(id, *position);
+      }
+  }
+
+  void FleetIngestor::closeStream(StreamId id)
+  {
+      // Take the stream out of the map, so that the flush below needs no lock on it: the
+      // consumer may then call receive(), and data received from now on starts a new stream.
+      std::unique_ptr<StreamState> state;
+      {
+          std::unique_lock<std::shared_mutex> lock(streamsMutex);
+          auto it = streams.find(id);
+          if (it == streams.end()) return;
+          state = std::move(it->second);
+          streams.erase(it);
+
+          std::lock_guard<std::mutex> readyLock(readyMutex);
+          readyStreams.erase(std::remove_if(readyStreams.begin(), readyStreams.end(),
+                                            [id](const auto & ready) { return ready.first == id; }),
+                             readyStreams.end());
+      }
+
+      processStream(id, *state);
+      state->splitter.finish([&](std::string_view line) { parseLine(id, *state, line); });
+  }
+
+  std::size_t FleetIngestor::streamCount() const
+  {
+      std::shared_lock<std::shared_mutex> lock(streamsMutex);
+      return streams.size();
+  }
+
+  StreamStatistics FleetIngestor::statistics(StreamId id) const
+  {
+      std::shared_lock<std::shared_mutex> lock(streamsMutex);
+      auto it = streams.find(id);
+      if (it == streams.end())
+      {
+          throw std::invalid_argument("Unknown stream id: " + std::to_string(id));
+      }
+
+      StreamState & state = *it->second;
+      StreamStatistics stats;
+      {
+          std::lock_guard<std::mutex> inboxLock(state.inboxMutex);
+          stats.bytesReceived = state.bytesReceived;
+      }
+      stats.linesRead = state.linesRead;
+      stats.positionsRead = state.positionsRead;
+      return stats;
+  }
+}
@@ -0,0 +1,290 @@
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <stdexcept>
+
+#include "geometry.h"
+#include "earth.h"
+#include "generator.h"
+#include "nmea-parser.h"
+
+namespace GPS::NMEA
+{
+  namespace
+  {
+      const std::size_t outputBlockSize = 1024 * 1024;
+      const degrees maxRouteLatitude = 80;
+      const metres minElevation = -50;
+      const metres maxElevation = 3000;
+      const long daysFromEpochToStartDate = 18262; // 2020-01-01
+
+      enum class Corruption { none, badChecksum, truncated, badBearing, wrongFieldCount };
+
+      void appendSentence(std::string & out, std::string_view body, unsigned int checksum)
+      {
+          out += '$';
+          out += body;
+          out += '*';
+          out += hexDigit(checksum >> 4);
+          out += hexDigit(checksum);
+      }
+
+      // Append an angle in DDM format ("ddmm.mmmm" or "dddmm.mmmm") followed by its bearing.
+      void appendDDM(std::string & body, degrees angle, int degreeDigits, char positiveBearing, char negativeBearing)
+      {
+          const char bearing = (angle < 0) ? negativeBearing : positiveBearing;
+          angle = std::abs(angle);
+          int wholeDegrees = static_cast<int>(std::floor(angle));
+          long tenThousandthsOfMinutes = std::lround((angle - wholeDegrees) * minutesPerDegree * 10000);
+          if (tenThousandthsOfMinutes >= static_cast<long>(minutesPerDegree) * 10000)
+          {
+              ++wholeDegrees;
+              tenThousandthsOfMinutes -= minutesPerDegree * 10000;
+          }
+
+          char buffer[32];
+          const int length = std::snprintf(buffer, sizeof(buffer), "%0*d%02ld.%04ld,%c", degreeDigits, wholeDegrees,
+                                           tenThousandthsOfMinutes / 10000, tenThousandthsOfMinutes % 10000, bearing);
+          body.append(buffer, length);
+      }
+
+      void appendTime(std::string & body, double secondsSinceStart, bool fractional)
+      {
+          const long totalMilliseconds = std::lround(secondsSinceStart * 1000);
+          const long millisecondsOfDay = totalMilliseconds % (24 * 3600 * 1000);
+          const long seconds = millisecondsOfDay / 1000;
+
+          char buffer[32];
+          const int length = fractional
+              ? std::snprintf(buffer, sizeof(buffer), "%02ld%02ld%02ld.%03ld",
+                              seconds / 3600, (seconds / 60) % 60, seconds % 60, millisecondsOfDay % 1000)
+              : std::snprintf(buffer, sizeof(buffer), "%02ld%02ld%02ld",
+                              seconds / 3600, (seconds / 60) % 60, seconds % 60);
+          body.append(buffer, length);
+      }
+
+      /* Append a date in "ddmmyy" format.
+       * See: http://howardhinnant.github.io/date_algorithms.html#civil_from_days
+       */
+      void appendDate(std::string & body, long daysSinceEpoch)
+      {
+          const long z = daysSinceEpoch + 719468;
+          const long era = z / 146097;
+          const long dayOfEra = z - era * 146097;
+          const long yearOfEra = (dayOfEra - dayOfEra/1460 + dayOfEra/36524 - dayOfEra/146096) / 365;
+          const long dayOfYear = dayOfEra - (365*yearOfEra + yearOfEra/4 - yearOfEra/100);
+          const long mp = (5*dayOfYear + 2) / 153;
+          const long day = dayOfYear - (153*mp + 2)/5 + 1;
+          const long month = mp < 10 ? mp + 3 : mp - 9;
+          const long year = yearOfEra + era * 400 + (month <= 2);
+
+          char buffer[16];
+          const int length = std::snprintf(buffer, sizeof(buffer), "%02ld%02ld%02ld", day, month, year % 100);
+          body.append(buffer, length);
+      }
+
+      void appendNumber(std::string & body, const char * format, double value)
+      {
+          char buffer[32];
+          const int length = std::snprintf(buffer, sizeof(buffer), format, value);
+          body.append(buffer, length);
+      }
+
+      class Route
+      {
+        public:
+
+          Route(const GeneratorOptions & options, std::mt19937_64 & random)
+              : options(options), random(random),
+                lat(options.start.latitude()), lon(options.start.longitude()), ele(options.start.elevation()),
+                heading(std::uniform_real_distribution<degrees>(0, fullRotation)(random)),
+                metresPerSecond(options.metresPerSecond)
+          {}
+
+          void advance()
+          {
+              std::normal_distribution<double> turn(0, 5);
+              std::normal_distribution<double> acceleration(0, 0.5);
+              std::normal_distribution<double> climb(0, 0.5);
+
+              heading = normaliseDegrees(heading + turn(random));
+              metresPerSecond = std::clamp(metresPerSecond + acceleration(random), 0.0, 3 * options.metresPerSecond);
+              ele = std::clamp(ele + climb(random), minElevation, maxElevation);
+
+              const metres distance = metresPerSecond * options.secondsPerFix;
+              const radians headingRad = degToRad(heading);
+              lat += Earth::latitudeSubtendedBy(distance * std::cos(headingRad));
+              if (std::abs(lat) > maxRouteLatitude)
+              {
+                  lat = std::copysign(maxRouteLatitude, lat);
+                  heading = normaliseDegrees(halfRotation - heading); // turn back from the pole
+              }
+              lon = normaliseDegrees(lon + Earth::longitudeSubtendedBy(distance * std::sin(headingRad), lat));
+
+              secondsSinceStart += options.secondsPerFix;
+          }
+
+          degrees latitude() const { return lat; }
+          degrees longitude() const { return lon; }
+          metres elevation() const { return ele; }
+          degrees course() const { return heading < 0 ? heading + fullRotation : heading; }
+          double knots() const { return metresPerSecond * 3600 / 1852; }
+          double seconds() const { return secondsSinceStart; }
+          long day() const { return daysFromEpochToStartDate + static_cast<long>(secondsSinceStart / (24 * 3600)); }
+
+        private:
+
+          const GeneratorOptions & options;
+          std::mt19937_64 & random;
+          degrees lat, lon;
+          metres ele;
+          degrees heading;
+          speed metresPerSecond;
+          double secondsSinceStart = 0;
+      };
+  }
+
+  std::string sentenceFromBody(std::string_view body)
+  {
+      std::string sentence;
+      appendSentence(sentence, body, checksumOf(body));
+      return sentence;
+  }
+
+  GeneratorStatistics generateSentences(std::ostream & stream, GeneratorOptions options)
+  {
+      if (! (options.emitGLL || options.emitGGA || options.emitRMC))
+      {
+          throw std::invalid_argument("At least one sentence format must be enabled.");
+      }
+      if (! (options.corruptionRate >= 0 && options.corruptionRate <= 1))
+      {
+          throw std::invalid_argument("The corruption rate must be between 0 and 1.");
+      }
+      if (! (options.secondsPerFix > 0) || ! (options.metresPerSecond >= 0))
+      {
+          throw std::invalid_argument("The time between fixes must be positive, and the speed non-negative.");
+      }
+
+      std::mt19937_64 random(options.seed);
+      std::uniform_real_distribution<double> unit(0, 1);
+      std::uniform_int_distribution<int> corruptionKind(1, 4);
+
+      Route route(options, random);
+      GeneratorStatistics stats;
+      std::string out;
+      out.reserve(outputBlockSize + 1024);
+      std::string body;
+
+      auto emit = [&](std::size_t latBearingIndex)
+      {
+          Corruption corruption = Corruption::none;
+          if (options.corruptionRate > 0 && unit(random) < options.corruptionRate)
+          {
+              corruption = static_cast<Corruption>(corruptionKind(random));
+          }
+
+          switch (corruption)
+          {
+              case Corruption::none:
+                  ++stats.validSentences;
+                  break;
+              case Corruption::badChecksum:
+                  ++stats.badChecksums;
+                  break;
+              case Corruption::truncated:
+                  ++stats.truncatedSentences;
+                  break;
+              case Corruption::badBearing:
+                  body[latBearingIndex] = 'X';
+                  ++stats.badBearings;
+                  break;
+              case Corruption::wrongFieldCount:
+                  body.erase(body.rfind(','));
+                  ++stats.wrongFieldCounts;
+                  break;
+          }
+
+          const std::size_t sentenceStart = out.size();
+          unsigned int checksum = checksumOf(body);
+          if (corruption == Corruption::badChecksum)
+          {
+              checksum ^= std::uniform_int_distribution<unsigned int>(1, 0xFF)(random);
+          }
+          appendSentence(out, body, checksum);
+          if (corruption == Corruption::truncated)
+          {
+              // Keep at least the '$', and cut off at least the "*hh" suffix.
+              const std::size_t sentenceLength = out.size() - sentenceStart;
+              const std::size_t keep = std::uniform_int_distribution<std::size_t>(1, sentenceLength - 3)(random);
+              out.resize(sentenceStart + keep);
+          }
+          out += '\n';
+          ++stats.sentences;
+      };
+
+      while (stats.bytesWritten + out.size() < options.targetBytes)
+      {
+          if (options.emitGLL)
+          {
+              body = "GPGLL,";
+              appendDDM(body, route.latitude(), 2, 'N', 'S');
+              const std::size_t latBearingIndex = body.size() - 1;
+              body += ',';
+              appendDDM(body, route.longitude(), 3, 'E', 'W');
+              body += ',';
+              appendTime(body, route.seconds(), false);
+              emit(latBearingIndex);
+          }
+
+          if (options.emitGGA)
+          {
+              body = "GPGGA,";
+              appendTime(body, route.seconds(), true);
+              body += ',';
+              appendDDM(body, route.latitude(), 2, 'N', 'S');
+              const std::size_t latBearingIndex = body.size() - 1;
+              body += ',';
+              appendDDM(body, route.longitude(), 3, 'E', 'W');
+              body += ",1,08,1.0,";
+              appendNumber(body, "%.1f", route.elevation());
+              body += ",M,,M,,";
+              emit(latBearingIndex);
+          }
+
+          if (options.emitRMC)
+          {
+              body = "GPRMC,";
+              appendTime(body, route.seconds(), true);
+              body += ",A,";
+              appendDDM(body, route.latitude(), 2, 'N', 'S');
+              const std::size_t latBearingIndex = body.size() - 1;
+              body += ',';
+              appendDDM(body, route.longitude(), 3, 'E', 'W');
+              body += ',';
+              appendNumber(body, "%.3f", route.knots());
+              body += ',';
+              appendNumber(body, "%.2f", route.course());
+              body += ',';
+              appendDate(body, route.day());
+              body += ",,A";
+              emit(latBearingIndex);
+          }
+
+          ++stats.fixes;
+          route.advance();
+
+          if (out.size() >= outputBlockSize)
+          {
+              stream.write(out.data(), out.size());
+              stats.bytesWritten += out.size();
+              out.clear();
+          }
+      }
+
+      stream.write(out.data(), out.size());
+      stats.bytesWritten += out.size();
+      return stats;
+  }
+}
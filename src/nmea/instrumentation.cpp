@@ -0,0 +1,145 @@
+#include <algorithm>
+#include <atomic>
+#include <iomanip>
+#include <mutex>
+#include <stdexcept>
+#include <vector>
+
+#include "instrumentation.h"
+
+namespace GPS::NMEA::Instrumentation
+{
+  namespace
+  {
+      /* One thread's counters.  Only the owning thread writes them, so updates need no
+       * read-modify-write; they are atomic only so that report() may read them.
+       */
+      struct ThreadCounters
+      {
+          std::array<std::atomic<std::uint64_t>, stageCount> calls = {};
+          std::array<std::atomic<std::uint64_t>, stageCount> nanoseconds = {};
+
+          ThreadCounters();
+          ~ThreadCounters();
+
+          void addTo(Report & report) const
+          {
+              for (std::size_t i = 0; i < stageCount; ++i)
+              {
+                  report[i].calls += calls[i].load(std::memory_order_relaxed);
+                  report[i].nanoseconds += nanoseconds[i].load(std::memory_order_relaxed);
+              }
+          }
+
+          void clear()
+          {
+              for (std::size_t i = 0; i < stageCount; ++i)
+              {
+                  calls[i].store(0, std::memory_order_relaxed);
+                  nanoseconds[i].store(0, std::memory_order_relaxed);
+              }
+          }
+      };
+
+      struct Registry
+      {
+          std::mutex mutex;
+          std::vector<ThreadCounters*> liveThreads;
+          Report finishedThreads = {};
+      };
+
+      // Never destroyed, so that threads may finish during static destruction.
+      Registry & registry()
+      {
+          static Registry * const instance = new Registry;
+          return *instance;
+      }
+
+      ThreadCounters::ThreadCounters()
+      {
+          Registry & r = registry();
+          std::lock_guard<std::mutex> lock(r.mutex);
+          r.liveThreads.push_back(this);
+      }
+
+      ThreadCounters::~ThreadCounters()
+      {
+          Registry & r = registry();
+          std::lock_guard<std::mutex> lock(r.mutex);
+          addTo(r.finishedThreads);
+          r.liveThreads.erase(std::find(r.liveThreads.begin(), r.liveThreads.end(), this));
+      }
+
+      void increment(std::atomic<std::uint64_t> & counter, std::uint64_t amount)
+      {
+          counter.store(counter.load(std::memory_order_relaxed) + amount, std::memory_order_relaxed);
+      }
+  }
+
+  const char * stageName(Stage stage)
+  {
+      switch (stage)
+      {
+          case Stage::structureCheck:       return "structure check";
+          case Stage::checksum:             return "checksum";
+          case Stage::fieldSplit:           return "field split";
+          case Stage::fieldCheck:           return "field check";
+          case Stage::positionConstruction: return "position construction";
+      }
+      return "unknown";
+  }
+
+  void record(Stage stage, std::chrono::nanoseconds duration)
+  {
+      thread_local ThreadCounters counters;
+      const std::size_t i = static_cast<std::size_t>(stage);
+      increment(counters.calls[i], 1);
+      increment(counters.nanoseconds[i], duration.count());
+  }
+
+  void setSampleInterval(unsigned int sentences)
+  {
+      if (sentences == 0) throw std::invalid_argument("The sample interval must be at least one sentence.");
+      currentSampleInterval.store(sentences, std::memory_order_relaxed);
+  }
+
+  Report report()
+  {
+      Registry & r = registry();
+      std::lock_guard<std::mutex> lock(r.mutex);
+      Report totals = r.finishedThreads;
+      for (const ThreadCounters * counters : r.liveThreads) counters->addTo(totals);
+      return totals;
+  }
+
+  void reset()
+  {
+      Registry & r = registry();
+      std::lock_guard<std::mutex> lock(r.mutex);
+      r.finishedThreads = {};
+      for (ThreadCounters * counters : r.liveThreads) counters->clear();
+  }
+
+  void printReport(std::ostream & out, const Report & report)
+  {
+      std::uint64_t totalNanoseconds = 0;
+      for (const StageStatistics & stage : report) totalNanoseconds += stage.nanoseconds;
+
+      const std::ios_base::fmtflags flags = out.flags();
+      const std::streamsize precision = out.precision();
+      out << std::left << std::setw(24) << "stage"
+          << std::right << std::setw(12) << "calls" << std::setw(14) << "total ms"
+          << std::setw(12) << "ns/call" << std::setw(9) << "share" << "\n";
+      for (std::size_t i = 0; i < stageCount; ++i)
+      {
+          const StageStatistics & stage = report[i];
+          out << std::left << std::setw(24) << stageName(static_cast<Stage>(i))
+              << std::right << std::setw(12) << stage.calls
+              << std::fixed << std::setprecision(3) << std::setw(14) << stage.nanoseconds / 1e6
+              << std::setprecision(1) << std::setw(12) << (stage.calls ? double(stage.nanoseconds) / stage.calls : 0.0)
+              << std::setw(8) << (totalNanoseconds ? 100.0 * stage.nanoseconds / totalNanoseconds : 0.0) << "%\n";
+      }
+      out.flags(flags);
+      out.precision(precision);
+  }
+}
@@ -0,0 +1,74 @@
+#include <cstring>
+
+#include "line-reader.h"
+
+namespace GPS::NMEA
+{
+  LineReader::LineReader(std::istream & stream, std::size_t blockSize)
+      : stream(stream), buffer(blockSize > 0 ? blockSize : defaultBlockSize)
+  {}
+
+  bool LineReader::nextLine(std::string_view & line)
+  {
+      std::size_t searchFrom = lineStart;
+      while (true)
+      {
+          const char * begin = buffer.data() + lineStart;
+          const void * newline = std::memchr(buffer.data() + searchFrom, '\n', dataEnd - searchFrom);
+
+          if (newline != nullptr)
+          {
+              std::size_t length = static_cast<const char*>(newline) - begin;
+              lineStart += length + 1;
+              if (length > 0 && begin[length-1] == '\r') --length;
+              line = std::string_view(begin, length);
+              return true;
+          }
+
+          if (endOfStream)
+          {
+              if (lineStart == dataEnd) return false;
+
+              std::size_t length = dataEnd - lineStart;
+              lineStart = dataEnd;
+              if (begin[length-1] == '\r') --length;
+              line = std::string_view(begin, length);
+              return true;
+          }
+
+          // No complete line in the buffer: keep the partial line, and read another block.
+          searchFrom = dataEnd - lineStart;
+          if (! readBlock()) endOfStream = true;
+          searchFrom += lineStart;
+      }
+  }
+
+  bool LineReader::readBlock()
+  {
+      const std::size_t remaining = dataEnd - lineStart;
+      if (lineStart > 0)
+      {
+          std::memmove(buffer.data(), buffer.data() + lineStart, remaining);
+          lineStart = 0;
+          dataEnd = remaining;
+      }
+      if (dataEnd == buffer.size())
+      {
+          buffer.resize(buffer.size() * 2); // a line longer than the block size
+      }
+
+      stream.read(buffer.data() + dataEnd, buffer.size() - dataEnd);
+      const std::size_t bytesRead = stream.gcount();
+      dataEnd += bytesRead;
+      return bytesRead > 0;
+  }
+
+  std::string_view trimWhitespace(std::string_view s)
+  {
+      const char * whitespace = " \t\r\n\v\f";
+      const std::size_t first = s.find_first_not_of(whitespace);
+      if (first == std::string_view::npos) return {};
+      const std::size_t last = s.find_last_not_of(whitespace);
+      return s.substr(first, last - first + 1);
+  }
+}
@@ -0,0 +1,86 @@
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <stdexcept>
+
+#include "thread-pool.h"
+#include "compressed-input.h"
+#include "nmea-batch.h"
+
+namespace GPS::NMEA
+{
+  namespace fs = std::filesystem;
+
+  namespace
+  {
+      void readFile(FileResult & result)
+      {
+          try
+          {
+              result.positions = readSentencesFromFile(result.filepath);
+              result.succeeded = true;
+          }
+          catch (const std::exception & e)
+          {
+              result.error = e.what();
+          }
+      }
+  }
+
+  BatchResult readDirectory(std::string directory, unsigned int threadCount)
+  {
+      if (! fs::is_directory(directory))
+      {
+          throw std::invalid_argument(directory + " is not a directory.");
+      }
+
+      const auto startTime = std::chrono::steady_clock::now();
+
+      BatchResult batch;
+      for (const fs::directory_entry & entry : fs::directory_iterator(directory))
+      {
+          if (entry.is_regular_file())
+          {
+              FileResult result;
+              result.filepath = entry.path().string();
+              result.fileSize = entry.file_size();
+              batch.files.push_back(std::move(result));
+          }
+      }
+      std::sort(batch.files.begin(), batch.files.end(),
+                [](const FileResult & a, const FileResult & b) { return a.filepath < b.filepath; });
+
+      // Largest-first schedule; each task writes only to its own pre-allocated result.
+      std::vector<FileResult*> schedule;
+      for (FileResult & result : batch.files) schedule.push_back(&result);
+      std::stable_sort(schedule.begin(), schedule.end(),
+                       [](const FileResult * a, const FileResult * b) { return a->fileSize > b->fileSize; });
+
+      {
+          ThreadPool pool(threadCount);
+          for (FileResult * result : schedule)
+          {
+              pool.submit([result]{ readFile(*result); });
+          }
+          pool.wait();
+      }
+
+      BatchStatistics & stats = batch.statistics;
+      for (const FileResult & result : batch.files)
+      {
+          if (result.succeeded)
+          {
+              ++stats.filesRead;
+              stats.bytesRead += result.fileSize;
+              stats.positionsRead += result.positions.size();
+          }
+          else
+          {
+              ++stats.filesFailed;
+          }
+      }
+      stats.elapsedSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+
+      return batch;
+  }
+}
@@ -1,66 +1,85 @@
+#include <algorithm>
 #include <stdexcept>
-#include <regex>
 
+#include "instrumentation.h"
+#include "line-reader.h"
 #include "nmea-parser.h"
+#include "position-range.h"
 
 namespace GPS::NMEA
 {
-  bool isSupportedFormat(std::string characterFormat)
+  namespace
   {
-      //Regex to determine whether the parameter is the three-character code for sentence format
-      const std::regex reg("(GLL|GGA|RMC)");
-      return std::regex_match (characterFormat, reg);
+      bool isUppercase(char c)
+      {
+          return c >= 'A' && c <= 'Z';
+      }
   }
 
-  bool hasValidSentenceStructure(std::string sentence)
+  bool isSupportedFormat(std::string_view characterFormat)
   {
-      //Regex to determine whether the sentence conforms to the structure of NMEA sentence
-      std::regex expression("(\\$GP)([A-Z]){3},(\\w|[-]|[.]|[,]){0,}\\*[[:xdigit:]]{2}");
-      return std::regex_match(sentence, expression);
+      return characterFormat == "GLL" || characterFormat == "GGA" || characterFormat == "RMC";
   }
 
-  bool checksumMatches(std::string sentence)
+  bool hasValidSentenceStructure(std::string_view sentence)
   {
-      int baseHex = 16;
-      int endPoint = sentence.length() - 2;
-
-      //Obtains checksum provided from sentence
-      std::string subString = sentence.substr(endPoint);
-      int hexValues = std::stoul(subString, nullptr, baseHex);
-
-      //Calculation of new bitwise checksum, via XOR
-      int checksum = 0;
-      for(int i = 1; i < endPoint - 1; i++) {
-          checksum ^= sentence[i];
+      //Matches "$GP[A-Z]{3},[\\w.,-]*\\*[[:xdigit:]]{2}" without a std::regex, which allocates on every match
+      const std::size_t length = sentence.length();
+      if (length < 10 || sentence.substr(0, 3) != "$GP") {
+          return false;
       }
-      return (checksum == hexValues);
+      if (! isUppercase(sentence[3]) || ! isUppercase(sentence[4]) || ! isUppercase(sentence[5]) || sentence[6] != ',') {
+          return false;
+      }
+      if (sentence[length - 3] != '*' || hexValue(sentence[length - 2]) < 0 || hexValue(sentence[length - 1]) < 0) {
+          return false;
+      }
+      return std::all_of(sentence.begin() + 7, sentence.end() - 3, isFieldCharacter);
   }
 
-  SentenceData parseSentence(std::string sentence)
+  bool checksumMatches(std::string_view sentence)
   {
-      //Creation of string to take sentece format, with: starting position 3 and length of 3 characters
-      std::string sFormat = sentence.substr(3, 3);
-
-      //Creation of vector for Data Fields
-      std::vector<std::string> dataFields;
-      std::string format = "";
-
-      //Loop that pushes fields into vector value
-      //Finds occurance of `,` and end of Data Fields
-      for (unsigned int i =7 ;i <sentence.length() - 2; i++) {
-          char contents = sentence[i];
-          if((contents == ',')|| (contents == '*')){
-              dataFields.push_back(format);
-              format = "";
-          }
-          else {
-              format = format + contents;
+      //The checksum covers the characters between the '$' and the '*'
+      const std::size_t star = sentence.length() - 3;
+      const int high = hexValue(sentence[star + 1]), low = hexValue(sentence[star + 2]);
+      return high >= 0 && low >= 0 && checksumOf(sentence.substr(1, star - 1)) == high * 16 + low;
+  }
+
+
+  SentenceData parseSentence(std::string_view sentence, std::pmr::memory_resource * resource)
+  {
+      //Sentence format taken from starting position 3, with a length of 3 characters
+      SentenceData data{std::pmr::string(sentence.substr(3, 3), resource), std::pmr::vector<std::pmr::string>(resource)};
+
+      //Data fields lie between the first `,` and the `*`, each ended by a `,` or the `*`
+      const std::string_view fields = sentence.substr(7, sentence.length() - 9);
+      data.dataFields.reserve(std::count(fields.begin(), fields.end(), ',') + 1);
+
+      std::size_t fieldStart = 0;
+      for (std::size_t i = 0; i < fields.length(); i++) {
+          if ((fields[i] == ',') || (fields[i] == '*')) {
+              data.dataFields.emplace_back(fields.substr(fieldStart, i - fieldStart));
+              fieldStart = i + 1;
           }
       }
-      return {sFormat, dataFields};
+      return data;
   }
 
-  bool hasCorrectNumberOfFields(SentenceData sentenceData)
+  SentenceArena::SentenceArena(std::pmr::memory_resource * upstream)
+      : arena(buffer, bufferSize, upstream)
+  {}
+
+  std::pmr::memory_resource * SentenceArena::resource()
+  {
+      return &arena;
+  }
+
+  void SentenceArena::release()
+  {
+      arena.release();
+  }
+
+  bool hasCorrectNumberOfFields(const SentenceData & sentenceData)
   {
       int fieldAmount = sentenceData.dataFields.size();
 
@@ -89,7 +108,7 @@ namespace GPS::NMEA
   }
 
 
-  Position positionFromSentenceData(SentenceData d)
+  Position positionFromSentenceData(const SentenceData & d)
   {
       std::string latitude, longitude, northSouth, eastWest, elevation;
       Position p = Position(0,0,0);
@@ -131,36 +150,101 @@ namespace GPS::NMEA
     return p;
   }
 
-  std::vector<Position> readSentences(std::istream & stream)
+  std::optional<double> timeOfDay(const SentenceData & d)
   {
-      std::vector<Position> vector;
-
-      //While loop of file till no sentences are left
-      while (true) {
-          std::string validData;
-          stream >> validData;
-          if (stream.eof()) {
-              break;
+      std::string time;
+      if (d.format == "GLL" && d.dataFields.size() == 5) {
+          time = d.dataFields[4];
+      }
+      else if ((d.format == "GGA" || d.format == "RMC") && ! d.dataFields.empty()) {
+          time = d.dataFields[0];
+      }
+
+      //Splits "hhmmss.sss" into whole seconds and the fraction of a second
+      const std::size_t point = time.find('.');
+      const std::string whole = time.substr(0, point);
+      if (whole.empty() || whole.size() > 6 || whole.find_first_not_of("0123456789") != std::string::npos) {
+          return std::nullopt;
+      }
+      double fraction = 0;
+      if (point != std::string::npos) {
+          const std::string decimals = time.substr(point + 1);
+          if (decimals.find_first_not_of("0123456789") != std::string::npos) {
+              return std::nullopt;
           }
-          if (!validData.length()) {
-              continue;
+          if (! decimals.empty()) {
+              fraction = std::stod("0." + decimals);
           }
+      }
 
-          //Checks line is valid by meeting five conditons
-          try {
-              if(!hasValidSentenceStructure(validData)) {
-                  throw std::invalid_argument("Parameter doesn't conform to the structure of a NMEA sentence");
-              }
-              SentenceData sentence (parseSentence(validData));
+      const int hhmmss = std::stoi(whole);
+      const int hours = hhmmss / 10000;
+      const int minutes = (hhmmss / 100) % 100;
+      const int seconds = hhmmss % 100;
+      if (hours >= 24 || minutes >= 60 || seconds >= 61) {
+          return std::nullopt;
+      }
+      return hours * 3600 + minutes * 60 + seconds + fraction;
+  }
 
-              if((isSupportedFormat(sentence.format))&&(hasValidSentenceStructure(validData))&&(checksumMatches(validData))) {
-                  vector.push_back(positionFromSentenceData(sentence));
+  std::optional<SentenceData> validSentenceData(std::string_view line, std::pmr::memory_resource * resource)
+  {
+      line = trimWhitespace(line);
+
+      //Rejects blank lines and non-sentence lines (e.g. log headers) without parsing them
+      if (line.empty() || line.front() != '$') {
+          return std::nullopt;
+      }
+
+      GPS_NMEA_START_SENTENCE();
+
+      //Checks line is valid by meeting the first four conditons
+      try {
+          if((GPS_NMEA_TIMED(structureCheck, hasValidSentenceStructure(line)))
+             &&(GPS_NMEA_TIMED(checksum, checksumMatches(line)))) {
+              SentenceData sentenceData (GPS_NMEA_TIMED(fieldSplit, parseSentence(line, resource)));
+
+              if(GPS_NMEA_TIMED(fieldCheck, (isSupportedFormat(sentenceData.format))&&(hasCorrectNumberOfFields(sentenceData)))) {
+                  return sentenceData;
               }
           }
-          //Catches inputs that are invalid
-          catch (const std::exception& ) {
+      }
+      //Catches inputs that are invalid
+      catch (const std::exception& ) {
+      }
+      return std::nullopt;
+  }
+
+  std::optional<Position> positionFromSentence(std::string_view line)
+  {
+      //The sentence data is discarded before returning, so the arena is released each time
+      thread_local SentenceArena arena;
+      std::optional<Position> position;
+      {
+          const std::optional<SentenceData> sentenceData = validSentenceData(line, arena.resource());
+
+          //Checks the fifth condition: the neccessary fields contain valid data
+          if (sentenceData) {
+              try {
+                  position = GPS_NMEA_TIMED(positionConstruction, positionFromSentenceData(*sentenceData));
+              }
+              catch (const std::exception& ) {
+              }
           }
       }
-      return vector;
+      arena.release();
+      return position;
+  }
+
+  std::vector<Position> readSentences(std::istream & stream)
+  {
+      PositionRange range(stream);
+      return std::vector<Position>(range.begin(), range.end());
+  }
+
+  std::pmr::vector<Position> readSentences(std::istream & stream, std::pmr::memory_resource * resource)
+  {
+      PositionRange range(stream);
+      return std::pmr::vector<Position>(range.begin(), range.end(), resource);
   }
 }
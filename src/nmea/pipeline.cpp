@@ -0,0 +1,315 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <exception>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <thread>
+
+#include "spsc-queue.h"
+#include "line-reader.h"
+#include "nmea-parser.h"
+#include "pipeline.h"
+
+namespace GPS::NMEA
+{
+  using Clock = std::chrono::steady_clock;
+
+  namespace
+  {
+  struct Block
+  {
+      std::string bytes;
+      Clock::time_point readTime;
+      bool last = false;
+  };
+
+  struct ParsedPosition
+  {
+      std::optional<Position> position;
+      Clock::time_point readTime;
+      bool last = false;
+  };
+
+  class LatencyRecorder
+  {
+    public:
+
+      void record(Clock::duration d)
+      {
+          ++count;
+          total += d;
+          longest = std::max(longest, d);
+      }
+
+      StageMetrics stageMetrics() const
+      {
+          StageMetrics metrics;
+          metrics.itemsProcessed = count;
+          metrics.busySeconds = std::chrono::duration<double>(total).count();
+          metrics.meanLatencyMicroseconds = count ? microseconds(total) / count : 0;
+          metrics.maxLatencyMicroseconds = microseconds(longest);
+          return metrics;
+      }
+
+      double meanMicroseconds() const { return count ? microseconds(total) / count : 0; }
+      double maxMicroseconds() const { return microseconds(longest); }
+
+    private:
+
+      static double microseconds(Clock::duration d) { return std::chrono::duration<double,std::micro>(d).count(); }
+
+      std::uint64_t count = 0;
+      Clock::duration total{0};
+      Clock::duration longest{0};
+  };
+
+  template <typename T>
+  class MonitoredQueue
+  {
+    public:
+
+      explicit MonitoredQueue(std::size_t capacity) : queue(capacity) {}
+
+      // Producer only.  Waits while the queue is full; gives up if the pipeline is cancelled.
+      void push(T & item, const std::atomic<bool> & cancelled)
+      {
+          const std::size_t depth = queue.size();
+          ++pushes;
+          depthTotal += depth;
+          maxDepth = std::max(maxDepth, depth);
+
+          if (! queue.tryPush(item))
+          {
+              ++fullWaits;
+              if (! waitUntil([&]{ return queue.tryPush(item); }, cancelled)) return;
+          }
+          wakeWaiter();
+      }
+
+      // Consumer only.  Waits while the queue is empty; fails if the pipeline is cancelled.
+      bool pop(T & item, const std::atomic<bool> & cancelled)
+      {
+          if (! queue.tryPop(item) && ! waitUntil([&]{ return queue.tryPop(item); }, cancelled)) return false;
+          wakeWaiter();
+          return true;
+      }
+
+      // Wakes a stage waiting on this queue, once the pipeline has been cancelled.
+      void interrupt()
+      {
+          std::lock_guard<std::mutex> lock(mutex);
+          wakeup.notify_all();
+      }
+
+      QueueMetrics queueMetrics() const
+      {
+          QueueMetrics metrics;
+          metrics.capacity = queue.capacity();
+          metrics.maxDepth = maxDepth;
+          metrics.meanDepth = pushes ? static_cast<double>(depthTotal) / pushes : 0;
+          metrics.fullWaits = fullWaits;
+          return metrics;
+      }
+
+    private:
+
+      // Yields this many times before going to sleep, so a briefly idle stage stays responsive.
+      static constexpr int spinLimit = 64;
+
+      /* Waits until ready() succeeds, spinning briefly and then sleeping until the other
+       * side of the queue wakes this side.  Returns false if the pipeline is cancelled first.
+       */
+      template <typename Ready>
+      bool waitUntil(Ready ready, const std::atomic<bool> & cancelled)
+      {
+          for (int spin = 0; spin < spinLimit; ++spin)
+          {
+              if (cancelled) return false;
+              std::this_thread::yield();
+              if (ready()) return true;
+          }
+
+          std::unique_lock<std::mutex> lock(mutex);
+          waiters.fetch_add(1);
+          // Pairs with the fence in wakeWaiter(): either ready() sees the other side's
+          // change to the queue, or the other side sees this waiter and wakes it.
+          std::atomic_thread_fence(std::memory_order_seq_cst);
+          bool succeeded = false;
+          wakeup.wait(lock, [&]
+          {
+              succeeded = ready();
+              return succeeded || cancelled;
+          });
+          waiters.fetch_sub(1);
+          return succeeded;
+      }
+
+      // Called after every push or pop, which may have unblocked the other side.
+      void wakeWaiter()
+      {
+          std::atomic_thread_fence(std::memory_order_seq_cst);
+          if (waiters.load(std::memory_order_relaxed) > 0)
+          {
+              std::lock_guard<std::mutex> lock(mutex);
+              wakeup.notify_all();
+          }
+      }
+
+      SpscQueue<T> queue;
+
+      // For a stage that has stopped spinning and is asleep.
+      std::mutex mutex;
+      std::condition_variable wakeup;
+      std::atomic<int> waiters{0};
+
+      // Only updated by the producer.
+      std::uint64_t pushes = 0;
+      std::uint64_t depthTotal = 0;
+      std::size_t maxDepth = 0;
+      std::uint64_t fullWaits = 0;
+  };
+
+  /* Reads up to 'blockSize' bytes: whatever the stream can supply without waiting, or, if
+   * nothing is available yet, the bytes up to the end of the next line as they arrive.  So
+   * a live source is passed on a sentence at a time, rather than held back until a whole
+   * block has accumulated.  Returns an empty block at the end of the stream.
+   */
+  void readBlock(std::istream & stream, std::string & bytes, std::size_t blockSize)
+  {
+      bytes.resize(blockSize);
+      std::size_t count = 0;
+      while (count < blockSize)
+      {
+          const std::streamsize available = stream.readsome(&bytes[count], blockSize - count);
+          if (available <= 0) break;
+          count += available;
+      }
+
+      if (count == 0)
+      {
+          std::istream::int_type c;
+          while (count < blockSize && (c = stream.get()) != std::istream::traits_type::eof())
+          {
+              bytes[count++] = static_cast<char>(c);
+              if (c == '\n') break;
+          }
+      }
+      bytes.resize(count);
+  }
+  }
+
+  PipelineMetrics runPipeline(std::istream & stream,
+                              std::function<void(const Position &)> consumer,
+                              PipelineOptions options)
+  {
+      const Clock::time_point startTime = Clock::now();
+
+      MonitoredQueue<Block> blocks(options.blockQueueCapacity);
+      MonitoredQueue<ParsedPosition> positions(options.positionQueueCapacity);
+      std::atomic<bool> cancelled{false};
+      LatencyRecorder readerLatency, parserLatency, consumerLatency, endToEndLatency;
+
+      auto cancel = [&]
+      {
+          cancelled = true;
+          blocks.interrupt();
+          positions.interrupt();
+      };
+
+      std::exception_ptr readerError;
+      std::thread reader([&]
+      {
+          try
+          {
+              while (! cancelled)
+              {
+                  Block block;
+                  const Clock::time_point start = Clock::now();
+                  readBlock(stream, block.bytes, options.blockSize);
+                  block.readTime = Clock::now();
+
+                  if (block.bytes.empty()) break;
+                  readerLatency.record(block.readTime - start);
+                  blocks.push(block, cancelled);
+              }
+          }
+          catch (...)
+          {
+              readerError = std::current_exception();
+              cancel();
+          }
+          Block endMarker;
+          endMarker.last = true;
+          blocks.push(endMarker, cancelled);
+      });
+
+      std::thread parser([&]
+      {
+          LineSplitter splitter;
+          Block block;
+          Clock::time_point readTime;
+
+          auto parseLine = [&](std::string_view line)
+          {
+              const Clock::time_point start = Clock::now();
+              ParsedPosition item;
+              item.position = positionFromSentence(line);
+              item.readTime = readTime;
+              parserLatency.record(Clock::now() - start);
+
+              if (item.position) positions.push(item, cancelled);
+          };
+
+          while (blocks.pop(block, cancelled) && ! block.last)
+          {
+              readTime = block.readTime;
+              splitter.feed(block.bytes, parseLine);
+          }
+          splitter.finish(parseLine);
+
+          ParsedPosition endMarker;
+          endMarker.last = true;
+          positions.push(endMarker, cancelled);
+      });
+
+      std::exception_ptr consumerError;
+      try
+      {
+          ParsedPosition item;
+          while (positions.pop(item, cancelled) && ! item.last)
+          {
+              const Clock::time_point start = Clock::now();
+              consumer(*item.position);
+              const Clock::time_point finish = Clock::now();
+              consumerLatency.record(finish - start);
+              endToEndLatency.record(finish - item.readTime);
+          }
+      }
+      catch (...)
+      {
+          consumerError = std::current_exception();
+          cancel();
+      }
+
+      reader.join();
+      parser.join();
+
+      if (consumerError) std::rethrow_exception(consumerError);
+      if (readerError) std::rethrow_exception(readerError);
+
+      PipelineMetrics metrics;
+      metrics.reader = readerLatency.stageMetrics();
+      metrics.parser = parserLatency.stageMetrics();
+      metrics.consumer = consumerLatency.stageMetrics();
+      metrics.blockQueue = blocks.queueMetrics();
+      metrics.positionQueue = positions.queueMetrics();
+      metrics.meanEndToEndMicroseconds = endToEndLatency.meanMicroseconds();
+      metrics.maxEndToEndMicroseconds = endToEndLatency.maxMicroseconds();
+      metrics.elapsedSeconds = std::chrono::duration<double>(Clock::now() - startTime).count();
+      return metrics;
+  }
+}
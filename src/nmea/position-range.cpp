@@ -0,0 +1,44 @@
+#include <string_view>
+
+#include "nmea-parser.h"
+#include "position-range.h"
+
+namespace GPS::NMEA
+{
+  PositionRange::PositionRange(std::istream & stream)
+      : lines(stream)
+  {}
+
+  PositionRange::iterator PositionRange::begin()
+  {
+      if (! started)
+      {
+          started = true;
+          readNext();
+      }
+      return iterator(this);
+  }
+
+  PositionRange::iterator PositionRange::end()
+  {
+      return iterator();
+  }
+
+  void PositionRange::readNext()
+  {
+      current.reset();
+      std::string_view line;
+
+      while (lines.nextLine(line)) {
+          current = positionFromSentence(line);
+          if (current) {
+              return;
+          }
+      }
+  }
+
+  PositionRange positions(std::istream & stream)
+  {
+      return PositionRange(stream);
+  }
+}
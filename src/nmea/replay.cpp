@@ -0,0 +1,173 @@
+#include <algorithm>
+#include <cerrno>
+#include <iterator>
+#include <optional>
+#include <stdexcept>
+#include <string_view>
+#include <system_error>
+#include <thread>
+
+#include <poll.h>
+#include <unistd.h>
+
+#include "line-reader.h"
+#include "nmea-parser.h"
+#include "replay.h"
+
+namespace GPS::NMEA
+{
+  namespace
+  {
+      const double secondsPerDay = 24 * 3600;
+
+      std::int64_t steadyNanoseconds(std::chrono::steady_clock::time_point time)
+      {
+          return std::chrono::duration_cast<std::chrono::nanoseconds>(time.time_since_epoch()).count();
+      }
+  }
+
+  LogReplayer::LogReplayer(std::istream & log)
+  {
+      // Keep the raw bytes, so that each line is replayed with its original terminator.
+      text.assign(std::istreambuf_iterator<char>(log), std::istreambuf_iterator<char>());
+
+      std::vector<std::optional<double>> times;
+      const std::string_view all = text;
+      std::size_t offset = 0;
+      while (offset < all.size())
+      {
+          const std::size_t newline = all.find('\n', offset);
+          const std::size_t end = (newline == std::string_view::npos) ? all.size() : newline + 1;
+
+          std::string_view line = all.substr(offset, end - offset);
+          if (line.back() == '\n') line.remove_suffix(1);
+          if (! line.empty() && line.back() == '\r') line.remove_suffix(1);
+
+          const bool valid = positionFromSentence(line).has_value();
+          lines.push_back({offset, end - offset, valid, 0});
+          times.push_back(valid ? timeOfDay(parseSentence(std::string(trimWhitespace(line)))) : std::nullopt);
+          if (valid) ++validCount;
+          offset = end;
+      }
+
+      // Lines before the first recorded time take that time.
+      auto firstTime = std::find_if(times.begin(), times.end(), [](const auto & t) { return t.has_value(); });
+      double previous = (firstTime != times.end()) ? **firstTime : 0;
+      double dayOffset = 0;
+      for (std::size_t i = 0; i < lines.size(); ++i)
+      {
+          if (times[i])
+          {
+              if (*times[i] + dayOffset < previous - secondsPerDay / 2) dayOffset += secondsPerDay;
+              previous = *times[i] + dayOffset;
+          }
+          lines[i].recordedSeconds = previous;
+      }
+
+      writeTimes = std::make_unique<std::atomic<std::int64_t>[]>(validCount);
+  }
+
+  std::size_t LogReplayer::lineCount() const
+  {
+      return lines.size();
+  }
+
+  std::size_t LogReplayer::validSentenceCount() const
+  {
+      return validCount;
+  }
+
+  double LogReplayer::recordedDurationSeconds() const
+  {
+      return lines.empty() ? 0 : lines.back().recordedSeconds - lines.front().recordedSeconds;
+  }
+
+  std::vector<std::chrono::nanoseconds> LogReplayer::schedule(const ReplayOptions & options) const
+  {
+      using seconds = std::chrono::duration<double>;
+
+      std::vector<std::chrono::nanoseconds> times(lines.size());
+      switch (options.pace)
+      {
+          case ReplayOptions::Pace::recorded:
+              if (! (options.speedFactor > 0)) throw std::invalid_argument("The speed factor must be positive.");
+              for (std::size_t i = 0; i < lines.size(); ++i)
+              {
+                  const double offset = (lines[i].recordedSeconds - lines.front().recordedSeconds) / options.speedFactor;
+                  times[i] = std::chrono::duration_cast<std::chrono::nanoseconds>(seconds(offset));
+              }
+              break;
+
+          case ReplayOptions::Pace::fixedRate:
+              if (! (options.sentencesPerSecond > 0)) throw std::invalid_argument("The rate must be positive.");
+              for (std::size_t i = 0; i < lines.size(); ++i)
+              {
+                  times[i] = std::chrono::duration_cast<std::chrono::nanoseconds>(seconds(i / options.sentencesPerSecond));
+              }
+              break;
+
+          case ReplayOptions::Pace::unthrottled:
+              break;
+      }
+      return times;
+  }
+
+  ReplayStatistics LogReplayer::replay(int fd, const ReplayOptions & options)
+  {
+      const std::vector<std::chrono::nanoseconds> times = schedule(options);
+
+      ReplayStatistics stats;
+      std::size_t validIndex = 0;
+      const auto start = std::chrono::steady_clock::now();
+      for (std::size_t i = 0; i < lines.size(); ++i)
+      {
+          const auto due = start + times[i];
+          if (std::chrono::steady_clock::now() < due) std::this_thread::sleep_until(due);
+
+          const auto now = std::chrono::steady_clock::now();
+          stats.maxLagSeconds = std::max(stats.maxLagSeconds, std::chrono::duration<double>(now - due).count());
+
+          const Line & line = lines[i];
+          if (line.valid) writeTimes[validIndex++].store(steadyNanoseconds(now), std::memory_order_release);
+          writeAll(fd, text.data() + line.offset, line.length);
+
+          ++stats.linesWritten;
+          stats.bytesWritten += line.length;
+      }
+      stats.elapsedSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+      return stats;
+  }
+
+  std::chrono::nanoseconds LogReplayer::latencyOf(std::size_t validSentenceIndex) const
+  {
+      if (validSentenceIndex >= validCount)
+      {
+          throw std::out_of_range("No such valid sentence: " + std::to_string(validSentenceIndex));
+      }
+      const std::int64_t written = writeTimes[validSentenceIndex].load(std::memory_order_acquire);
+      return std::chrono::nanoseconds(steadyNanoseconds(std::chrono::steady_clock::now()) - written);
+  }
+
+  void LogReplayer::writeAll(int fd, const char * data, std::size_t length)
+  {
+      while (length > 0)
+      {
+          const ssize_t written = ::write(fd, data, length);
+          if (written >= 0)
+          {
+              data += written;
+              length -= written;
+          }
+          else if (errno == EAGAIN || errno == EWOULDBLOCK)
+          {
+              // A non-blocking descriptor is full: wait for the consumer to catch up.
+              pollfd writable = {fd, POLLOUT, 0};
+              ::poll(&writable, 1, -1);
+          }
+          else if (errno != EINTR)
+          {
+              throw std::system_error(errno, std::generic_category(), "write");
+          }
+      }
+  }
+}
@@ -0,0 +1,142 @@
+#include <algorithm>
+#include <cstring>
+#include <optional>
+#include <string>
+
+#include "nmea-parser.h"
+#include "sentence-scanner.h"
+
+namespace GPS::NMEA
+{
+  namespace
+  {
+      void appendPositions(SentenceScanner & scanner, std::vector<Position> & positions)
+      {
+          std::string_view sentence;
+          while (scanner.nextSentence(sentence))
+          {
+              if (std::optional<Position> position = positionFromSentence(sentence))
+              {
+                  positions.push_back(*position);
+              }
+          }
+      }
+  }
+
+  SentenceScanner::SentenceScanner(std::string_view buffer)
+      : buffer(buffer)
+  {}
+
+  bool SentenceScanner::nextSentence(std::string_view & sentence)
+  {
+      while (position < buffer.size())
+      {
+          const void * dollar = std::memchr(buffer.data() + position, '$', buffer.size() - position);
+          if (dollar == nullptr) break;
+
+          const std::size_t start = static_cast<const char*>(dollar) - buffer.data();
+          std::size_t length = 0;
+          switch (candidateAt(start, length))
+          {
+              case Candidate::accepted:
+                  position = start + length;
+                  sentence = buffer.substr(start, length);
+                  return true;
+
+              case Candidate::rejected:
+                  position = start + 1;
+                  break;
+
+              case Candidate::incomplete:
+                  position = buffer.size();
+                  resume = start;
+                  return false;
+          }
+      }
+      position = buffer.size();
+      resume = buffer.size();
+      return false;
+  }
+
+  std::size_t SentenceScanner::resumeOffset() const
+  {
+      return resume;
+  }
+
+  SentenceScanner::Candidate SentenceScanner::candidateAt(std::size_t start, std::size_t & length) const
+  {
+      const char * s = buffer.data() + start;
+      const std::size_t available = std::min(buffer.size() - start, maxSentenceLength);
+      const auto outOfData = [&]
+      {
+          return available < buffer.size() - start ? Candidate::rejected : Candidate::incomplete;
+      };
+
+      // "$GP", the three letters of the format, and the first ','.
+      static const char prefix[] = "$GP";
+      for (std::size_t i = 0; i < 7; ++i)
+      {
+          if (i == available) return outOfData();
+          const char c = s[i];
+          const bool matches = i < 3 ? c == prefix[i] : i < 6 ? (c >= 'A' && c <= 'Z') : c == ',';
+          if (! matches) return Candidate::rejected;
+      }
+
+      // The fields, accumulating the checksum of everything between the '$' and the '*'.
+      unsigned char checksum = 0;
+      for (std::size_t i = 1; i < 7; ++i) checksum ^= static_cast<unsigned char>(s[i]);
+      std::size_t i = 7;
+      while (i < available && fieldCharacters[static_cast<unsigned char>(s[i])])
+      {
+          checksum ^= static_cast<unsigned char>(s[i]);
+          ++i;
+      }
+
+      if (i + 3 > available)
+      {
+          // Cut off by the end of the data, unless something other than a field or the '*' came first.
+          for (std::size_t j = i; j < available; ++j)
+          {
+              if ((j == i && s[j] != '*') || (j > i && hexValue(s[j]) < 0)) return Candidate::rejected;
+          }
+          return outOfData();
+      }
+      if (s[i] != '*') return Candidate::rejected;
+
+      const int high = hexValue(s[i+1]), low = hexValue(s[i+2]);
+      if (high < 0 || low < 0 || checksum != high * 16 + low) return Candidate::rejected;
+
+      length = i + 3;
+      return Candidate::accepted;
+  }
+
+  std::vector<Position> scanSentences(std::string_view buffer)
+  {
+      std::vector<Position> positions;
+      SentenceScanner scanner(buffer);
+      appendPositions(scanner, positions);
+      return positions;
+  }
+
+  std::vector<Position> scanSentences(std::istream & stream, std::size_t blockSize)
+  {
+      if (blockSize == 0) blockSize = 64 * 1024;
+
+      std::vector<Position> positions;
+      std::string buffer;
+      while (stream)
+      {
+          const std::size_t kept = buffer.size();
+          buffer.resize(kept + blockSize);
+          stream.read(&buffer[kept], blockSize);
+          buffer.resize(kept + stream.gcount());
+
+          SentenceScanner scanner(buffer);
+          appendPositions(scanner, positions);
+
+          // Keep only a candidate that was cut off, to be completed by the next block.
+          buffer.erase(0, scanner.resumeOffset());
+      }
+      return positions;
+  }
+}
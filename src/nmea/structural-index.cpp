@@ -0,0 +1,181 @@
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+#include "line-reader.h"
+#include "nmea-parser.h"
+#include "structural-index.h"
+
+namespace GPS::NMEA
+{
+  namespace
+  {
+      const std::size_t blockSize = 64;
+
+      bool isStructural(char c)
+      {
+          return c == '$' || c == ',' || c == '*' || c == '\n';
+      }
+
+      // Bit 'i' is set if byte 'i' of the 64-byte block is a structural character.
+      std::uint64_t structuralMask(const char * block)
+      {
+#if defined(__SSE2__)
+          const __m128i dollar = _mm_set1_epi8('$');
+          const __m128i comma = _mm_set1_epi8(',');
+          const __m128i star = _mm_set1_epi8('*');
+          const __m128i newline = _mm_set1_epi8('\n');
+
+          std::uint64_t mask = 0;
+          for (int k = 0; k < 4; ++k)
+          {
+              const __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i *>(block + 16 * k));
+              const __m128i matches = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(bytes, dollar), _mm_cmpeq_epi8(bytes, comma)),
+                                                   _mm_or_si128(_mm_cmpeq_epi8(bytes, star), _mm_cmpeq_epi8(bytes, newline)));
+              mask |= std::uint64_t(static_cast<unsigned int>(_mm_movemask_epi8(matches))) << (16 * k);
+          }
+          return mask;
+#else
+          std::uint64_t mask = 0;
+          for (std::size_t i = 0; i < blockSize; ++i) mask |= std::uint64_t(isStructural(block[i])) << i;
+          return mask;
+#endif
+      }
+
+      void flatten(std::uint64_t mask, std::uint32_t base, std::vector<std::uint32_t> & offsets)
+      {
+          while (mask != 0)
+          {
+              offsets.push_back(base + __builtin_ctzll(mask));
+              mask &= mask - 1;
+          }
+      }
+
+      void checkSize(std::string_view buffer)
+      {
+          if (buffer.size() > std::numeric_limits<std::uint32_t>::max())
+          {
+              throw std::invalid_argument("Cannot index a buffer of 4GiB or more.");
+          }
+      }
+
+      bool isUppercase(char c)
+      {
+          return c >= 'A' && c <= 'Z';
+      }
+
+      /* The sentence data of the line [begin,end) whose structural characters are offsets
+       * [first,last) of the index, if it meets the first four conditions for a valid sentence.
+       */
+      std::optional<SentenceData> indexedSentenceData(std::string_view buffer, std::size_t begin, std::size_t end,
+                                                      const std::vector<std::uint32_t> & index,
+                                                      std::size_t first, std::size_t last,
+                                                      std::pmr::memory_resource * resource)
+      {
+          // Leading and trailing whitespace contains no structural characters.
+          const std::string_view line = trimWhitespace(buffer.substr(begin, end - begin));
+          if (! line.empty()) begin = line.data() - buffer.data();
+          end = begin + line.size();
+
+          // The structure: "$GP", the format, the first ',', and the '*' before the checksum.
+          const char * s = buffer.data();
+          if (end - begin < 10 || last - first < 3) return std::nullopt;
+          if (index[first] != begin || s[begin] != '$' || index[last-1] != end - 3 || s[end-3] != '*') return std::nullopt;
+          if (index[first+1] != begin + 6 || s[begin+6] != ',') return std::nullopt;
+          if (s[begin+1] != 'G' || s[begin+2] != 'P') return std::nullopt;
+          if (! isUppercase(s[begin+3]) || ! isUppercase(s[begin+4]) || ! isUppercase(s[begin+5])) return std::nullopt;
+
+          // The characters between the structural ones, and the checksum, without branching per character.
+          bool fieldsValid = true;
+          for (std::size_t i = begin + 7; i < end - 3; ++i) fieldsValid &= fieldCharacters[static_cast<unsigned char>(s[i])];
+          const unsigned char checksum = checksumOf(buffer.substr(begin + 1, end - 4 - begin));
+          const int high = hexValue(s[end-2]), low = hexValue(s[end-1]);
+          if (! fieldsValid || high < 0 || low < 0 || checksum != high * 16 + low) return std::nullopt;
+
+          // The fields lie between consecutive structural characters, from the first ',' to the '*'.
+          SentenceData data{std::pmr::string(buffer.substr(begin + 3, 3), resource), std::pmr::vector<std::pmr::string>(resource)};
+          data.dataFields.reserve(last - first - 2);
+          for (std::size_t j = first + 1; j + 1 < last; ++j)
+          {
+              data.dataFields.emplace_back(buffer.substr(index[j] + 1, index[j+1] - index[j] - 1));
+          }
+
+          if (! isSupportedFormat(data.format) || ! hasCorrectNumberOfFields(data)) return std::nullopt;
+          return data;
+      }
+  }
+
+  std::vector<std::uint32_t> structuralIndex(std::string_view buffer)
+  {
+      checkSize(buffer);
+
+      std::vector<std::uint32_t> offsets;
+      offsets.reserve(buffer.size() / 8);
+
+      std::size_t i = 0;
+      for (; i + blockSize <= buffer.size(); i += blockSize)
+      {
+          flatten(structuralMask(buffer.data() + i), i, offsets);
+      }
+
+      // The last partial block, padded with zero bytes, which are not structural.
+      if (i < buffer.size())
+      {
+          char block[blockSize] = {};
+          std::memcpy(block, buffer.data() + i, buffer.size() - i);
+          flatten(structuralMask(block), i, offsets);
+      }
+      return offsets;
+  }
+
+  std::vector<std::uint32_t> structuralIndexScalar(std::string_view buffer)
+  {
+      checkSize(buffer);
+
+      std::vector<std::uint32_t> offsets;
+      for (std::size_t i = 0; i < buffer.size(); ++i)
+      {
+          if (isStructural(buffer[i])) offsets.push_back(i);
+      }
+      return offsets;
+  }
+
+  std::vector<Position> readSentencesIndexed(std::string_view buffer)
+  {
+      const std::vector<std::uint32_t> index = structuralIndex(buffer);
+
+      std::vector<Position> positions;
+      SentenceArena arena;
+      std::size_t lineStart = 0;
+      std::size_t first = 0;
+      while (lineStart < buffer.size())
+      {
+          // The structural characters of this line, up to its '\n' (if any).
+          std::size_t last = first;
+          while (last < index.size() && buffer[index[last]] != '\n') ++last;
+          const std::size_t lineEnd = last < index.size() ? index[last] : buffer.size();
+
+          {
+              const std::optional<SentenceData> sentenceData =
+                  indexedSentenceData(buffer, lineStart, lineEnd, index, first, last, arena.resource());
+              if (sentenceData)
+              {
+                  try {
+                      positions.push_back(positionFromSentenceData(*sentenceData));
+                  }
+                  catch (const std::exception& ) {
+                  }
+              }
+          }
+          arena.release();
+
+          first = last + 1;
+          lineStart = lineEnd + 1;
+      }
+      return positions;
+  }
+}
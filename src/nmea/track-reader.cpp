@@ -0,0 +1,76 @@
+#include <optional>
+#include <stdexcept>
+#include <string_view>
+
+#include "line-reader.h"
+#include "nmea-parser.h"
+#include "track-reader.h"
+
+namespace GPS::NMEA
+{
+  namespace
+  {
+      const double secondsPerDay = 24 * 60 * 60;
+
+      /* Calls onFix(Position, time) for each valid sentence with a time, in order, with
+       * the times continuing across midnight.
+       */
+      template <typename Function>
+      void readFixes(std::istream & stream, Function onFix)
+      {
+          LineReader lines(stream);
+          std::string_view line;
+          double dayStart = 0;
+          std::optional<double> previousTime;
+          SentenceArena arena;
+
+          while (lines.nextLine(line))
+          {
+              // The previous line's sentence data has gone out of scope.
+              arena.release();
+              const std::optional<SentenceData> sentenceData = validSentenceData(line, arena.resource());
+              if (! sentenceData) continue;
+
+              const std::optional<double> time = timeOfDay(*sentenceData);
+              if (! time) continue;
+
+              std::optional<Position> position;
+              try {
+                  position = positionFromSentenceData(*sentenceData);
+              }
+              catch (const std::exception& ) {
+                  continue;
+              }
+
+              double fixTime = dayStart + *time;
+              if (previousTime && fixTime < *previousTime - secondsPerDay / 2)
+              {
+                  dayStart += secondsPerDay;
+                  fixTime += secondsPerDay;
+              }
+              if (previousTime && fixTime < *previousTime) continue;
+
+              previousTime = fixTime;
+              onFix(*position, fixTime);
+          }
+      }
+  }
+
+  Track readTrack(std::istream & stream)
+  {
+      Track track;
+      readFixes(stream, [&track](const Position & p, double time) { track.append(p, time); });
+      return track;
+  }
+
+  Track readTrack(std::istream & stream, FixFilter & filter)
+  {
+      Track track;
+      readFixes(stream, [&](const Position & p, double time)
+      {
+          const std::optional<Position> filtered = filter.add(p, time);
+          if (filtered) track.append(*filtered, time);
+      });
+      return track;
+  }
+}
@@ -0,0 +1,105 @@
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <string_view>
+
+#include "thread-pool.h"
+#include "compressed-input.h"
+#include "line-reader.h"
+#include "nmea-parser.h"
+#include "track-statistics-reader.h"
+
+namespace GPS::NMEA
+{
+  namespace
+  {
+      /* The statistics of the lines that start in the byte range [begin,end) of a file.
+       * A line that starts before 'begin' belongs to the previous chunk, and a line that
+       * starts before 'end' is read to its end, even if that is beyond 'end'.
+       */
+      TrackStatistics readChunk(const std::string & filepath, std::uintmax_t begin, std::uintmax_t end)
+      {
+          std::ifstream file(filepath, std::ios::binary);
+          if (! file.is_open())
+          {
+              throw std::invalid_argument("Could not open file: " + filepath);
+          }
+
+          std::uintmax_t lineStart = begin;
+          std::string line;
+          if (begin > 0)
+          {
+              // Skip the rest of a line that started in the previous chunk.
+              file.seekg(begin - 1);
+              if (file.get() != '\n')
+              {
+                  std::getline(file, line);
+                  lineStart += line.size() + 1;
+              }
+          }
+
+          TrackStatistics statistics;
+          while (lineStart < end && std::getline(file, line))
+          {
+              lineStart += line.size() + 1;
+              const std::optional<Position> position = positionFromSentence(line);
+              if (position) statistics.add(*position);
+          }
+          return statistics;
+      }
+  }
+
+  TrackStatistics readTrackStatistics(std::istream & stream)
+  {
+      TrackStatistics statistics;
+      LineReader lines(stream);
+      std::string_view line;
+      while (lines.nextLine(line))
+      {
+          const std::optional<Position> position = positionFromSentence(line);
+          if (position) statistics.add(*position);
+      }
+      return statistics;
+  }
+
+  TrackStatistics readTrackStatisticsFromFile(std::string filepath, unsigned int threadCount, std::size_t chunkSize)
+  {
+      const Compression compression = detectCompression(filepath);
+
+      if (compression != Compression::none)
+      {
+          std::ifstream file(filepath, std::ios::binary);
+          if (! file.is_open())
+          {
+              throw std::invalid_argument("Could not open file: " + filepath);
+          }
+          DecompressingStreamBuf buffer(file, compression);
+          std::istream decompressed(&buffer);
+          TrackStatistics statistics = readTrackStatistics(decompressed);
+          buffer.checkForErrors();
+          return statistics;
+      }
+
+      const std::uintmax_t fileSize = std::filesystem::file_size(filepath);
+      const std::uintmax_t chunkCount = std::max<std::uintmax_t>(1, (fileSize + chunkSize - 1) / std::max<std::size_t>(1, chunkSize));
+      if (chunkCount == 1) return readChunk(filepath, 0, fileSize);
+
+      // Each task writes only to its own pre-allocated result.
+      std::vector<TrackStatistics> chunks(chunkCount);
+      {
+          ThreadPool pool(threadCount);
+          for (std::uintmax_t i = 0; i < chunkCount; ++i)
+          {
+              const std::uintmax_t begin = fileSize * i / chunkCount;
+              const std::uintmax_t end = fileSize * (i + 1) / chunkCount;
+              pool.submit([&filepath, &chunks, i, begin, end]{ chunks[i] = readChunk(filepath, begin, end); });
+          }
+          pool.wait();
+      }
+
+      TrackStatistics statistics;
+      for (const TrackStatistics & chunk : chunks) statistics.merge(chunk);
+      return statistics;
+  }
+}
@@ -9,17 +9,14 @@
 
 namespace GPS
 {
-  Position::Position(degrees lat, degrees lon, metres ele)
+  void Position::throwInvalidLatitude()
   {
-      if (! isValidLatitude(lat))
-          throw std::invalid_argument("Latitude values must not exceed " + std::to_string(poleLatitude) + " degrees.");
-
-      if (! isValidLongitude(lon))
-          throw std::invalid_argument("Longitude values must not exceed " + std::to_string(antiMeridianLongitude) + " degrees.");
+      throw std::invalid_argument("Latitude values must not exceed " + std::to_string(poleLatitude) + " degrees.");
+  }
 
-      this->lat = lat;
-      this->lon = lon;
-      this->ele = ele;
+  void Position::throwInvalidLongitude()
+  {
+      throw std::invalid_argument("Longitude values must not exceed " + std::to_string(antiMeridianLongitude) + " degrees.");
   }
 
   Position::Position(std::string ddmLatStr, char latBearing,
@@ -49,21 +46,6 @@ namespace GPS
 
   }
 
-  degrees Position::latitude() const
-  {
-      return lat;
-  }
-
-  degrees Position::longitude() const
-  {
-      return lon;
-  }
-
-  metres Position::elevation() const
-  {
-      return ele;
-  }
-
   metres Position::horizontalDistanceBetween(Position p1, Position p2)
   /*
    * See: https://en.wikipedia.org/wiki/Haversine_formula
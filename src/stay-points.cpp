@@ -0,0 +1,86 @@
+#include <stdexcept>
+#include <string>
+
+#include "geometry.h"
+#include "stay-points.h"
+
+namespace GPS
+{
+  StayPointDetector::StayPointDetector(metres maxDistance, double minDuration)
+      : maxDistance(maxDistance),
+        minDuration(minDuration)
+  {
+      if (! (maxDistance > 0))
+          throw std::invalid_argument("The stay point distance must be positive.");
+
+      if (! (minDuration >= 0))
+          throw std::invalid_argument("The stay point duration must not be negative.");
+  }
+
+  std::optional<StayPoint> StayPointDetector::add(const Position & p, double time)
+  {
+      if (! fixes.empty() && time < fixes.back().time)
+          throw std::invalid_argument("Fix times must not decrease: " + std::to_string(time) + " follows " + std::to_string(fixes.back().time) + ".");
+
+      fixes.push_back({p, time});
+      if (Position::horizontalDistanceBetween(fixes.front().position, p) <= maxDistance)
+          return std::nullopt;
+
+      // The run from the first fix ends before this fix, which starts the next run.
+      std::optional<StayPoint> found;
+      const std::size_t runLength = fixes.size() - 1;
+      if (fixes[runLength - 1].time - fixes.front().time >= minDuration)
+      {
+          found = stayPoint(runLength);
+      }
+      fixes.erase(fixes.begin(), fixes.begin() + runLength);
+      return found;
+  }
+
+  std::optional<StayPoint> StayPointDetector::finish()
+  {
+      std::optional<StayPoint> found;
+      if (! fixes.empty() && fixes.back().time - fixes.front().time >= minDuration)
+      {
+          found = stayPoint(fixes.size());
+      }
+      fixes.clear();
+      return found;
+  }
+
+  StayPoint StayPointDetector::stayPoint(std::size_t fixCount) const
+  {
+      // Longitudes are averaged relative to the first fix, so stays on the anti-meridian work.
+      const Position & first = fixes.front().position;
+      degrees latitudeSum = 0;
+      degrees longitudeOffsetSum = 0;
+      metres elevationSum = 0;
+      for (std::size_t i = 0; i < fixCount; ++i)
+      {
+          const Position & p = fixes[i].position;
+          latitudeSum += p.latitude();
+          longitudeOffsetSum += normaliseDegrees(p.longitude() - first.longitude());
+          elevationSum += p.elevation();
+      }
+
+      const Position centre(latitudeSum / fixCount,
+                            normaliseDegrees(first.longitude() + longitudeOffsetSum / fixCount),
+                            elevationSum / fixCount);
+      return {centre, fixes.front().time, fixes[fixCount - 1].time, fixCount};
+  }
+
+  std::vector<StayPoint> findStayPoints(const Track & track, metres maxDistance, double minDuration)
+  {
+      StayPointDetector detector(maxDistance, minDuration);
+      std::vector<StayPoint> stayPoints;
+      for (std::size_t i = 0; i < track.size(); ++i)
+      {
+          std::optional<StayPoint> stayPoint = detector.add(track.position(i), track.time(i));
+          if (stayPoint) stayPoints.push_back(*stayPoint);
+      }
+
+      std::optional<StayPoint> last = detector.finish();
+      if (last) stayPoints.push_back(*last);
+      return stayPoints;
+  }
+}
@@ -0,0 +1,133 @@
+#include <algorithm>
+#include <utility>
+
+#include "thread-pool.h"
+
+namespace GPS
+{
+  ThreadPool::ThreadPool(unsigned int threadCount)
+  {
+      if (threadCount == 0)
+      {
+          threadCount = std::max(1u, std::thread::hardware_concurrency());
+      }
+
+      for (unsigned int i = 0; i < threadCount; ++i)
+      {
+          queues.push_back(std::make_unique<WorkerQueue>());
+      }
+
+      for (unsigned int i = 0; i < threadCount; ++i)
+      {
+          workers.emplace_back(&ThreadPool::workerLoop, this, i);
+      }
+  }
+
+  ThreadPool::~ThreadPool()
+  {
+      {
+          std::unique_lock<std::mutex> lock(stateMutex);
+          allTasksDone.wait(lock, [this]{ return unfinishedTasks == 0; });
+          stopping = true;
+      }
+      taskAvailable.notify_all();
+
+      for (std::thread & worker : workers)
+      {
+          worker.join();
+      }
+  }
+
+  unsigned int ThreadPool::size() const
+  {
+      return workers.size();
+  }
+
+  void ThreadPool::submit(Task task)
+  {
+      submit(std::move(task), nextWorker++);
+  }
+
+  void ThreadPool::submit(Task task, unsigned int worker)
+  {
+      WorkerQueue & queue = *queues[worker % queues.size()];
+      {
+          std::lock_guard<std::mutex> lock(queue.mutex);
+          queue.tasks.push_back(std::move(task));
+      }
+      {
+          std::lock_guard<std::mutex> lock(stateMutex);
+          ++queuedTasks;
+          ++unfinishedTasks;
+      }
+      taskAvailable.notify_one();
+  }
+
+  void ThreadPool::wait()
+  {
+      std::unique_lock<std::mutex> lock(stateMutex);
+      allTasksDone.wait(lock, [this]{ return unfinishedTasks == 0; });
+
+      if (firstException)
+      {
+          std::exception_ptr e = std::exchange(firstException, nullptr);
+          std::rethrow_exception(e);
+      }
+  }
+
+  bool ThreadPool::tryTakeTask(unsigned int worker, Task & task)
+  {
+      // Own queue first, then steal from the others in turn.
+      for (std::size_t offset = 0; offset < queues.size(); ++offset)
+      {
+          WorkerQueue & queue = *queues[(worker + offset) % queues.size()];
+          std::lock_guard<std::mutex> lock(queue.mutex);
+          if (! queue.tasks.empty())
+          {
+              task = std::move(queue.tasks.front());
+              queue.tasks.pop_front();
+              return true;
+          }
+      }
+      return false;
+  }
+
+  void ThreadPool::workerLoop(unsigned int worker)
+  {
+      while (true)
+      {
+          {
+              std::unique_lock<std::mutex> lock(stateMutex);
+              taskAvailable.wait(lock, [this]{ return queuedTasks > 0 || stopping; });
+              if (queuedTasks == 0)
+              {
+                  return; // stopping, and nothing left to do
+              }
+              --queuedTasks; // reserves one task, which is already in some queue
+          }
+
+          Task task;
+          while (! tryTakeTask(worker, task))
+          {
+              std::this_thread::yield();
+          }
+
+          try
+          {
+              task();
+          }
+          catch (...)
+          {
+              std::lock_guard<std::mutex> lock(stateMutex);
+              if (! firstException) firstException = std::current_exception();
+          }
+
+          bool finishedAll;
+          {
+              std::lock_guard<std::mutex> lock(stateMutex);
+              finishedAll = (--unfinishedTasks == 0);
+          }
+          if (finishedAll) allTasksDone.notify_all();
+      }
+  }
+}
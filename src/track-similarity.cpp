@@ -0,0 +1,314 @@
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <deque>
+#include <mutex>
+#include <numeric>
+#include <stdexcept>
+#include <tuple>
+
+#include "thread-pool.h"
+#include "track-similarity.h"
+#include "unit-vectors.h"
+
+namespace GPS
+{
+  namespace
+  {
+      const double infinity = std::numeric_limits<double>::infinity();
+
+      // The Track itself, as there is no distance to a Track without fixes.
+      const Track & nonEmpty(const Track & track)
+      {
+          if (track.empty()) throw std::domain_error("Cannot compare an empty Track.");
+          return track;
+      }
+
+      /* The Fréchet distance as a squared chord, or no value if it is more than 'limit'.
+       * Each cell holds the least possible maximum squared chord of the walks to it.
+       */
+      std::optional<double> frechetSquaredChord(const UnitVectors & a, const UnitVectors & b, double limit)
+      {
+          const std::size_t m = b.size();
+          std::vector<double> row(m), chords(m);
+
+          squaredChords(a, 0, b, 0, m, chords.data());
+          row[0] = chords[0];
+          for (std::size_t j = 1; j < m; ++j) row[j] = std::max(chords[j], row[j-1]);
+          if (row[0] > limit) return std::nullopt;
+
+          for (std::size_t i = 1; i < a.size(); ++i)
+          {
+              squaredChords(a, i, b, 0, m, chords.data());
+              double diagonal = row[0];
+              row[0] = std::max(chords[0], row[0]);
+              double rowMinimum = row[0];
+              for (std::size_t j = 1; j < m; ++j)
+              {
+                  const double above = row[j];
+                  row[j] = std::max(chords[j], std::min({diagonal, above, row[j-1]}));
+                  diagonal = above;
+                  rowMinimum = std::min(rowMinimum, row[j]);
+              }
+              // Every walk passes through every row, and the maximum can only grow.
+              if (rowMinimum > limit) return std::nullopt;
+          }
+
+          if (row[m-1] > limit) return std::nullopt;
+          return row[m-1];
+      }
+
+      std::optional<metres> frechet(const UnitVectors & a, const UnitVectors & b, metres limit)
+      {
+          const std::optional<double> squaredChord = frechetSquaredChord(a, b, squaredChordFromDistance(limit));
+          if (! squaredChord) return std::nullopt;
+
+          const metres distance = distanceFromSquaredChord(*squaredChord);
+          if (distance > limit) return std::nullopt;
+          return distance;
+      }
+
+      // The range of fixes of the second Track that fix 'row' of the first can be matched with.
+      struct WarpingBand
+      {
+          std::size_t rows, columns, window;
+
+          WarpingBand(std::size_t rows, std::size_t columns, std::size_t window)
+            : rows(rows), columns(columns), window(window)
+          {
+              // Wide enough that consecutive rows' ranges overlap, so a warping path always exists.
+              const std::size_t required = rows > 1 ? (columns - 1 + rows - 2) / (rows - 1) : columns;
+              this->window = std::max(window, required);
+          }
+
+          std::size_t centre(std::size_t row) const
+          {
+              return rows > 1 ? (row * (columns - 1) + (rows - 1) / 2) / (rows - 1) : 0;
+          }
+
+          std::size_t first(std::size_t row) const
+          {
+              const std::size_t c = centre(row);
+              return c > window ? c - window : 0;
+          }
+
+          std::size_t last(std::size_t row) const
+          {
+              const std::size_t c = centre(row);
+              return window >= columns - 1 - c ? columns - 1 : c + window;
+          }
+      };
+
+      /* The DTW distance, or no value if it is more than 'limit'.
+       * The rows hold the least total distance of the paths to each cell, shifted along by one
+       * so that element 0 is the cell before the first column.  Only the cells within the
+       * warping band are computed; the rest stay infinite.
+       */
+      std::optional<metres> dtw(const UnitVectors & a, const UnitVectors & b, metres limit, std::size_t window)
+      {
+          const std::size_t m = b.size();
+          const WarpingBand band(a.size(), m, window);
+          std::vector<double> previous(m + 1, infinity), current(m + 1, infinity), chords(m);
+
+          // The path starts from the cell before the first row and column.
+          previous[0] = 0;
+
+          for (std::size_t i = 0; i < a.size(); ++i)
+          {
+              const std::size_t first = band.first(i), last = band.last(i);
+
+              // Clear the cells left over from two rows ago.
+              if (i >= 2) std::fill(current.begin() + band.first(i-2) + 1, current.begin() + band.last(i-2) + 2, infinity);
+
+              squaredChords(a, i, b, first, last + 1, chords.data());
+              double rowMinimum = infinity;
+              for (std::size_t j = first; j <= last; ++j)
+              {
+                  const double best = std::min({previous[j+1], previous[j], current[j]});
+                  current[j+1] = distanceFromSquaredChord(chords[j - first]) + best;
+                  rowMinimum = std::min(rowMinimum, current[j+1]);
+              }
+              // Every path passes through every row, and the total can only grow.
+              if (rowMinimum > limit) return std::nullopt;
+
+              if (i == 0) previous[0] = infinity;
+              std::swap(previous, current);
+          }
+
+          const metres distance = previous[m];
+          if (distance > limit) return std::nullopt;
+          return distance;
+      }
+
+      /* A lower bound on the Fréchet distance, as a squared chord: the walkers start together
+       * at the first fixes and finish at the last, and every fix of 'a' is somewhere within
+       * the bounding box of 'b' from the fix of 'b' it is paired with.
+       */
+      double frechetLowerBound(const UnitVectors & a, const UnitVectors & b)
+      {
+          UnitVectorBox box;
+          for (std::size_t j = 0; j < b.size(); ++j) box.add(b, j);
+
+          double bound = 0;
+          for (std::size_t i = 0; i < a.size(); ++i) bound = std::max(bound, box.squaredDistanceFrom(a, i));
+
+          const double ends[3][2] = {{a.x.front(), b.x.front()}, {a.y.front(), b.y.front()}, {a.z.front(), b.z.front()}};
+          const double backs[3][2] = {{a.x.back(), b.x.back()}, {a.y.back(), b.y.back()}, {a.z.back(), b.z.back()}};
+          double front = 0, back = 0;
+          for (int axis = 0; axis < 3; ++axis)
+          {
+              front += (ends[axis][0] - ends[axis][1]) * (ends[axis][0] - ends[axis][1]);
+              back += (backs[axis][0] - backs[axis][1]) * (backs[axis][0] - backs[axis][1]);
+          }
+          return std::max({bound, front, back});
+      }
+
+      /* The LB_Keogh lower bound on the DTW distance: every fix of 'a' is matched with at least
+       * one fix of 'b' within its warping band, so it is at least as far as the bounding box of
+       * those fixes.  The boxes of successive bands are maintained with sliding-window minimum
+       * and maximum queues, as both ends of the band only move forwards.
+       */
+      metres dtwLowerBound(const UnitVectors & a, const UnitVectors & b, std::size_t window)
+      {
+          const WarpingBand band(a.size(), b.size(), window);
+          const std::vector<double> * columns[3] = {&b.x, &b.y, &b.z};
+          std::deque<std::size_t> minima[3], maxima[3];
+
+          metres bound = 0;
+          std::size_t added = 0;
+          for (std::size_t i = 0; i < a.size(); ++i)
+          {
+              const std::size_t first = band.first(i), last = band.last(i);
+              for (; added <= last; ++added)
+              {
+                  for (int axis = 0; axis < 3; ++axis)
+                  {
+                      const std::vector<double> & values = *columns[axis];
+                      while (! minima[axis].empty() && values[minima[axis].back()] >= values[added]) minima[axis].pop_back();
+                      minima[axis].push_back(added);
+                      while (! maxima[axis].empty() && values[maxima[axis].back()] <= values[added]) maxima[axis].pop_back();
+                      maxima[axis].push_back(added);
+                  }
+              }
+
+              UnitVectorBox box;
+              for (int axis = 0; axis < 3; ++axis)
+              {
+                  while (minima[axis].front() < first) minima[axis].pop_front();
+                  while (maxima[axis].front() < first) maxima[axis].pop_front();
+                  box.min[axis] = (*columns[axis])[minima[axis].front()];
+                  box.max[axis] = (*columns[axis])[maxima[axis].front()];
+              }
+              bound += distanceFromSquaredChord(box.squaredDistanceFrom(a, i));
+          }
+          return bound;
+      }
+  }
+
+  metres frechetDistance(const Track & a, const Track & b)
+  {
+      return distanceFromSquaredChord(*frechetSquaredChord(UnitVectors(nonEmpty(a)), UnitVectors(nonEmpty(b)), infinity));
+  }
+
+  std::optional<metres> frechetDistanceWithin(const Track & a, const Track & b, metres limit)
+  {
+      return frechet(UnitVectors(nonEmpty(a)), UnitVectors(nonEmpty(b)), limit);
+  }
+
+  metres dtwDistance(const Track & a, const Track & b, std::size_t window)
+  {
+      return *dtw(UnitVectors(nonEmpty(a)), UnitVectors(nonEmpty(b)), infinity, window);
+  }
+
+  std::optional<metres> dtwDistanceWithin(const Track & a, const Track & b, metres limit, std::size_t window)
+  {
+      return dtw(UnitVectors(nonEmpty(a)), UnitVectors(nonEmpty(b)), limit, window);
+  }
+
+  std::vector<RouteMatch> nearestRoutes(const Track & track, const std::vector<Track> & routes, RouteSearchOptions options)
+  {
+      using Measure = RouteSearchOptions::Measure;
+
+      const UnitVectors query(nonEmpty(track));
+      std::vector<UnitVectors> vectors;
+      vectors.reserve(routes.size());
+      for (const Track & route : routes) vectors.emplace_back(nonEmpty(route));
+      if (options.count == 0) return {};
+
+      ThreadPool pool(options.threadCount);
+
+      // The lower bounds, in metres, rounded down slightly so they never exceed the distances.
+      std::vector<metres> bounds(routes.size());
+      for (std::size_t route = 0; route < routes.size(); ++route)
+      {
+          pool.submit([&, route]
+          {
+              const metres bound = options.measure == Measure::frechet
+                                   ? distanceFromSquaredChord(frechetLowerBound(query, vectors[route]))
+                                   : dtwLowerBound(query, vectors[route], options.window);
+              bounds[route] = bound * (1 - 1e-9);
+          });
+      }
+      pool.wait();
+
+      std::vector<std::size_t> order(routes.size());
+      std::iota(order.begin(), order.end(), 0);
+      std::sort(order.begin(), order.end(), [&bounds](std::size_t r, std::size_t s)
+      {
+          return std::tie(bounds[r], r) < std::tie(bounds[s], s);
+      });
+
+      const auto nearer = [](const RouteMatch & r, const RouteMatch & s)
+      {
+          return std::tie(r.distance, r.route) < std::tie(s.distance, s.route);
+      };
+
+      // The nearest routes so far, as a heap with the furthest at the top.
+      std::vector<RouteMatch> nearest;
+      metres furthest = infinity;
+      std::mutex mutex;
+      std::atomic<std::size_t> next{0};
+
+      for (unsigned int worker = 0; worker < pool.size(); ++worker)
+      {
+          pool.submit([&]
+          {
+              for (std::size_t k = next++; k < order.size(); k = next++)
+              {
+                  const std::size_t route = order[k];
+                  metres limit;
+                  {
+                      std::lock_guard<std::mutex> lock(mutex);
+                      limit = furthest;
+                  }
+                  // The rest of the routes have lower bounds at least as far.
+                  if (bounds[route] > limit) break;
+
+                  const std::optional<metres> distance = options.measure == Measure::frechet
+                                                         ? frechet(query, vectors[route], limit)
+                                                         : dtw(query, vectors[route], limit, options.window);
+                  if (! distance) continue;
+
+                  std::lock_guard<std::mutex> lock(mutex);
+                  const RouteMatch match = {route, *distance};
+                  if (nearest.size() < options.count)
+                  {
+                      nearest.push_back(match);
+                      std::push_heap(nearest.begin(), nearest.end(), nearer);
+                  }
+                  else if (nearer(match, nearest.front()))
+                  {
+                      std::pop_heap(nearest.begin(), nearest.end(), nearer);
+                      nearest.back() = match;
+                      std::push_heap(nearest.begin(), nearest.end(), nearer);
+                  }
+                  if (nearest.size() == options.count) furthest = nearest.front().distance;
+              }
+          });
+      }
+      pool.wait();
+
+      std::sort_heap(nearest.begin(), nearest.end(), nearer);
+      return nearest;
+  }
+}
@@ -0,0 +1,128 @@
+#include <algorithm>
+#include <stdexcept>
+
+#include "track-statistics.h"
+
+namespace GPS
+{
+  void TrackStatistics::add(const Position & p)
+  {
+      if (count == 0)
+      {
+          firstPosition = p;
+          box = {p.latitude(), p.latitude(), p.longitude(), p.longitude()};
+          lowest = highest = p.elevation();
+      }
+      else
+      {
+          distance += Position::horizontalDistanceBetween(*lastPosition, p);
+          const metres rise = p.elevation() - lastPosition->elevation();
+          if (rise > 0) gain += rise;
+          else loss -= rise;
+
+          box.minLatitude = std::min(box.minLatitude, p.latitude());
+          box.maxLatitude = std::max(box.maxLatitude, p.latitude());
+          box.minLongitude = std::min(box.minLongitude, p.longitude());
+          box.maxLongitude = std::max(box.maxLongitude, p.longitude());
+          lowest = std::min(lowest, p.elevation());
+          highest = std::max(highest, p.elevation());
+      }
+
+      lastPosition = p;
+      elevationSum += p.elevation();
+      ++count;
+  }
+
+  void TrackStatistics::merge(const TrackStatistics & following)
+  {
+      if (following.count == 0) return;
+      if (count == 0)
+      {
+          *this = following;
+          return;
+      }
+
+      // The leg joining the two pieces belongs to neither of them.
+      const Position & joinStart = *lastPosition;
+      const Position & joinEnd = *following.firstPosition;
+      distance += Position::horizontalDistanceBetween(joinStart, joinEnd) + following.distance;
+      const metres rise = joinEnd.elevation() - joinStart.elevation();
+      gain += (rise > 0 ? rise : 0) + following.gain;
+      loss += (rise < 0 ? -rise : 0) + following.loss;
+
+      box.minLatitude = std::min(box.minLatitude, following.box.minLatitude);
+      box.maxLatitude = std::max(box.maxLatitude, following.box.maxLatitude);
+      box.minLongitude = std::min(box.minLongitude, following.box.minLongitude);
+      box.maxLongitude = std::max(box.maxLongitude, following.box.maxLongitude);
+      lowest = std::min(lowest, following.lowest);
+      highest = std::max(highest, following.highest);
+
+      lastPosition = following.lastPosition;
+      elevationSum += following.elevationSum;
+      count += following.count;
+  }
+
+  std::size_t TrackStatistics::fixCount() const
+  {
+      return count;
+  }
+
+  metres TrackStatistics::totalDistance() const
+  {
+      return distance;
+  }
+
+  metres TrackStatistics::elevationGain() const
+  {
+      return gain;
+  }
+
+  metres TrackStatistics::elevationLoss() const
+  {
+      return loss;
+  }
+
+  void TrackStatistics::checkNotEmpty() const
+  {
+      if (count == 0)
+      {
+          throw std::domain_error("There are no Positions in the track.");
+      }
+  }
+
+  BoundingBox TrackStatistics::boundingBox() const
+  {
+      checkNotEmpty();
+      return box;
+  }
+
+  metres TrackStatistics::minElevation() const
+  {
+      checkNotEmpty();
+      return lowest;
+  }
+
+  metres TrackStatistics::maxElevation() const
+  {
+      checkNotEmpty();
+      return highest;
+  }
+
+  metres TrackStatistics::meanElevation() const
+  {
+      checkNotEmpty();
+      return static_cast<metres>(elevationSum / count);
+  }
+
+  Position TrackStatistics::first() const
+  {
+      checkNotEmpty();
+      return *firstPosition;
+  }
+
+  Position TrackStatistics::last() const
+  {
+      checkNotEmpty();
+      return *lastPosition;
+  }
+}
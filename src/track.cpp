@@ -0,0 +1,231 @@
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <string>
+
+#include "geometry.h"
+#include "track.h"
+
+namespace GPS
+{
+  namespace
+  {
+      /* Fixes further apart than this (in degrees of latitude or longitude, about a kilometre at
+       * the equator) are interpolated along great circles, as linear interpolation of latitude
+       * and longitude would stray from the shortest path between them.
+       */
+      const degrees greatCircleGap = 0.01;
+
+      // The change in longitude from one fix to the next, the shorter way round.
+      degrees longitudeChange(degrees from, degrees to)
+      {
+          const degrees change = to - from;
+          return change > halfRotation ? change - fullRotation : (change < -halfRotation ? change + fullRotation : change);
+      }
+
+      degrees wrapLongitude(degrees lon)
+      {
+          return lon > antiMeridianLongitude ? lon - fullRotation : (lon <= -antiMeridianLongitude ? lon + fullRotation : lon);
+      }
+
+      // The point a fraction of the way along the great circle from one point to another.
+      void greatCircleInterpolate(degrees lat0, degrees lon0, degrees lat1, degrees lon1, double fraction,
+                                  degrees & lat, degrees & lon)
+      {
+          const radians phi0 = degToRad(lat0), lambda0 = degToRad(lon0);
+          const radians phi1 = degToRad(lat1), lambda1 = degToRad(lon1);
+          const double a[3] = {std::cos(phi0) * std::cos(lambda0), std::cos(phi0) * std::sin(lambda0), std::sin(phi0)};
+          const double b[3] = {std::cos(phi1) * std::cos(lambda1), std::cos(phi1) * std::sin(lambda1), std::sin(phi1)};
+
+          const double cross = pythagoras(a[1]*b[2] - a[2]*b[1], a[2]*b[0] - a[0]*b[2], a[0]*b[1] - a[1]*b[0]);
+          const radians angle = std::atan2(cross, a[0]*b[0] + a[1]*b[1] + a[2]*b[2]);
+          if (! (cross > 1e-12))
+          {
+              // Coincident or antipodal points have no unique great circle.
+              lat = lat0 + fraction * (lat1 - lat0);
+              lon = wrapLongitude(lon0 + fraction * longitudeChange(lon0, lon1));
+              return;
+          }
+
+          const double weight0 = std::sin((1 - fraction) * angle) / cross;
+          const double weight1 = std::sin(fraction * angle) / cross;
+          double v[3];
+          for (int i = 0; i < 3; ++i) v[i] = weight0 * a[i] + weight1 * b[i];
+
+          lat = std::clamp(radToDeg(std::atan2(v[2], pythagoras(v[0], v[1]))), -poleLatitude, poleLatitude);
+          lon = wrapLongitude(radToDeg(std::atan2(v[1], v[0])));
+      }
+  }
+
+  void Track::append(const Position & p, double time)
+  {
+      if (! timeColumn.empty() && time < timeColumn.back())
+          throw std::invalid_argument("Track times must not decrease: " + std::to_string(time) + " follows " + std::to_string(timeColumn.back()) + ".");
+
+      lats.push_back(p.latitude());
+      lons.push_back(p.longitude());
+      eles.push_back(p.elevation());
+      timeColumn.push_back(time);
+  }
+
+  std::size_t Track::size() const
+  {
+      return timeColumn.size();
+  }
+
+  bool Track::empty() const
+  {
+      return timeColumn.empty();
+  }
+
+  void Track::reserve(std::size_t n)
+  {
+      lats.reserve(n);
+      lons.reserve(n);
+      eles.reserve(n);
+      timeColumn.reserve(n);
+  }
+
+  void Track::clear()
+  {
+      lats.clear();
+      lons.clear();
+      eles.clear();
+      timeColumn.clear();
+  }
+
+  Position Track::position(std::size_t i) const
+  {
+      return Position(lats[i], lons[i], eles[i]);
+  }
+
+  double Track::time(std::size_t i) const
+  {
+      return timeColumn[i];
+  }
+
+  std::size_t Track::fixAfter(double time) const
+  {
+      const std::size_t after = std::upper_bound(timeColumn.begin(), timeColumn.end(), time) - timeColumn.begin();
+      return std::min(after, timeColumn.size() - 1);
+  }
+
+  Position Track::interpolate(std::size_t after, double time) const
+  {
+      const std::size_t before = after > 0 ? after - 1 : 0;
+      const double interval = timeColumn[after] - timeColumn[before];
+      const double fraction = interval > 0 ? (time - timeColumn[before]) / interval : 1;
+      const degrees lonChange = longitudeChange(lons[before], lons[after]);
+
+      degrees lat, lon;
+      if (std::abs(lats[after] - lats[before]) > greatCircleGap || std::abs(lonChange) > greatCircleGap)
+      {
+          greatCircleInterpolate(lats[before], lons[before], lats[after], lons[after], fraction, lat, lon);
+      }
+      else
+      {
+          lat = lats[before] + fraction * (lats[after] - lats[before]);
+          lon = wrapLongitude(lons[before] + fraction * lonChange);
+      }
+      return Position(lat, lon, eles[before] + fraction * (eles[after] - eles[before]));
+  }
+
+  Position Track::positionAt(double time) const
+  {
+      if (empty())
+          throw std::domain_error("Cannot interpolate the Position of an empty Track.");
+
+      if (! (time >= timeColumn.front() && time <= timeColumn.back()))
+          throw std::invalid_argument("The time " + std::to_string(time) + " is outside the Track's time span.");
+
+      return interpolate(fixAfter(time), time);
+  }
+
+  Track Track::positionsAt(const std::vector<double> & times) const
+  {
+      if (empty())
+          throw std::domain_error("Cannot interpolate the Positions of an empty Track.");
+
+      const std::size_t count = times.size();
+
+      // Find the fixes either side of each time, in one pass.
+      std::vector<std::size_t> befores(count), afters(count);
+      std::vector<double> fractions(count);
+      std::size_t after = 0;
+      for (std::size_t k = 0; k < count; ++k)
+      {
+          const double time = times[k];
+          if (! (time >= timeColumn.front() && time <= timeColumn.back()))
+              throw std::invalid_argument("The time " + std::to_string(time) + " is outside the Track's time span.");
+
+          if (k > 0 && time < times[k-1])
+              throw std::invalid_argument("Interpolation times must not decrease: " + std::to_string(time) + " follows " + std::to_string(times[k-1]) + ".");
+
+          while (after + 1 < size() && timeColumn[after] <= time) ++after;
+          afters[k] = after;
+          befores[k] = after > 0 ? after - 1 : 0;
+          const double interval = timeColumn[after] - timeColumn[befores[k]];
+          fractions[k] = interval > 0 ? (time - timeColumn[befores[k]]) / interval : 1;
+      }
+
+      Track result;
+      result.lats.resize(count);
+      result.lons.resize(count);
+      result.eles.resize(count);
+      result.timeColumn = times;
+
+      // Interpolate every time linearly, then redo the few between distant fixes.
+      for (std::size_t k = 0; k < count; ++k)
+      {
+          const std::size_t b = befores[k], a = afters[k];
+          const double f = fractions[k];
+          result.lats[k] = lats[b] + f * (lats[a] - lats[b]);
+          result.lons[k] = wrapLongitude(lons[b] + f * longitudeChange(lons[b], lons[a]));
+          result.eles[k] = eles[b] + f * (eles[a] - eles[b]);
+      }
+      for (std::size_t k = 0; k < count; ++k)
+      {
+          const std::size_t b = befores[k], a = afters[k];
+          if (std::abs(lats[a] - lats[b]) > greatCircleGap || std::abs(longitudeChange(lons[b], lons[a])) > greatCircleGap)
+          {
+              greatCircleInterpolate(lats[b], lons[b], lats[a], lons[a], fractions[k], result.lats[k], result.lons[k]);
+          }
+      }
+      return result;
+  }
+
+  Track Track::resampled(double interval) const
+  {
+      if (empty())
+          throw std::domain_error("Cannot resample an empty Track.");
+
+      if (! (interval > 0))
+          throw std::invalid_argument("The resampling interval must be positive.");
+
+      const double first = timeColumn.front();
+      const std::size_t count = static_cast<std::size_t>(std::floor((timeColumn.back() - first) / interval)) + 1;
+      std::vector<double> times(count);
+      for (std::size_t k = 0; k < count; ++k) times[k] = std::min(first + k * interval, timeColumn.back());
+      return positionsAt(times);
+  }
+
+  const std::vector<degrees> & Track::latitudes() const
+  {
+      return lats;
+  }
+
+  const std::vector<degrees> & Track::longitudes() const
+  {
+      return lons;
+  }
+
+  const std::vector<metres> & Track::elevations() const
+  {
+      return eles;
+  }
+
+  const std::vector<double> & Track::times() const
+  {
+      return timeColumn;
+  }
+}
@@ -0,0 +1,178 @@
+#include <boost/test/unit_test.hpp>
+
+#include <algorithm>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+#include "clustering.h"
+#include "earth.h"
+#include "geometry.h"
+
+using namespace GPS;
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_SUITE( ClusteringTests )
+
+// DBSCAN by comparing every pair of Positions, for checking the results.
+Clusters pairwiseClusters(const std::vector<Position> & positions, metres radius, std::size_t minPoints)
+{
+    const std::size_t size = positions.size();
+    std::vector<std::vector<std::size_t>> neighbours(size);
+    for (std::size_t i = 0; i < size; ++i)
+    {
+        for (std::size_t j = 0; j < size; ++j)
+        {
+            if (Position::horizontalDistanceBetween(positions[i], positions[j]) <= radius) neighbours[i].push_back(j);
+        }
+    }
+
+    Clusters clusters;
+    clusters.labels.assign(size, Clusters::noise);
+    for (std::size_t i = 0; i < size; ++i)
+    {
+        if (neighbours[i].size() < minPoints || clusters.labels[i] != Clusters::noise) continue;
+
+        // A new cluster, starting from its first core Position.
+        std::vector<std::size_t> stack = {i};
+        clusters.labels[i] = clusters.count;
+        while (! stack.empty())
+        {
+            const std::size_t core = stack.back();
+            stack.pop_back();
+            for (std::size_t j : neighbours[core])
+            {
+                if (neighbours[j].size() >= minPoints && clusters.labels[j] == Clusters::noise)
+                {
+                    clusters.labels[j] = clusters.count;
+                    stack.push_back(j);
+                }
+            }
+        }
+        ++clusters.count;
+    }
+
+    // Border Positions join the cluster of their earliest core neighbour.
+    for (std::size_t i = 0; i < size; ++i)
+    {
+        if (neighbours[i].size() >= minPoints) continue;
+        for (std::size_t j : neighbours[i])
+        {
+            if (neighbours[j].size() >= minPoints)
+            {
+                clusters.labels[i] = clusters.labels[j];
+                break;
+            }
+        }
+    }
+    return clusters;
+}
+
+void checkSameClusters(const std::vector<Position> & positions, metres radius, std::size_t minPoints)
+{
+    const Clusters expected = pairwiseClusters(positions, radius, minPoints);
+    BOOST_CHECK_GT( expected.count , 1 );
+    BOOST_CHECK( std::count(expected.labels.begin(), expected.labels.end(), Clusters::noise) > 0 );
+
+    for (unsigned int threads : {1, 3})
+    {
+        const Clusters actual = clusterPositions(positions, radius, minPoints, threads);
+        BOOST_CHECK_EQUAL( actual.count , expected.count );
+        BOOST_CHECK( actual.labels == expected.labels );
+    }
+}
+
+BOOST_AUTO_TEST_CASE( InvalidParameters )
+{
+    BOOST_CHECK_THROW( clusterPositions({Earth::CityCampus}, 0, 2) , std::invalid_argument );
+    BOOST_CHECK_THROW( clusterPositions({Earth::CityCampus}, Earth::polarCircumference / 2, 2) , std::invalid_argument );
+    BOOST_CHECK_THROW( clusterPositions({Earth::CityCampus}, 100, 0) , std::invalid_argument );
+}
+
+BOOST_AUTO_TEST_CASE( NoPositions )
+{
+    const Clusters clusters = clusterPositions({}, 100, 2);
+
+    BOOST_CHECK_EQUAL( clusters.count , 0 );
+    BOOST_CHECK( clusters.labels.empty() );
+}
+
+BOOST_AUTO_TEST_CASE( TwoClustersAndNoise )
+{
+    const std::vector<Position> positions = {Earth::CityCampus, Earth::CityCampus, Earth::CityCampus, Earth::CliftonCampus,
+                                             Earth::CliftonCampus, Earth::Pontianak, Earth::CliftonCampus};
+
+    const Clusters clusters = clusterPositions(positions, 100, 2);
+
+    BOOST_CHECK_EQUAL( clusters.count , 2 );
+    const std::vector<std::size_t> expected = {0, 0, 0, 1, 1, Clusters::noise, 1};
+    BOOST_CHECK( clusters.labels == expected );
+}
+
+BOOST_AUTO_TEST_CASE( ChainsOfCorePositions )
+{
+    // A line of Positions 80m apart forms one cluster, though its ends are far apart.
+    std::vector<Position> positions;
+    for (int i = 0; i < 50; ++i) positions.push_back(Earth::offsetPositions({Earth::CliftonCampus}, 0, i * 80).front());
+
+    const Clusters clusters = clusterPositions(positions, 100, 3);
+
+    BOOST_CHECK_EQUAL( clusters.count , 1 );
+    BOOST_CHECK_EQUAL( clusters.labels.front() , 0 );
+    BOOST_CHECK_EQUAL( clusters.labels.back() , 0 );  // a border Position
+}
+
+BOOST_AUTO_TEST_CASE( MatchesPairwiseClustering )
+{
+    // Blobs of Positions around random centres, with random noise Positions in between.
+    std::mt19937_64 random(44);
+    std::uniform_real_distribution<degrees> offset(-0.01, 0.01);
+    std::vector<Position> positions;
+    for (int blob = 0; blob < 30; ++blob)
+    {
+        const Position centre(Earth::CityCampus.latitude() + 5 * offset(random), Earth::CityCampus.longitude() + 5 * offset(random), 0);
+        for (int i = 0; i < 40; ++i)
+        {
+            positions.emplace_back(centre.latitude() + offset(random) / 10, centre.longitude() + offset(random) / 10, 0);
+        }
+        positions.emplace_back(centre.latitude() + offset(random) * 3, centre.longitude() + offset(random) * 3, 0);
+    }
+
+    checkSameClusters(positions, 150, 5);
+    checkSameClusters(positions, 40, 4);
+}
+
+BOOST_AUTO_TEST_CASE( NearThePolesAndAntiMeridian )
+{
+    std::mt19937_64 random(45);
+    std::uniform_real_distribution<degrees> offset(-0.002, 0.002);
+    std::vector<Position> positions;
+    for (int i = 0; i < 300; ++i)
+    {
+        positions.emplace_back(std::min(poleLatitude, 89.999 + offset(random) / 2), offset(random) * 90000, 0);
+        positions.emplace_back(offset(random), normaliseDegrees(antiMeridianLongitude + offset(random)), 0);
+        positions.emplace_back(-60 + offset(random), normaliseDegrees(antiMeridianLongitude + offset(random)), 0);
+        positions.emplace_back(-30 + offset(random) * 100, normaliseDegrees(antiMeridianLongitude + offset(random) * 100), 0);
+    }
+
+    checkSameClusters(positions, 100, 6);
+}
+
+BOOST_AUTO_TEST_CASE( RadiusSmallerThanTheGridCells )
+{
+    std::vector<Position> positions;
+    for (int i = 0; i < 20; ++i)
+    {
+        positions.push_back(Earth::CityCampus);
+        positions.push_back(Earth::offsetPositions({Earth::CityCampus}, 0.004 * (i % 3), 0).front());
+        positions.push_back(Earth::offsetPositions({Earth::CliftonCampus}, 0, 0.003 * (i % 2)).front());
+        positions.push_back(Earth::offsetPositions({Earth::Pontianak}, 0, 0.5 * i).front());
+    }
+
+    checkSameClusters(positions, 0.005, 3);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+/////////////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,121 @@
+#include <boost/test/unit_test.hpp>
+
+#include <stdexcept>
+#include <vector>
+
+#include "distance-matrix.h"
+#include "earth.h"
+#include "geometry.h"
+#include "test-helpers.h"
+
+using namespace GPS;
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_SUITE( DistanceMatrixTests )
+
+const double percentageAccuracy = 0.000001;
+
+BOOST_AUTO_TEST_CASE( MatchesHorizontalDistanceBetween )
+{
+    const Track a = randomWalk(Earth::CityCampus, 300, 0.01, 1);
+    const Track b = randomWalk(Earth::EquatorialAntiMeridian, 600, 2, 2);
+
+    for (unsigned int threads : {1, 3})
+    {
+        const std::vector<metres> matrix = distanceMatrix(a, b, threads);
+        BOOST_REQUIRE_EQUAL( matrix.size() , a.size() * b.size() );
+        for (std::size_t i = 0; i < a.size(); i += 7)
+        {
+            for (std::size_t j = 0; j < b.size(); j += 3)
+            {
+                BOOST_CHECK_CLOSE( matrix[i * b.size() + j] , Position::horizontalDistanceBetween(a.position(i), b.position(j)) , percentageAccuracy );
+            }
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE( SmallDistances )
+{
+    Track a, b;
+    a.append(Earth::CliftonCampus, 0);
+    b.append(Earth::offsetPositions({Earth::CliftonCampus}, 0.01, 0).front(), 0);
+    b.append(Earth::CliftonCampus, 1);
+
+    const std::vector<metres> matrix = distanceMatrix(a, b);
+    BOOST_REQUIRE_EQUAL( matrix.size() , 2 );
+    BOOST_CHECK_CLOSE( matrix[0] , Position::horizontalDistanceBetween(a.position(0), b.position(0)) , percentageAccuracy );
+    BOOST_CHECK_LT( matrix[0] , 0.011 );
+    BOOST_CHECK_EQUAL( matrix[1] , 0 );
+}
+
+BOOST_AUTO_TEST_CASE( EmptyTracks )
+{
+    BOOST_CHECK( distanceMatrix(Track(), randomWalk(Earth::CityCampus, 10, 0.01, 3)).empty() );
+    BOOST_CHECK( closePairs(Track(), randomWalk(Earth::CityCampus, 10, 0.01, 3), 1000).empty() );
+    BOOST_CHECK( closePairs(std::vector<Track>(), 1000).empty() );
+}
+
+BOOST_AUTO_TEST_CASE( NegativeThreshold )
+{
+    BOOST_CHECK_THROW( closePairs(Track(), Track(), -1) , std::invalid_argument );
+}
+
+BOOST_AUTO_TEST_CASE( ClosePairsMatchAllPairs )
+{
+    // Some Tracks near each other, and one far away.
+    const std::vector<Track> tracks = {randomWalk(Earth::CityCampus, 700, 0.001, 4),
+                                       randomWalk(Earth::CliftonCampus, 500, 0.001, 5),
+                                       randomWalk(Earth::CityCampus, 300, 0.001, 6),
+                                       randomWalk(Earth::Pontianak, 400, 0.001, 7)};
+    const metres threshold = 300;
+
+    std::vector<ClosePair> expected;
+    for (std::size_t first = 0; first < tracks.size(); ++first)
+    {
+        for (std::size_t second = first + 1; second < tracks.size(); ++second)
+        {
+            for (std::size_t i = 0; i < tracks[first].size(); ++i)
+            {
+                for (std::size_t j = 0; j < tracks[second].size(); ++j)
+                {
+                    const metres distance = Position::horizontalDistanceBetween(tracks[first].position(i), tracks[second].position(j));
+                    if (distance <= threshold) expected.push_back({first, i, second, j, distance});
+                }
+            }
+        }
+    }
+    BOOST_REQUIRE_GT( expected.size() , 100 );
+
+    for (unsigned int threads : {1, 3})
+    {
+        const std::vector<ClosePair> pairs = closePairs(tracks, threshold, threads);
+        BOOST_REQUIRE_EQUAL( pairs.size() , expected.size() );
+        for (std::size_t k = 0; k < pairs.size(); ++k)
+        {
+            BOOST_CHECK_EQUAL( pairs[k].firstTrack , expected[k].firstTrack );
+            BOOST_CHECK_EQUAL( pairs[k].firstFix , expected[k].firstFix );
+            BOOST_CHECK_EQUAL( pairs[k].secondTrack , expected[k].secondTrack );
+            BOOST_CHECK_EQUAL( pairs[k].secondFix , expected[k].secondFix );
+            BOOST_CHECK_CLOSE( pairs[k].distance , expected[k].distance , percentageAccuracy );
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE( TwoTracks )
+{
+    const Track a = randomWalk(Earth::CityCampus, 50, 0.001, 8);
+    const Track b = randomWalk(Earth::CityCampus, 50, 0.001, 9);
+    const std::vector<ClosePair> pairs = closePairs(a, b, 200);
+
+    BOOST_REQUIRE( ! pairs.empty() );
+    BOOST_CHECK_EQUAL( pairs.front().firstTrack , 0 );
+    BOOST_CHECK_EQUAL( pairs.front().secondTrack , 1 );
+    BOOST_CHECK_EQUAL( pairs.front().firstFix , 0 );
+    BOOST_CHECK_EQUAL( pairs.front().secondFix , 0 );
+    BOOST_CHECK_EQUAL( pairs.front().distance , 0 );
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+/////////////////////////////////////////////////////////////////////////////////////////
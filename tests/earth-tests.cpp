@@ -0,0 +1,113 @@
+#include <boost/test/unit_test.hpp>
+
+#include <stdexcept>
+#include <vector>
+
+#include "earth.h"
+#include "geometry.h"
+
+using namespace GPS;
+
+// Positions spread over the Earth, away from the poles.
+std::vector<Position> spreadPositions()
+{
+    std::vector<Position> positions;
+    for (degrees lat = -89.5; lat < 90; lat += 0.37)
+    {
+        positions.emplace_back(lat, normaliseDegrees(lat * 7.3), 100);
+    }
+    return positions;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_SUITE( EarthBatchTests )
+
+const double tolerance = 1e-6; // As a percentage, allowing for the interpolated cosines.
+
+BOOST_AUTO_TEST_CASE( EmptyBatches )
+{
+    BOOST_CHECK( Earth::boundingBoxes({}, 1000).empty() );
+    BOOST_CHECK( Earth::offsetPositions({}, 1000, 1000).empty() );
+}
+
+BOOST_AUTO_TEST_CASE( BoundingBoxesMatchScalarFunctions )
+{
+    const metres distance = 5000;
+    const std::vector<Position> centres = spreadPositions();
+    const std::vector<BoundingBox> boxes = Earth::boundingBoxes(centres, distance);
+
+    BOOST_REQUIRE_EQUAL( boxes.size() , centres.size() );
+    for (std::size_t i = 0; i < centres.size(); ++i)
+    {
+        const degrees lat = centres[i].latitude();
+        const degrees lon = centres[i].longitude();
+        const degrees latitudeDistance = Earth::latitudeSubtendedBy(distance);
+        const degrees longitudeDistance = Earth::longitudeSubtendedBy(distance, lat);
+
+        BOOST_CHECK_CLOSE( boxes[i].minLatitude , lat - latitudeDistance , tolerance );
+        BOOST_CHECK_CLOSE( boxes[i].maxLatitude , lat + latitudeDistance , tolerance );
+        BOOST_CHECK_CLOSE( normaliseDegrees(boxes[i].maxLongitude - lon) , longitudeDistance , tolerance );
+        BOOST_CHECK_CLOSE( normaliseDegrees(lon - boxes[i].minLongitude) , longitudeDistance , tolerance );
+    }
+}
+
+BOOST_AUTO_TEST_CASE( BoundingBoxesCrossingTheAntiMeridian )
+{
+    const std::vector<BoundingBox> boxes = Earth::boundingBoxes({Position(10, 179.99, 0), Position(-10, -179.99, 0)}, 5000);
+
+    BOOST_REQUIRE_EQUAL( boxes.size() , 2 );
+    BOOST_CHECK_GT( boxes[0].minLongitude , boxes[0].maxLongitude );
+    BOOST_CHECK_CLOSE( boxes[0].minLongitude , 179.99 - Earth::longitudeSubtendedBy(5000, 10) , tolerance );
+    BOOST_CHECK_CLOSE( boxes[0].maxLongitude , -180 + (179.99 + Earth::longitudeSubtendedBy(5000, 10) - 180) , tolerance );
+    BOOST_CHECK_GT( boxes[1].minLongitude , boxes[1].maxLongitude );
+}
+
+BOOST_AUTO_TEST_CASE( BoundingBoxesReachingAPole )
+{
+    const std::vector<BoundingBox> boxes = Earth::boundingBoxes({Earth::NorthPole, Position(-89.99, 45, 0)}, 5000);
+
+    BOOST_REQUIRE_EQUAL( boxes.size() , 2 );
+    BOOST_CHECK_EQUAL( boxes[0].maxLatitude , poleLatitude );
+    BOOST_CHECK_CLOSE( boxes[0].minLatitude , poleLatitude - Earth::latitudeSubtendedBy(5000) , tolerance );
+    BOOST_CHECK_EQUAL( boxes[0].minLongitude , -antiMeridianLongitude );
+    BOOST_CHECK_EQUAL( boxes[0].maxLongitude , antiMeridianLongitude );
+    BOOST_CHECK_EQUAL( boxes[1].minLatitude , -poleLatitude );
+    BOOST_CHECK_EQUAL( boxes[1].minLongitude , -antiMeridianLongitude );
+    BOOST_CHECK_EQUAL( boxes[1].maxLongitude , antiMeridianLongitude );
+}
+
+BOOST_AUTO_TEST_CASE( OffsetPositionsMatchScalarFunctions )
+{
+    const metres north = -1234.5, east = 6789;
+    const std::vector<Position> origins = spreadPositions();
+    const std::vector<Position> destinations = Earth::offsetPositions(origins, north, east);
+
+    BOOST_REQUIRE_EQUAL( destinations.size() , origins.size() );
+    for (std::size_t i = 0; i < origins.size(); ++i)
+    {
+        const degrees lat = origins[i].latitude();
+        const degrees longitudeChange = normaliseDegrees(destinations[i].longitude() - origins[i].longitude());
+
+        BOOST_CHECK_CLOSE( destinations[i].latitude() , lat + Earth::latitudeSubtendedBy(north) , tolerance );
+        BOOST_CHECK_CLOSE( longitudeChange , Earth::longitudeSubtendedBy(east, lat) , tolerance );
+        BOOST_CHECK_EQUAL( destinations[i].elevation() , origins[i].elevation() );
+    }
+}
+
+BOOST_AUTO_TEST_CASE( OffsetPositionsAcrossTheAntiMeridian )
+{
+    const std::vector<Position> destinations = Earth::offsetPositions({Earth::EquatorialAntiMeridian}, 0, 1000);
+
+    BOOST_REQUIRE_EQUAL( destinations.size() , 1 );
+    BOOST_CHECK_CLOSE( destinations[0].longitude() , -180 + Earth::longitudeSubtendedBy(1000, 0) , tolerance );
+}
+
+BOOST_AUTO_TEST_CASE( OffsetPositionsBeyondAPole )
+{
+    BOOST_CHECK_THROW( Earth::offsetPositions({Position(89.99, 0, 0)}, 5000, 0) , std::invalid_argument );
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+/////////////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,170 @@
+#include <boost/test/unit_test.hpp>
+
+#include <random>
+#include <stdexcept>
+
+#include "earth.h"
+#include "geometry.h"
+#include "fix-filter.h"
+#include "test-helpers.h"
+
+using namespace GPS;
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_SUITE( FixFilterTests )
+
+// Moving east from the City Campus at 10 metres per second.
+Position truePosition(double time)
+{
+    return displaced(Earth::CityCampus, 0, time * 10);
+}
+
+BOOST_AUTO_TEST_CASE( FirstFix )
+{
+    FixFilter filter;
+    const std::optional<Position> first = filter.add(Earth::CliftonCampus, 0);
+
+    BOOST_REQUIRE( first );
+    BOOST_CHECK_EQUAL( first->latitude() , Earth::CliftonCampus.latitude() );
+    BOOST_CHECK_EQUAL( first->longitude() , Earth::CliftonCampus.longitude() );
+    BOOST_CHECK_EQUAL( first->elevation() , Earth::CliftonCampus.elevation() );
+    BOOST_CHECK_EQUAL( filter.acceptedCount() , 1 );
+}
+
+BOOST_AUTO_TEST_CASE( RejectsJumps )
+{
+    FixFilter filter;
+    for (int t = 0; t < 20; ++t) BOOST_CHECK( filter.add(truePosition(t), t) );
+
+    BOOST_CHECK( ! filter.add(displaced(truePosition(20), 5000, 0), 20) );
+    BOOST_CHECK( ! filter.add(Earth::Pontianak, 21) );
+    BOOST_CHECK( filter.add(truePosition(22), 22) );
+
+    BOOST_CHECK_EQUAL( filter.acceptedCount() , 21 );
+    BOOST_CHECK_EQUAL( filter.rejectedCount() , 2 );
+}
+
+BOOST_AUTO_TEST_CASE( RejectsEarlierFixes )
+{
+    FixFilter filter;
+    filter.add(truePosition(10), 10);
+
+    BOOST_CHECK( ! filter.add(truePosition(10), 9) );
+    BOOST_CHECK( filter.add(truePosition(10), 10) );
+}
+
+BOOST_AUTO_TEST_CASE( RestartsAfterConsecutiveRejections )
+{
+    FilterOptions options;
+    options.maxConsecutiveRejections = 3;
+    FixFilter filter(options);
+    filter.add(Earth::CliftonCampus, 0);
+
+    BOOST_CHECK( ! filter.add(Earth::Pontianak, 1) );
+    BOOST_CHECK( ! filter.add(Earth::Pontianak, 2) );
+    BOOST_CHECK( ! filter.add(Earth::Pontianak, 3) );
+
+    const std::optional<Position> restarted = filter.add(Earth::Pontianak, 4);
+    BOOST_REQUIRE( restarted );
+    BOOST_CHECK_EQUAL( restarted->longitude() , Earth::Pontianak.longitude() );
+}
+
+/* After the filter has settled, the filtered Positions are nearer the truth than the fixes,
+ * especially when the filter is told that the receiver hardly accelerates.
+ */
+void checkSmoothing(double accelerationNoise, double expectedErrorRatio)
+{
+    std::mt19937_64 random(41);
+    std::normal_distribution<metres> noise(0, 10);
+
+    FilterOptions options;
+    options.accelerationNoise = accelerationNoise;
+    FixFilter filter(options);
+    metres fixError = 0, filteredError = 0;
+    for (int t = 0; t < 300; ++t)
+    {
+        const Position fix = displaced(truePosition(t), noise(random), noise(random));
+        const std::optional<Position> filtered = filter.add(fix, t);
+        BOOST_REQUIRE( filtered );
+        if (t >= 50)
+        {
+            fixError += Position::horizontalDistanceBetween(fix, truePosition(t));
+            filteredError += Position::horizontalDistanceBetween(*filtered, truePosition(t));
+        }
+    }
+    BOOST_CHECK_LT( filteredError , fixError * expectedErrorRatio );
+}
+
+BOOST_AUTO_TEST_CASE( SmoothsNoise )
+{
+    checkSmoothing(FilterOptions().accelerationNoise, 0.8);
+    checkSmoothing(0.1, 0.4);
+}
+
+BOOST_AUTO_TEST_CASE( AcrossAntiMeridian )
+{
+    FixFilter filter;
+    degrees lon = 179.99;
+    for (int t = 0; t < 20; ++t)
+    {
+        const std::optional<Position> filtered = filter.add(Position(0, normaliseDegrees(lon), 0), t);
+        BOOST_REQUIRE( filtered );
+        BOOST_CHECK_LT( Position::horizontalDistanceBetween(*filtered, Position(0, normaliseDegrees(lon), 0)) , 1 );
+        lon += 0.0001;
+    }
+}
+
+// Filtering a batch gives the same results as adding its fixes one by one.
+BOOST_AUTO_TEST_CASE( BatchMatchesSingleFixes )
+{
+    std::mt19937_64 random(4141);
+    std::normal_distribution<metres> noise(0, 10);
+    std::uniform_int_distribution<int> spikeChance(0, 19);
+
+    Track fixes;
+    for (int t = 0; t < 500; ++t)
+    {
+        const bool spike = spikeChance(random) == 0;
+        fixes.append(displaced(truePosition(t), noise(random) + (spike ? 3000 : 0), noise(random)), t);
+    }
+
+    FixFilter single, batch;
+    Track expected;
+    for (std::size_t i = 0; i < fixes.size(); ++i)
+    {
+        const std::optional<Position> filtered = single.add(fixes.position(i), fixes.time(i));
+        if (filtered) expected.append(*filtered, fixes.time(i));
+    }
+
+    Track actual;
+    for (std::size_t start = 0; start < fixes.size(); start += 64)
+    {
+        Track piece;
+        for (std::size_t i = start; i < std::min(start + 64, fixes.size()); ++i) piece.append(fixes.position(i), fixes.time(i));
+        const Track filtered = batch.add(piece);
+        for (std::size_t i = 0; i < filtered.size(); ++i) actual.append(filtered.position(i), filtered.time(i));
+    }
+
+    BOOST_CHECK_GT( single.rejectedCount() , 0 );
+    BOOST_CHECK_EQUAL( batch.rejectedCount() , single.rejectedCount() );
+    BOOST_REQUIRE_EQUAL( actual.size() , expected.size() );
+    BOOST_CHECK( actual.latitudes() == expected.latitudes() );
+    BOOST_CHECK( actual.longitudes() == expected.longitudes() );
+    BOOST_CHECK( actual.times() == expected.times() );
+}
+
+BOOST_AUTO_TEST_CASE( InvalidOptions )
+{
+    FilterOptions options;
+    options.maxSpeed = 0;
+    BOOST_CHECK_THROW( FixFilter{options}, std::invalid_argument );
+
+    options = FilterOptions();
+    options.measurementNoise = -1;
+    BOOST_CHECK_THROW( FixFilter{options}, std::invalid_argument );
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+/////////////////////////////////////////////////////////////////////////////////////////
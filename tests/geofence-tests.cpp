@@ -0,0 +1,217 @@
+#include <boost/test/unit_test.hpp>
+
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+#include "earth.h"
+#include "geofence.h"
+#include "geometry.h"
+
+using namespace GPS;
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_SUITE( GeofenceTests )
+
+using Type = GeofenceEvent::Type;
+
+void checkEvent(const GeofenceEvent & event, Type type, SubjectId subject, ZoneId zone, double time)
+{
+    BOOST_CHECK( event.type == type );
+    BOOST_CHECK_EQUAL( event.subject , subject );
+    BOOST_CHECK_EQUAL( event.zone , zone );
+    BOOST_CHECK_EQUAL( event.time , time );
+}
+
+// A Position the specified distance north of another (along a meridian).
+Position northOf(Position p, metres distance)
+{
+    return Position(p.latitude() + radToDeg(distance / Earth::meanRadius), p.longitude(), 0);
+}
+
+BOOST_AUTO_TEST_SUITE( Zones )
+
+BOOST_AUTO_TEST_CASE( Circle )
+{
+    Geofence geofence;
+    const ZoneId campus = geofence.addCircle(Earth::CliftonCampus, 500);
+
+    BOOST_CHECK_EQUAL( geofence.zoneCount() , 1 );
+    BOOST_CHECK( geofence.zonesContaining(Earth::CliftonCampus) == std::vector<ZoneId>{campus} );
+    BOOST_CHECK( geofence.zonesContaining(northOf(Earth::CliftonCampus, 490)) == std::vector<ZoneId>{campus} );
+    BOOST_CHECK( geofence.zonesContaining(northOf(Earth::CliftonCampus, 510)).empty() );
+    BOOST_CHECK( geofence.zonesContaining(Earth::CityCampus).empty() );
+}
+
+BOOST_AUTO_TEST_CASE( OverlappingCircles )
+{
+    Geofence geofence;
+    const ZoneId clifton = geofence.addCircle(Earth::CliftonCampus, 1000);
+    const ZoneId city = geofence.addCircle(Earth::CityCampus, 1000);
+    const ZoneId nottingham = geofence.addCircle(Earth::CityCampus, 10000);
+
+    BOOST_CHECK( geofence.zonesContaining(Earth::CliftonCampus) == (std::vector<ZoneId>{clifton, nottingham}) );
+    BOOST_CHECK( geofence.zonesContaining(Earth::CityCampus) == (std::vector<ZoneId>{city, nottingham}) );
+}
+
+BOOST_AUTO_TEST_CASE( ConcavePolygon )
+{
+    // A 'U' shape: a 2x2 square with a notch taken out of the top.
+    Geofence geofence;
+    const ZoneId u = geofence.addPolygon({ Position(52,-2,0), Position(52,0,0), Position(54,0,0), Position(54,-0.5,0),
+                                           Position(53,-0.5,0), Position(53,-1.5,0), Position(54,-1.5,0), Position(54,-2,0) });
+
+    BOOST_CHECK( geofence.zonesContaining(Position(52.5,-1,0)) == std::vector<ZoneId>{u} );
+    BOOST_CHECK( geofence.zonesContaining(Position(53.5,-1.8,0)) == std::vector<ZoneId>{u} );
+    BOOST_CHECK( geofence.zonesContaining(Position(53.5,-0.2,0)) == std::vector<ZoneId>{u} );
+    BOOST_CHECK( geofence.zonesContaining(Position(53.5,-1,0)).empty() );
+    BOOST_CHECK( geofence.zonesContaining(Position(51.9,-1,0)).empty() );
+}
+
+BOOST_AUTO_TEST_CASE( CircleAcrossAntiMeridian )
+{
+    Geofence geofence;
+    const ZoneId zone = geofence.addCircle(Position(0,179.99,0), 5000);
+
+    BOOST_CHECK( geofence.zonesContaining(Position(0,180,0)) == std::vector<ZoneId>{zone} );
+    BOOST_CHECK( geofence.zonesContaining(Position(0,-179.99,0)) == std::vector<ZoneId>{zone} );
+    BOOST_CHECK( geofence.zonesContaining(Position(0,-179.9,0)).empty() );
+}
+
+BOOST_AUTO_TEST_CASE( CircleAroundPole )
+{
+    Geofence geofence;
+    const ZoneId zone = geofence.addCircle(Earth::NorthPole, 100000);
+
+    BOOST_CHECK( geofence.zonesContaining(Position(89.5,0,0)) == std::vector<ZoneId>{zone} );
+    BOOST_CHECK( geofence.zonesContaining(Position(89.5,-135,0)) == std::vector<ZoneId>{zone} );
+    BOOST_CHECK( geofence.zonesContaining(Position(89,45,0)).empty() );
+}
+
+BOOST_AUTO_TEST_CASE( InvalidZones )
+{
+    Geofence geofence;
+
+    BOOST_CHECK_THROW( geofence.addCircle(Earth::CityCampus, 0), std::invalid_argument );
+    BOOST_CHECK_THROW( geofence.addCircle(Earth::CityCampus, Earth::polarCircumference), std::invalid_argument );
+    BOOST_CHECK_THROW( geofence.addPolygon({Earth::CityCampus, Earth::CliftonCampus}), std::invalid_argument );
+    BOOST_CHECK_THROW( geofence.addPolygon({Position(0,-170,0), Position(0,170,0), Position(1,170,0)}), std::invalid_argument );
+    BOOST_CHECK_EQUAL( geofence.zoneCount() , 0 );
+
+    BOOST_CHECK_THROW( Geofence(-1), std::invalid_argument );
+    BOOST_CHECK_THROW( Geofence(60, 0), std::invalid_argument );
+    BOOST_CHECK_THROW( Geofence(60, 91), std::invalid_argument );
+}
+
+// The index must find exactly the zones that testing every zone would find.
+BOOST_AUTO_TEST_CASE( IndexMatchesExhaustiveSearch )
+{
+    std::mt19937_64 random(2024);
+    std::uniform_real_distribution<degrees> latitude(52.5, 53.5), longitude(-1.7, -0.7);
+    std::uniform_real_distribution<metres> radius(50, 5000);
+
+    Geofence geofence;
+    std::vector<std::pair<Position,metres>> circles;
+    for (int i = 0; i < 20000; ++i)
+    {
+        circles.emplace_back(Position(latitude(random), longitude(random), 0), radius(random));
+        geofence.addCircle(circles.back().first, circles.back().second);
+    }
+
+    for (int i = 0; i < 200; ++i)
+    {
+        const Position p(latitude(random), longitude(random), 0);
+        std::vector<ZoneId> expected;
+        for (ZoneId id = 0; id < circles.size(); ++id)
+        {
+            if (Position::horizontalDistanceBetween(circles[id].first, p) <= circles[id].second) expected.push_back(id);
+        }
+        BOOST_CHECK( geofence.zonesContaining(p) == expected );
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_SUITE( Events )
+
+BOOST_AUTO_TEST_CASE( EnterDwellExit )
+{
+    Geofence geofence(30);
+    const ZoneId campus = geofence.addCircle(Earth::CityCampus, 200);
+    const Position outside = northOf(Earth::CityCampus, 300);
+    const SubjectId bus = 7;
+
+    const std::vector<GeofenceEvent> events = geofence.update({
+        {bus, outside, 0}, {bus, Earth::CityCampus, 10}, {bus, Earth::CityCampus, 20},
+        {bus, Earth::CityCampus, 40}, {bus, Earth::CityCampus, 50}, {bus, outside, 60} });
+
+    BOOST_REQUIRE_EQUAL( events.size() , 3 );
+    checkEvent(events[0], Type::enter, bus, campus, 10);
+    checkEvent(events[1], Type::dwell, bus, campus, 40);
+    checkEvent(events[2], Type::exit, bus, campus, 60);
+    BOOST_CHECK( geofence.zonesOf(bus).empty() );
+}
+
+BOOST_AUTO_TEST_CASE( StateCarriesAcrossBatches )
+{
+    Geofence geofence(30);
+    const ZoneId campus = geofence.addCircle(Earth::CliftonCampus, 200);
+    const SubjectId bus = 1;
+
+    BOOST_REQUIRE_EQUAL( geofence.update({{bus, Earth::CliftonCampus, 100}}).size() , 1 );
+    BOOST_CHECK( geofence.zonesOf(bus) == std::vector<ZoneId>{campus} );
+
+    const std::vector<GeofenceEvent> events = geofence.update({{bus, Earth::CliftonCampus, 130}});
+    BOOST_REQUIRE_EQUAL( events.size() , 1 );
+    checkEvent(events[0], Type::dwell, bus, campus, 130);
+}
+
+BOOST_AUTO_TEST_CASE( SubjectsAreIndependent )
+{
+    Geofence geofence;
+    const ZoneId clifton = geofence.addCircle(Earth::CliftonCampus, 200);
+    const ZoneId city = geofence.addCircle(Earth::CityCampus, 200);
+
+    const std::vector<GeofenceEvent> events = geofence.update({
+        {1, Earth::CliftonCampus, 0}, {2, Earth::CityCampus, 0},
+        {1, Earth::CityCampus, 1}, {2, Earth::CityCampus, 1} });
+
+    BOOST_REQUIRE_EQUAL( events.size() , 4 );
+    checkEvent(events[0], Type::enter, 1, clifton, 0);
+    checkEvent(events[1], Type::enter, 2, city, 0);
+    checkEvent(events[2], Type::exit, 1, clifton, 1);
+    checkEvent(events[3], Type::enter, 1, city, 1);
+}
+
+BOOST_AUTO_TEST_CASE( ZeroDwellTime )
+{
+    Geofence geofence(0);
+    const ZoneId campus = geofence.addCircle(Earth::CityCampus, 200);
+
+    const std::vector<GeofenceEvent> events = geofence.update({{3, Earth::CityCampus, 5}, {3, Earth::CityCampus, 6}});
+
+    BOOST_REQUIRE_EQUAL( events.size() , 2 );
+    checkEvent(events[0], Type::enter, 3, campus, 5);
+    checkEvent(events[1], Type::dwell, 3, campus, 5);
+}
+
+BOOST_AUTO_TEST_CASE( Forget )
+{
+    Geofence geofence;
+    geofence.addCircle(Earth::CityCampus, 200);
+
+    geofence.update({{4, Earth::CityCampus, 0}});
+    geofence.forget(4);
+
+    BOOST_CHECK( geofence.zonesOf(4).empty() );
+    BOOST_CHECK( geofence.update({{4, Earth::CliftonCampus, 1}}).empty() );
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+BOOST_AUTO_TEST_SUITE_END()
+
+/////////////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,158 @@
+#include <boost/test/unit_test.hpp>
+
+#include <algorithm>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+
+#include "dataFiles.h"
+#include "earth.h"
+#include "landmarks.h"
+
+using namespace GPS;
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_SUITE( LandmarkTests )
+
+BOOST_AUTO_TEST_SUITE( ReadLandmarks )
+
+BOOST_AUTO_TEST_CASE( ValidLines )
+{
+    std::istringstream text("# depots\n"
+                            "Clifton Depot, 52.9125, -1.184, 58\n"
+                            "\n"
+                            "City Depot,52.958,-1.154\r\n");
+
+    const std::vector<Landmark> landmarks = readLandmarks(text);
+
+    BOOST_REQUIRE_EQUAL( landmarks.size() , 2 );
+    BOOST_CHECK_EQUAL( landmarks[0].name , "Clifton Depot" );
+    BOOST_CHECK_EQUAL( landmarks[0].position.latitude() , 52.9125 );
+    BOOST_CHECK_EQUAL( landmarks[0].position.longitude() , -1.184 );
+    BOOST_CHECK_EQUAL( landmarks[0].position.elevation() , 58 );
+    BOOST_CHECK_EQUAL( landmarks[1].name , "City Depot" );
+    BOOST_CHECK_EQUAL( landmarks[1].position.elevation() , 0 );
+}
+
+BOOST_AUTO_TEST_CASE( IllFormedLines )
+{
+    for (const std::string line : { "Depot,52.9", "Depot,52.9,-1.1,0,0", ",52.9,-1.1",
+                                    "Depot,52.9N,-1.1", "Depot,91,0", "Depot,0,-181" })
+    {
+        std::istringstream text("Fine,0,0\n" + line + "\n");
+        BOOST_CHECK_THROW( readLandmarks(text), std::domain_error );
+    }
+}
+
+BOOST_AUTO_TEST_CASE( DataFile )
+{
+    const std::vector<Landmark> landmarks = readLandmarks(DataFiles::LandmarksDir + "earth.csv");
+
+    BOOST_REQUIRE_EQUAL( landmarks.size() , 6 );
+    BOOST_CHECK_EQUAL( landmarks[3].name , "CliftonCampus" );
+    BOOST_CHECK_EQUAL( landmarks[3].position.latitude() , Earth::CliftonCampus.latitude() );
+    BOOST_CHECK_EQUAL( landmarks[3].position.longitude() , Earth::CliftonCampus.longitude() );
+}
+
+BOOST_AUTO_TEST_CASE( MissingFile )
+{
+    BOOST_CHECK_THROW( readLandmarks(DataFiles::LandmarksDir + "nonexistent.csv"), std::invalid_argument );
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_SUITE( Nearest )
+
+const metres absoluteAccuracy = 0.001;
+
+BOOST_AUTO_TEST_CASE( EarthLandmarks )
+{
+    const LandmarkIndex index(readLandmarks(DataFiles::LandmarksDir + "earth.csv"));
+
+    const LandmarkIndex::Match clifton = index.nearest(Position(52.91, -1.18, 0));
+    BOOST_CHECK_EQUAL( index.landmarks()[clifton.landmark].name , "CliftonCampus" );
+    BOOST_CHECK_SMALL( clifton.distance - Position::horizontalDistanceBetween(Earth::CliftonCampus, Position(52.91, -1.18, 0)),
+                       absoluteAccuracy );
+
+    // Across the anti-meridian.
+    const LandmarkIndex::Match antiMeridian = index.nearest(Position(1, -179, 0));
+    BOOST_CHECK_EQUAL( index.landmarks()[antiMeridian.landmark].name , "EquatorialAntiMeridian" );
+}
+
+BOOST_AUTO_TEST_CASE( KNearest )
+{
+    const LandmarkIndex index(readLandmarks(DataFiles::LandmarksDir + "earth.csv"));
+
+    const std::vector<LandmarkIndex::Match> matches = index.nearest(Earth::CityCampus, 3);
+
+    BOOST_REQUIRE_EQUAL( matches.size() , 3 );
+    BOOST_CHECK_EQUAL( index.landmarks()[matches[0].landmark].name , "CityCampus" );
+    BOOST_CHECK_SMALL( matches[0].distance , absoluteAccuracy );
+    BOOST_CHECK_EQUAL( index.landmarks()[matches[1].landmark].name , "CliftonCampus" );
+    BOOST_CHECK_EQUAL( index.landmarks()[matches[2].landmark].name , "NorthPole" );
+
+    BOOST_CHECK_EQUAL( index.nearest(Earth::CityCampus, 10).size() , 6 );
+    BOOST_CHECK( index.nearest(Earth::CityCampus, 0).empty() );
+}
+
+BOOST_AUTO_TEST_CASE( NoLandmarks )
+{
+    const LandmarkIndex index({});
+
+    BOOST_CHECK_THROW( index.nearest(Earth::CityCampus), std::domain_error );
+    BOOST_CHECK( index.nearest(Earth::CityCampus, 1).empty() );
+    BOOST_CHECK( index.nearestToEach({}).empty() );
+}
+
+// The tree must find the same landmarks as computing the distance to every landmark.
+BOOST_AUTO_TEST_CASE( MatchesExhaustiveSearch )
+{
+    std::mt19937_64 random(39);
+    std::uniform_real_distribution<degrees> latitude(-90, 90), longitude(-180, 180);
+    std::uniform_real_distribution<degrees> localLatitude(52.8, 53.1), localLongitude(-1.3, -1.0);
+
+    // Depots spread around the world, with a cluster in Nottingham.
+    std::vector<Landmark> depots;
+    for (int i = 0; i < 2000; ++i)
+    {
+        const bool local = i % 2 == 0;
+        depots.push_back({"Depot " + std::to_string(i),
+                          local ? Position(localLatitude(random), localLongitude(random), 0)
+                                : Position(latitude(random), longitude(random), 0)});
+    }
+    const LandmarkIndex index(depots);
+
+    std::vector<Position> fixes;
+    for (int i = 0; i < 100; ++i)
+    {
+        fixes.push_back(i % 2 == 0 ? Position(localLatitude(random), localLongitude(random), 0)
+                                   : Position(latitude(random), longitude(random), 0));
+    }
+    const std::vector<LandmarkIndex::Match> nearestToEach = index.nearestToEach(fixes);
+    BOOST_REQUIRE_EQUAL( nearestToEach.size() , fixes.size() );
+
+    const std::size_t k = 5;
+    for (std::size_t f = 0; f < fixes.size(); ++f)
+    {
+        std::vector<metres> distances;
+        for (const Landmark & depot : depots) distances.push_back(Position::horizontalDistanceBetween(depot.position, fixes[f]));
+        std::sort(distances.begin(), distances.end());
+
+        const std::vector<LandmarkIndex::Match> matches = index.nearest(fixes[f], k);
+        BOOST_REQUIRE_EQUAL( matches.size() , k );
+        for (std::size_t i = 0; i < k; ++i)
+        {
+            BOOST_CHECK_CLOSE( matches[i].distance , distances[i] , 1e-6 );
+        }
+        BOOST_CHECK_CLOSE( nearestToEach[f].distance , distances[0] , 1e-6 );
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+BOOST_AUTO_TEST_SUITE_END()
+
+/////////////////////////////////////////////////////////////////////////////////////////
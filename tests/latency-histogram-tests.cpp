@@ -0,0 +1,99 @@
+#include <boost/test/unit_test.hpp>
+
+#include <chrono>
+#include <stdexcept>
+
+#include "latency-histogram.h"
+
+using namespace GPS;
+using namespace std::chrono;
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_SUITE( LatencyHistogramTests )
+
+// Reported percentiles are rounded up to the end of their bucket, at most 1/16 above.
+void checkWithinBucket(nanoseconds reported, nanoseconds actual)
+{
+    BOOST_CHECK_GE( reported.count() , actual.count() );
+    BOOST_CHECK_LE( reported.count() , actual.count() + actual.count() / 16 );
+}
+
+BOOST_AUTO_TEST_CASE( Empty )
+{
+    LatencyHistogram histogram;
+
+    BOOST_CHECK_EQUAL( histogram.count() , 0 );
+    BOOST_CHECK_EQUAL( histogram.min().count() , 0 );
+    BOOST_CHECK_EQUAL( histogram.max().count() , 0 );
+    BOOST_CHECK_EQUAL( histogram.mean().count() , 0 );
+    BOOST_CHECK_EQUAL( histogram.percentile(50).count() , 0 );
+}
+
+BOOST_AUTO_TEST_CASE( SmallValuesAreExact )
+{
+    LatencyHistogram histogram;
+    for (int ns = 0; ns < 10; ++ns) histogram.record(nanoseconds(ns));
+
+    BOOST_CHECK_EQUAL( histogram.count() , 10 );
+    BOOST_CHECK_EQUAL( histogram.min().count() , 0 );
+    BOOST_CHECK_EQUAL( histogram.max().count() , 9 );
+    BOOST_CHECK_EQUAL( histogram.percentile(50).count() , 4 );
+    BOOST_CHECK_EQUAL( histogram.percentile(100).count() , 9 );
+}
+
+BOOST_AUTO_TEST_CASE( Percentiles )
+{
+    LatencyHistogram histogram;
+    for (int us = 1; us <= 1000; ++us) histogram.record(microseconds(us));
+
+    BOOST_CHECK_EQUAL( histogram.count() , 1000 );
+    BOOST_CHECK_EQUAL( histogram.min().count() , 1000 );
+    BOOST_CHECK_EQUAL( histogram.max().count() , 1000000 );
+    BOOST_CHECK_EQUAL( histogram.mean().count() , 500500 );
+    checkWithinBucket( histogram.percentile(50) , microseconds(500) );
+    checkWithinBucket( histogram.percentile(90) , microseconds(900) );
+    checkWithinBucket( histogram.percentile(99) , microseconds(990) );
+    BOOST_CHECK_EQUAL( histogram.percentile(100).count() , 1000000 );
+    checkWithinBucket( histogram.percentile(0) , microseconds(1) );
+}
+
+BOOST_AUTO_TEST_CASE( VeryLargeAndNegativeDurations )
+{
+    LatencyHistogram histogram;
+    histogram.record(hours(24 * 365));
+    histogram.record(nanoseconds(-5));
+
+    BOOST_CHECK_EQUAL( histogram.min().count() , 0 );
+    BOOST_CHECK( histogram.max() == hours(24 * 365) );
+    BOOST_CHECK( histogram.percentile(100) == hours(24 * 365) );
+    BOOST_CHECK_EQUAL( histogram.percentile(50).count() , 0 );
+}
+
+BOOST_AUTO_TEST_CASE( Merge )
+{
+    LatencyHistogram first, second;
+    first.record(microseconds(10));
+    second.record(microseconds(30));
+    second.record(microseconds(20));
+    first.merge(second);
+
+    BOOST_CHECK_EQUAL( first.count() , 3 );
+    BOOST_CHECK_EQUAL( first.min().count() , 10000 );
+    BOOST_CHECK_EQUAL( first.max().count() , 30000 );
+    BOOST_CHECK_EQUAL( first.mean().count() , 20000 );
+    checkWithinBucket( first.percentile(50) , microseconds(20) );
+}
+
+BOOST_AUTO_TEST_CASE( InvalidPercentages )
+{
+    LatencyHistogram histogram;
+    histogram.record(microseconds(1));
+
+    BOOST_CHECK_THROW( histogram.percentile(-1) , std::domain_error );
+    BOOST_CHECK_THROW( histogram.percentile(100.5) , std::domain_error );
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+/////////////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,202 @@
+#include <boost/test/unit_test.hpp>
+
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <zlib.h>
+#ifdef GPS_HAVE_ZSTD
+#include <zstd.h>
+#endif
+
+#include "dataFiles.h"
+#include "nmea-parser.h"
+#include "compressed-input.h"
+#include "../test-helpers.h"
+
+using namespace GPS;
+using namespace NMEA;
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_SUITE( CompressedInput )
+
+// Writes the contents as a gzip file, split into the specified number of gzip members.
+std::string writeGzipFile(std::string filename, const std::string & contents, unsigned int members = 1)
+{
+    const std::string filepath = (std::filesystem::temp_directory_path() / filename).string();
+    std::ofstream(filepath, std::ios::binary | std::ios::trunc);
+
+    const std::size_t memberSize = contents.size() / members + 1;
+    for (std::size_t start = 0; start < contents.size(); start += memberSize)
+    {
+        gzFile gz = gzopen(filepath.c_str(), "ab");
+        BOOST_REQUIRE( gz != nullptr );
+        const std::string member = contents.substr(start, memberSize);
+        gzwrite(gz, member.data(), member.size());
+        gzclose(gz);
+    }
+    return filepath;
+}
+
+#ifdef GPS_HAVE_ZSTD
+std::string writeZstdFile(std::string filename, const std::string & contents)
+{
+    const std::string filepath = (std::filesystem::temp_directory_path() / filename).string();
+    std::string compressed(ZSTD_compressBound(contents.size()), '\0');
+    const std::size_t size = ZSTD_compress(compressed.data(), compressed.size(), contents.data(), contents.size(), 19);
+    BOOST_REQUIRE( ! ZSTD_isError(size) );
+    std::ofstream(filepath, std::ios::binary | std::ios::trunc).write(compressed.data(), size);
+    return filepath;
+}
+#endif
+
+BOOST_AUTO_TEST_CASE( DetectUncompressed )
+{
+    BOOST_CHECK( detectCompression(DataFiles::NMEADir + "gll.log") == Compression::none );
+}
+
+BOOST_AUTO_TEST_CASE( DetectGzip )
+{
+    const std::string filepath = writeGzipFile("gps-detect.log.gz", "$GPGLL,5425.31,N,107.03,W,82610*69\n");
+
+    BOOST_CHECK( detectCompression(filepath) == Compression::gzip );
+
+    std::filesystem::remove(filepath);
+}
+
+BOOST_AUTO_TEST_CASE( DetectFromStreamLeavesItUnread )
+{
+    const std::string gzipMagic = "\x1F\x8B\x08\x00";
+    std::istringstream compressed(gzipMagic + "rest");
+    BOOST_CHECK( detectCompression(compressed) == Compression::gzip );
+    const std::string afterDetection(std::istreambuf_iterator<char>(compressed), {});
+    BOOST_CHECK_EQUAL( afterDetection, gzipMagic + "rest" );
+
+    std::istringstream shortStream("$");
+    BOOST_CHECK( detectCompression(shortStream) == Compression::none );
+    BOOST_CHECK( shortStream.good() );
+    BOOST_CHECK_EQUAL( shortStream.get(), '$' );
+}
+
+BOOST_AUTO_TEST_CASE( DetectMissingFile )
+{
+    BOOST_CHECK_THROW( detectCompression(DataFiles::NMEADir + "no-such-file.log") , std::invalid_argument );
+}
+
+BOOST_AUTO_TEST_CASE( UncompressedFile )
+{
+    std::ifstream sentences(DataFiles::NMEADir + "gga_rmc-1.log");
+    const std::vector<Position> expected = readSentences(sentences);
+
+    checkSamePositions(readSentencesFromFile(DataFiles::NMEADir + "gga_rmc-1.log"), expected);
+}
+
+BOOST_AUTO_TEST_CASE( GzipFile )
+{
+    const std::string contents = readNMEAfile("gga_rmc-2.log");
+    const std::string filepath = writeGzipFile("gps-gga_rmc-2.log.gz", contents);
+    std::istringstream sentences(contents);
+    const std::vector<Position> expected = readSentences(sentences);
+
+    checkSamePositions(readSentencesFromFile(filepath), expected);
+
+    std::filesystem::remove(filepath);
+}
+
+BOOST_AUTO_TEST_CASE( MultiMemberGzipFile )
+{
+    const std::string contents = readNMEAfile("gll.log");
+    const std::string filepath = writeGzipFile("gps-gll-members.log.gz", contents, 5);
+    std::istringstream sentences(contents);
+    const std::vector<Position> expected = readSentences(sentences);
+
+    checkSamePositions(readSentencesFromFile(filepath), expected);
+
+    std::filesystem::remove(filepath);
+}
+
+BOOST_AUTO_TEST_CASE( TruncatedGzipFile )
+{
+    const std::string contents = readNMEAfile("gll.log");
+    const std::string filepath = writeGzipFile("gps-truncated.log.gz", contents);
+    const std::uintmax_t fullSize = std::filesystem::file_size(filepath);
+    std::filesystem::resize_file(filepath, fullSize / 2);
+
+    BOOST_CHECK_THROW( readSentencesFromFile(filepath) , std::runtime_error );
+
+    std::filesystem::remove(filepath);
+}
+
+#ifdef GPS_HAVE_ZSTD
+BOOST_AUTO_TEST_CASE( DetectZstd )
+{
+    const std::string filepath = writeZstdFile("gps-detect.log.zst", "$GPGLL,5425.31,N,107.03,W,82610*69\n");
+
+    BOOST_CHECK( detectCompression(filepath) == Compression::zstd );
+
+    std::filesystem::remove(filepath);
+}
+
+BOOST_AUTO_TEST_CASE( ZstdFile )
+{
+    const std::string contents = readNMEAfile("gga_rmc-2.log");
+    const std::string filepath = writeZstdFile("gps-gga_rmc-2.log.zst", contents);
+    std::istringstream sentences(contents);
+    const std::vector<Position> expected = readSentences(sentences);
+
+    checkSamePositions(readSentencesFromFile(filepath), expected);
+
+    std::filesystem::remove(filepath);
+}
+
+BOOST_AUTO_TEST_CASE( HighlyCompressibleZstdFile )
+{
+    // Decompresses to many output chunks from a single block of input.
+    const std::string sentence = "$GPGLL,5425.31,N,107.03,W,82610*69\n";
+    std::string contents;
+    for (int i = 0; i < 50000; ++i) contents += sentence;
+    const std::string filepath = writeZstdFile("gps-repeated.log.zst", contents);
+
+    BOOST_CHECK_EQUAL( readSentencesFromFile(filepath).size() , 50000 );
+
+    std::filesystem::remove(filepath);
+}
+
+BOOST_AUTO_TEST_CASE( TruncatedZstdFile )
+{
+    const std::string contents = readNMEAfile("gll.log");
+    const std::string filepath = writeZstdFile("gps-truncated.log.zst", contents);
+    const std::uintmax_t fullSize = std::filesystem::file_size(filepath);
+    std::filesystem::resize_file(filepath, fullSize / 2);
+
+    BOOST_CHECK_THROW( readSentencesFromFile(filepath) , std::runtime_error );
+
+    std::filesystem::remove(filepath);
+}
+#endif
+
+BOOST_AUTO_TEST_CASE( ReaderStopsEarly )
+{
+    const std::string contents = readNMEAfile("gll.log");
+    const std::string filepath = writeGzipFile("gps-early.log.gz", contents);
+    std::ifstream file(filepath, std::ios::binary);
+
+    {
+        DecompressingStreamBuf buffer(file, Compression::gzip);
+        std::istream decompressed(&buffer);
+        std::string firstLine;
+        std::getline(decompressed, firstLine);
+        BOOST_CHECK_EQUAL( firstLine , "$GPGLL,5425.32,N,107.11,W,82319*65" );
+    } // must not hang waiting for the decompression thread
+
+    std::filesystem::remove(filepath);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+/////////////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,193 @@
+#include <boost/test/unit_test.hpp>
+
+#include <chrono>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <fcntl.h>
+#include <stdlib.h>
+#include <termios.h>
+#include <unistd.h>
+
+#include "dataFiles.h"
+#include "epoll-reader.h"
+
+using namespace GPS;
+using namespace NMEA;
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_SUITE( EpollReaderTests )
+
+const std::string validGLLSentence = "$GPGLL,5425.31,N,107.03,W,82610*69";
+const std::string validRMCSentence = "$GPRMC,113922.000,A,3722.5993,N,00559.2458,W,0.000,0.00,150914,,A*62";
+const std::string validGGASentence = "$GPGGA,114530.000,3722.6279,N,00559.1566,W,1,0,,1.0,M,,M,,*4E";
+
+/* A pseudo-terminal pair standing in for a serial device: the test writes to the
+ * controlling side, and the reader reads from the device side (in raw mode, as a
+ * serial port would be configured).
+ */
+struct PseudoTerminal
+{
+    int controller = -1;
+    int device = -1;
+
+    PseudoTerminal()
+    {
+        controller = posix_openpt(O_RDWR | O_NOCTTY);
+        BOOST_REQUIRE( controller >= 0 );
+        BOOST_REQUIRE( grantpt(controller) == 0 && unlockpt(controller) == 0 );
+        device = open(ptsname(controller), O_RDWR | O_NOCTTY);
+        BOOST_REQUIRE( device >= 0 );
+
+        termios settings;
+        tcgetattr(device, &settings);
+        cfmakeraw(&settings);
+        tcsetattr(device, TCSANOW, &settings);
+    }
+
+    ~PseudoTerminal()
+    {
+        if (device >= 0) close(device);
+        if (controller >= 0) close(controller);
+    }
+
+    void send(const std::string & data)
+    {
+        BOOST_REQUIRE_EQUAL( write(controller, data.data(), data.size()) , static_cast<ssize_t>(data.size()) );
+    }
+};
+
+// Poll until the expected number of Positions has arrived, or a second has passed.
+void pollFor(EpollReader & reader, const std::vector<Position> & received, std::size_t expected)
+{
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(1);
+    while (received.size() < expected && std::chrono::steady_clock::now() < deadline)
+    {
+        reader.poll(10);
+    }
+}
+
+BOOST_AUTO_TEST_CASE( PseudoTerminalSentences )
+{
+    PseudoTerminal pty;
+    std::vector<Position> received;
+    EpollReader reader([&received](int, const Position & p) { received.push_back(p); });
+    reader.add(pty.device);
+
+    pty.send(validGLLSentence + "\r\n" + validRMCSentence + "\r\n");
+    pollFor(reader, received, 2);
+
+    BOOST_CHECK_EQUAL( received.size() , 2u );
+}
+
+BOOST_AUTO_TEST_CASE( SentenceSplitAcrossWrites )
+{
+    PseudoTerminal pty;
+    std::vector<Position> received;
+    EpollReader reader([&received](int, const Position & p) { received.push_back(p); });
+    reader.add(pty.device);
+
+    pty.send("@header\r\n" + validGGASentence.substr(0, 30));
+    reader.poll(100);
+    BOOST_CHECK_EQUAL( received.size() , 0u );
+
+    pty.send(validGGASentence.substr(30) + "\r\n");
+    pollFor(reader, received, 1);
+
+    BOOST_REQUIRE_EQUAL( received.size() , 1u );
+    BOOST_CHECK_CLOSE( received[0].elevation() , 1.0 , 0.0001 );
+}
+
+BOOST_AUTO_TEST_CASE( ManyDescriptors )
+{
+    std::vector<PseudoTerminal> ptys(8);
+    std::vector<int> counts(1024, 0);
+    std::vector<Position> received;
+    EpollReader reader([&](int fd, const Position & p) { ++counts[fd]; received.push_back(p); });
+    for (PseudoTerminal & pty : ptys) reader.add(pty.device);
+
+    BOOST_CHECK_EQUAL( reader.watchedCount() , ptys.size() );
+    for (PseudoTerminal & pty : ptys) pty.send(validGLLSentence + "\n" + validRMCSentence + "\n");
+    pollFor(reader, received, 2 * ptys.size());
+
+    for (PseudoTerminal & pty : ptys) BOOST_CHECK_EQUAL( counts[pty.device] , 2 );
+}
+
+BOOST_AUTO_TEST_CASE( PipeEndOfFile )
+{
+    int fds[2];
+    BOOST_REQUIRE( pipe(fds) == 0 );
+    std::vector<Position> received;
+    std::vector<int> closed;
+    EpollReader reader([&received](int, const Position & p) { received.push_back(p); },
+                       [&closed](int fd) { closed.push_back(fd); });
+    reader.add(fds[0]);
+
+    const std::string data = validGLLSentence + "\n" + validRMCSentence; // final line unterminated
+    BOOST_REQUIRE_EQUAL( write(fds[1], data.data(), data.size()) , static_cast<ssize_t>(data.size()) );
+    close(fds[1]);
+    reader.run(); // returns once the only descriptor has closed
+
+    BOOST_CHECK_EQUAL( received.size() , 2u );
+    BOOST_REQUIRE_EQUAL( closed.size() , 1u );
+    BOOST_CHECK_EQUAL( closed[0] , fds[0] );
+    BOOST_CHECK_EQUAL( reader.watchedCount() , 0u );
+    close(fds[0]);
+}
+
+BOOST_AUTO_TEST_CASE( StopFromAnotherThread )
+{
+    PseudoTerminal pty;
+    EpollReader reader([](int, const Position &) {});
+    reader.add(pty.device);
+
+    std::thread stopper([&reader]
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        reader.stop();
+    });
+    reader.run(); // would block indefinitely without stop()
+    stopper.join();
+
+    BOOST_CHECK_EQUAL( reader.watchedCount() , 1u );
+}
+
+BOOST_AUTO_TEST_CASE( StopBeforeRun )
+{
+    PseudoTerminal pty;
+    EpollReader reader([](int, const Position &) {});
+    reader.add(pty.device);
+
+    reader.stop();
+    reader.run(); // must not block, although nothing is written to the device
+
+    BOOST_CHECK_EQUAL( reader.watchedCount() , 1u );
+}
+
+BOOST_AUTO_TEST_CASE( FailedAddRestoresFlags )
+{
+    // Regular files cannot be watched with epoll.
+    const int fd = open((DataFiles::NMEADir + "gll.log").c_str(), O_RDONLY);
+    BOOST_REQUIRE( fd >= 0 );
+    EpollReader reader([](int, const Position &) {});
+
+    BOOST_CHECK_THROW( reader.add(fd) , std::system_error );
+    BOOST_CHECK_EQUAL( fcntl(fd, F_GETFL) & O_NONBLOCK , 0 );
+    BOOST_CHECK_EQUAL( reader.watchedCount() , 0u );
+
+    close(fd);
+}
+
+BOOST_AUTO_TEST_CASE( InvalidDescriptor )
+{
+    EpollReader reader([](int, const Position &) {});
+
+    BOOST_CHECK_THROW( reader.add(-1) , std::system_error );
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+/////////////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,188 @@
+#include <boost/test/unit_test.hpp>
+
+#include <atomic>
+#include <mutex>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "nmea-parser.h"
+#include "fleet-ingestor.h"
+#include "../test-helpers.h"
+
+using namespace GPS;
+using namespace NMEA;
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_SUITE( FleetIngestorTests )
+
+const std::string validGLLSentence = "$GPGLL,5425.31,N,107.03,W,82610*69";
+const std::string validRMCSentence = "$GPRMC,113922.000,A,3722.5993,N,00559.2458,W,0.000,0.00,150914,,A*62";
+
+BOOST_AUTO_TEST_CASE( SingleStream )
+{
+    std::vector<Position> received;
+    FleetIngestor ingestor([&received](StreamId, const Position & p) { received.push_back(p); }, 2);
+
+    ingestor.receive(7, validGLLSentence + "\n" + validRMCSentence.substr(0, 20));
+    ingestor.process();
+    BOOST_CHECK_EQUAL( received.size() , 1u );
+
+    ingestor.receive(7, validRMCSentence.substr(20) + "\n");
+    ingestor.process();
+    BOOST_CHECK_EQUAL( received.size() , 2u );
+
+    const StreamStatistics stats = ingestor.statistics(7);
+    BOOST_CHECK_EQUAL( stats.bytesReceived , validGLLSentence.size() + validRMCSentence.size() + 2 );
+    BOOST_CHECK_EQUAL( stats.linesRead , 2u );
+    BOOST_CHECK_EQUAL( stats.positionsRead , 2u );
+}
+
+BOOST_AUTO_TEST_CASE( CloseStreamFlushesFinalLine )
+{
+    std::vector<Position> received;
+    FleetIngestor ingestor([&received](StreamId, const Position & p) { received.push_back(p); }, 1);
+
+    ingestor.receive(1, validGLLSentence); // no line break
+    ingestor.process();
+    BOOST_CHECK_EQUAL( received.size() , 0u );
+
+    ingestor.closeStream(1);
+    BOOST_CHECK_EQUAL( received.size() , 1u );
+    BOOST_CHECK_EQUAL( ingestor.streamCount() , 0u );
+    BOOST_CHECK_THROW( ingestor.statistics(1) , std::invalid_argument );
+}
+
+BOOST_AUTO_TEST_CASE( ManyInterleavedStreams )
+{
+    const std::vector<std::string> logs = { readNMEAfile("gll.log"), readNMEAfile("gga_rmc-1.log") };
+    std::vector<std::vector<Position>> expected;
+    for (const std::string & log : logs)
+    {
+        std::istringstream sentences(log);
+        expected.push_back(readSentences(sentences));
+        BOOST_REQUIRE( ! expected.back().empty() );
+    }
+
+    const StreamId streamCount = 200;
+    std::vector<std::vector<Position>> received(streamCount);
+    FleetIngestor ingestor([&received](StreamId id, const Position & p) { received[id].push_back(p); }, 4, 8);
+
+    // Feed every stream in random-sized pieces, round-robin, processing after each round.
+    std::mt19937 random(42);
+    std::vector<std::size_t> offsets(streamCount, 0);
+    bool anyRemaining = true;
+    while (anyRemaining)
+    {
+        anyRemaining = false;
+        for (StreamId id = 0; id < streamCount; ++id)
+        {
+            const std::string & log = logs[id % logs.size()];
+            if (offsets[id] >= log.size()) continue;
+            const std::size_t pieceSize = std::uniform_int_distribution<std::size_t>(1, 4000)(random);
+            ingestor.receive(id, std::string_view(log).substr(offsets[id], pieceSize));
+            offsets[id] += pieceSize;
+            anyRemaining = true;
+        }
+        ingestor.process();
+    }
+
+    BOOST_CHECK_EQUAL( ingestor.streamCount() , streamCount );
+    for (StreamId id = 0; id < streamCount; ++id)
+    {
+        const std::vector<Position> & expectedPositions = expected[id % logs.size()];
+        BOOST_REQUIRE_EQUAL( received[id].size() , expectedPositions.size() );
+        bool sameOrder = true;
+        for (std::size_t i = 0; i < expectedPositions.size(); ++i)
+        {
+            sameOrder = sameOrder && received[id][i].latitude() == expectedPositions[i].latitude()
+                                  && received[id][i].longitude() == expectedPositions[i].longitude();
+        }
+        BOOST_CHECK( sameOrder );
+    }
+}
+
+BOOST_AUTO_TEST_CASE( ConsumerException )
+{
+    FleetIngestor ingestor([](StreamId, const Position &) { throw std::runtime_error("consumer failed"); }, 2);
+
+    ingestor.receive(1, validGLLSentence + "\n");
+
+    BOOST_CHECK_THROW( ingestor.process() , std::runtime_error );
+}
+
+BOOST_AUTO_TEST_CASE( ConsumerExceptionDoesNotStallOtherStreams )
+{
+    std::vector<int> received(4, 0);
+    bool thrown = false;
+    auto consumer = [&](StreamId id, const Position &)
+    {
+        if (id == 0 && ! thrown)
+        {
+            thrown = true;
+            throw std::runtime_error("consumer failed");
+        }
+        ++received[id];
+    };
+    FleetIngestor ingestor(consumer, 1, 4); // all four streams in the same pool task
+
+    for (StreamId id = 0; id < 4; ++id) ingestor.receive(id, validGLLSentence + "\n");
+    BOOST_CHECK_THROW( ingestor.process() , std::runtime_error );
+    BOOST_CHECK( received == std::vector<int>({0, 1, 1, 1}) );
+
+    for (StreamId id = 0; id < 4; ++id) ingestor.receive(id, validGLLSentence + "\n");
+    ingestor.process();
+    BOOST_CHECK( received == std::vector<int>({1, 2, 2, 2}) );
+}
+
+BOOST_AUTO_TEST_CASE( ReceiveWhileClosing )
+{
+    const int sentencesPerStream = 2000;
+    const StreamId streamCount = 8;
+    std::atomic<int> received{0};
+    FleetIngestor ingestor([&received](StreamId, const Position &) { ++received; }, 2);
+
+    std::thread sender([&]
+    {
+        for (int i = 0; i < sentencesPerStream; ++i)
+        {
+            for (StreamId id = 0; id < streamCount; ++id) ingestor.receive(id, validGLLSentence + "\n");
+        }
+    });
+    for (int i = 0; i < sentencesPerStream; ++i) ingestor.closeStream(i % streamCount);
+    sender.join();
+
+    // Every sentence is parsed exactly once, whether flushed by closeStream() or by process().
+    ingestor.process();
+    for (StreamId id = 0; id < streamCount; ++id) ingestor.closeStream(id);
+    BOOST_CHECK_EQUAL( received , sentencesPerStream * streamCount );
+}
+
+BOOST_AUTO_TEST_CASE( ConsumerReceivesWhileClosing )
+{
+    // The consumer forwards every Position from stream 1 to stream 2, as a new sentence.
+    std::vector<StreamId> received;
+    FleetIngestor * forwarder = nullptr;
+    FleetIngestor ingestor([&](StreamId id, const Position &)
+    {
+        received.push_back(id);
+        if (id == 1) forwarder->receive(2, validGLLSentence + "\n");
+    }, 1);
+    forwarder = &ingestor;
+
+    ingestor.receive(1, validGLLSentence + "\n" + validGLLSentence);
+    ingestor.closeStream(1);
+    BOOST_CHECK( received == std::vector<StreamId>({1, 1}) );
+    BOOST_CHECK_EQUAL( ingestor.streamCount() , 1u );
+
+    ingestor.process();
+    BOOST_CHECK( received == std::vector<StreamId>({1, 1, 2, 2}) );
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+/////////////////////////////////////////////////////////////////////////////////////////
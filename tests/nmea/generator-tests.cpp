@@ -0,0 +1,176 @@
+#include <boost/test/unit_test.hpp>
+
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "earth.h"
+#include "nmea-parser.h"
+#include "generator.h"
+
+using namespace GPS;
+using namespace NMEA;
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_SUITE( Generator )
+
+const std::uint64_t smallCorpus = 64 * 1024;
+
+std::string generate(GeneratorOptions options, GeneratorStatistics * stats = nullptr)
+{
+    std::ostringstream stream;
+    GeneratorStatistics result = generateSentences(stream, options);
+    if (stats) *stats = result;
+    return stream.str();
+}
+
+std::vector<std::string> linesOf(const std::string & text)
+{
+    std::vector<std::string> lines;
+    std::istringstream stream(text);
+    std::string line;
+    while (std::getline(stream, line)) lines.push_back(line);
+    return lines;
+}
+
+BOOST_AUTO_TEST_CASE( SentenceFromBody )
+{
+    BOOST_CHECK_EQUAL( sentenceFromBody("GPGLL,5425.31,N,107.03,W,82610") , "$GPGLL,5425.31,N,107.03,W,82610*69" );
+    BOOST_CHECK( checksumMatches(sentenceFromBody("GPGGA,094627.000,3723.1622,N,00559.5788,W,1,0,,30.0,M,,M,,")) );
+}
+
+BOOST_AUTO_TEST_CASE( SameSeedSameOutput )
+{
+    GeneratorOptions options;
+    options.targetBytes = smallCorpus;
+    options.corruptionRate = 0.1;
+
+    BOOST_CHECK( generate(options) == generate(options) );
+
+    GeneratorOptions otherSeed = options;
+    otherSeed.seed = 2;
+    BOOST_CHECK( generate(options) != generate(otherSeed) );
+}
+
+BOOST_AUTO_TEST_CASE( OutputSize )
+{
+    GeneratorOptions options;
+    options.targetBytes = 3 * 1024 * 1024 + 17; // spans several output blocks
+    GeneratorStatistics stats;
+    const std::string text = generate(options, &stats);
+
+    BOOST_CHECK_EQUAL( text.size() , stats.bytesWritten );
+    BOOST_CHECK_GE( text.size() , options.targetBytes );
+    BOOST_CHECK_LT( text.size() , options.targetBytes + 3 * 100 ); // at most one more fix
+    BOOST_CHECK_EQUAL( text.back() , '\n' );
+
+    options.targetBytes = 0;
+    BOOST_CHECK( generate(options).empty() );
+}
+
+BOOST_AUTO_TEST_CASE( UncorruptedSentencesAreAllValid )
+{
+    GeneratorOptions options;
+    options.targetBytes = smallCorpus;
+    GeneratorStatistics stats;
+    const std::string text = generate(options, &stats);
+    const std::vector<std::string> lines = linesOf(text);
+
+    BOOST_CHECK_EQUAL( lines.size() , stats.sentences );
+    BOOST_CHECK_EQUAL( stats.validSentences , stats.sentences );
+    BOOST_CHECK_EQUAL( stats.sentences , 3 * stats.fixes );
+    for (const std::string & line : lines)
+    {
+        BOOST_REQUIRE_MESSAGE( hasValidSentenceStructure(line) && checksumMatches(line), line );
+    }
+
+    std::istringstream stream(text);
+    BOOST_CHECK_EQUAL( readSentences(stream).size() , stats.sentences );
+}
+
+BOOST_AUTO_TEST_CASE( SelectedFormatsOnly )
+{
+    GeneratorOptions options;
+    options.targetBytes = smallCorpus;
+    options.emitGLL = false;
+    options.emitGGA = false;
+    GeneratorStatistics stats;
+    const std::string text = generate(options, &stats);
+
+    BOOST_CHECK_EQUAL( stats.sentences , stats.fixes );
+    for (const std::string & line : linesOf(text))
+    {
+        BOOST_REQUIRE_EQUAL( line.substr(0,6) , "$GPRMC" );
+    }
+}
+
+BOOST_AUTO_TEST_CASE( RouteStartsAtStartPosition )
+{
+    GeneratorOptions options;
+    options.targetBytes = 1;
+    options.emitGGA = false;
+    options.emitRMC = false;
+    options.start = Earth::Pontianak;
+    std::istringstream stream(generate(options));
+    const std::vector<Position> positions = readSentences(stream);
+
+    BOOST_REQUIRE_EQUAL( positions.size() , 1 );
+    BOOST_CHECK_LT( Position::horizontalDistanceBetween(positions.front(), options.start) , 1 );
+}
+
+BOOST_AUTO_TEST_CASE( FullyCorruptedSentencesAreAllRejected )
+{
+    GeneratorOptions options;
+    options.targetBytes = smallCorpus;
+    options.corruptionRate = 1;
+    GeneratorStatistics stats;
+    const std::string text = generate(options, &stats);
+
+    BOOST_CHECK_EQUAL( stats.validSentences , 0 );
+    BOOST_CHECK_EQUAL( stats.badChecksums + stats.truncatedSentences + stats.badBearings + stats.wrongFieldCounts ,
+                       stats.sentences );
+    BOOST_CHECK_GT( stats.badChecksums , 0 );
+    BOOST_CHECK_GT( stats.truncatedSentences , 0 );
+    BOOST_CHECK_GT( stats.badBearings , 0 );
+    BOOST_CHECK_GT( stats.wrongFieldCounts , 0 );
+
+    std::istringstream stream(text);
+    BOOST_CHECK( readSentences(stream).empty() );
+}
+
+BOOST_AUTO_TEST_CASE( PartlyCorruptedSentences )
+{
+    GeneratorOptions options;
+    options.targetBytes = smallCorpus;
+    options.corruptionRate = 0.25;
+    GeneratorStatistics stats;
+    const std::string text = generate(options, &stats);
+
+    std::istringstream stream(text);
+    BOOST_CHECK_EQUAL( readSentences(stream).size() , stats.validSentences );
+    BOOST_CHECK_GT( stats.validSentences , stats.sentences / 2 );
+    BOOST_CHECK_LT( stats.validSentences , stats.sentences );
+}
+
+BOOST_AUTO_TEST_CASE( InvalidOptions )
+{
+    std::ostringstream stream;
+    GeneratorOptions options;
+
+    options.corruptionRate = 1.5;
+    BOOST_CHECK_THROW( generateSentences(stream, options) , std::invalid_argument );
+
+    options = GeneratorOptions();
+    options.emitGLL = options.emitGGA = options.emitRMC = false;
+    BOOST_CHECK_THROW( generateSentences(stream, options) , std::invalid_argument );
+
+    options = GeneratorOptions();
+    options.secondsPerFix = 0;
+    BOOST_CHECK_THROW( generateSentences(stream, options) , std::invalid_argument );
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+/////////////////////////////////////////////////////////////////////////////////////////
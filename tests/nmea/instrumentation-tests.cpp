@@ -0,0 +1,135 @@
+#include <boost/test/unit_test.hpp>
+
+#include <chrono>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+#include "nmea-parser.h"
+#include "instrumentation.h"
+
+using namespace GPS;
+using namespace NMEA;
+using namespace NMEA::Instrumentation;
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_SUITE( InstrumentationTests )
+
+const std::string validGLLSentence = "$GPGLL,5425.31,N,107.03,W,82610*69";
+const std::string badChecksumSentence = "$GPGLL,5425.31,N,107.03,W,82610*68";
+
+StageStatistics statisticsFor(const Report & report, Stage stage)
+{
+    return report[static_cast<std::size_t>(stage)];
+}
+
+BOOST_AUTO_TEST_CASE( RecordAndReset )
+{
+    reset();
+    record(Stage::checksum, std::chrono::nanoseconds(100));
+    record(Stage::checksum, std::chrono::nanoseconds(50));
+    record(Stage::fieldSplit, std::chrono::nanoseconds(7));
+
+    Report totals = report();
+    BOOST_CHECK_EQUAL( statisticsFor(totals, Stage::checksum).calls , 2 );
+    BOOST_CHECK_EQUAL( statisticsFor(totals, Stage::checksum).nanoseconds , 150 );
+    BOOST_CHECK_EQUAL( statisticsFor(totals, Stage::fieldSplit).calls , 1 );
+    BOOST_CHECK_EQUAL( statisticsFor(totals, Stage::structureCheck).calls , 0 );
+
+    reset();
+    totals = report();
+    BOOST_CHECK_EQUAL( statisticsFor(totals, Stage::checksum).calls , 0 );
+    BOOST_CHECK_EQUAL( statisticsFor(totals, Stage::checksum).nanoseconds , 0 );
+}
+
+BOOST_AUTO_TEST_CASE( FinishedThreadsAreIncluded )
+{
+    reset();
+    std::thread worker([] { record(Stage::positionConstruction, std::chrono::nanoseconds(10)); });
+    worker.join();
+    record(Stage::positionConstruction, std::chrono::nanoseconds(5));
+
+    const StageStatistics totals = statisticsFor(report(), Stage::positionConstruction);
+    BOOST_CHECK_EQUAL( totals.calls , 2 );
+    BOOST_CHECK_EQUAL( totals.nanoseconds , 15 );
+    reset();
+}
+
+BOOST_AUTO_TEST_CASE( TimedExpressionsKeepTheirValue )
+{
+    BOOST_CHECK( GPS_NMEA_TIMED(checksum, checksumMatches(validGLLSentence)) );
+    BOOST_CHECK_EQUAL( GPS_NMEA_TIMED(fieldSplit, parseSentence(validGLLSentence)).dataFields.size() , 5 );
+    reset();
+}
+
+BOOST_AUTO_TEST_CASE( ParserStages )
+{
+    setSampleInterval(1);
+    reset();
+    std::istringstream stream(validGLLSentence + "\n" + badChecksumSentence + "\n" + "not a sentence\n");
+    BOOST_CHECK_EQUAL( readSentences(stream).size() , 1 );
+    const Report totals = report();
+
+    if (enabled)
+    {
+        BOOST_CHECK_EQUAL( statisticsFor(totals, Stage::structureCheck).calls , 2 );
+        BOOST_CHECK_EQUAL( statisticsFor(totals, Stage::checksum).calls , 2 );
+        BOOST_CHECK_EQUAL( statisticsFor(totals, Stage::fieldSplit).calls , 1 );
+        BOOST_CHECK_EQUAL( statisticsFor(totals, Stage::fieldCheck).calls , 1 );
+        BOOST_CHECK_EQUAL( statisticsFor(totals, Stage::positionConstruction).calls , 1 );
+        BOOST_CHECK_GT( statisticsFor(totals, Stage::structureCheck).nanoseconds , 0 );
+    }
+    else
+    {
+        // The hooks are compiled away.
+        for (const StageStatistics & stage : totals) BOOST_CHECK_EQUAL( stage.calls , 0 );
+    }
+    setSampleInterval(defaultSampleInterval);
+    reset();
+}
+
+BOOST_AUTO_TEST_CASE( SampledSentences )
+{
+    BOOST_CHECK_THROW( setSampleInterval(0) , std::invalid_argument );
+    BOOST_CHECK_EQUAL( sampleInterval() , defaultSampleInterval );
+
+    // Start on a timed sentence, then time one sentence in four.
+    setSampleInterval(1);
+    positionFromSentence(validGLLSentence);
+    setSampleInterval(4);
+    reset();
+
+    std::string sentences;
+    for (int i = 0; i < 10; ++i) sentences += validGLLSentence + "\n";
+    std::istringstream stream(sentences);
+    BOOST_CHECK_EQUAL( readSentences(stream).size() , 10 );
+    const Report totals = report();
+
+    const std::uint64_t expectedCalls = enabled ? 2 : 0;
+    BOOST_CHECK_EQUAL( statisticsFor(totals, Stage::structureCheck).calls , expectedCalls );
+    BOOST_CHECK_EQUAL( statisticsFor(totals, Stage::positionConstruction).calls , expectedCalls );
+
+    setSampleInterval(defaultSampleInterval);
+    reset();
+}
+
+BOOST_AUTO_TEST_CASE( PrintReport )
+{
+    Report totals;
+    totals[static_cast<std::size_t>(Stage::structureCheck)] = {4, 3000};
+    totals[static_cast<std::size_t>(Stage::checksum)] = {4, 1000};
+    std::ostringstream out;
+    printReport(out, totals);
+
+    const std::string text = out.str();
+    BOOST_CHECK( text.find("structure check") != std::string::npos );
+    BOOST_CHECK( text.find("750.0") != std::string::npos ); // ns per call
+    BOOST_CHECK( text.find("75.0%") != std::string::npos );
+    BOOST_CHECK( text.find("position construction") != std::string::npos );
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+/////////////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,109 @@
+#include <boost/test/unit_test.hpp>
+
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "line-reader.h"
+
+using namespace GPS;
+using namespace NMEA;
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_SUITE( LineReaderTests )
+
+std::vector<std::string> readAllLines(const std::string & contents, std::size_t blockSize)
+{
+    std::istringstream stream(contents);
+    LineReader reader(stream, blockSize);
+    std::vector<std::string> lines;
+    std::string_view line;
+    while (reader.nextLine(line))
+    {
+        lines.emplace_back(line);
+    }
+    return lines;
+}
+
+BOOST_AUTO_TEST_CASE( EmptyStream )
+{
+    BOOST_CHECK( readAllLines("", 16).empty() );
+}
+
+BOOST_AUTO_TEST_CASE( UnixLineEndings )
+{
+    const std::vector<std::string> expected = { "first", "", "third" };
+
+    BOOST_CHECK( readAllLines("first\n\nthird\n", 16) == expected );
+}
+
+BOOST_AUTO_TEST_CASE( WindowsLineEndings )
+{
+    const std::vector<std::string> expected = { "first", "", "third" };
+
+    BOOST_CHECK( readAllLines("first\r\n\r\nthird\r\n", 16) == expected );
+}
+
+BOOST_AUTO_TEST_CASE( NoFinalLineBreak )
+{
+    const std::vector<std::string> expected = { "first", "second" };
+
+    BOOST_CHECK( readAllLines("first\nsecond", 16) == expected );
+}
+
+BOOST_AUTO_TEST_CASE( LinesSpanningBlocks )
+{
+    const std::string contents = "$GPGLL,5425.31,N,107.03,W,82610*69\r\n@header\r\n$GPXXX,1*23\r\n";
+    const std::vector<std::string> expected = { "$GPGLL,5425.31,N,107.03,W,82610*69", "@header", "$GPXXX,1*23" };
+
+    // Every block size from one byte upwards splits the lines (and "\r\n") differently.
+    for (std::size_t blockSize = 1; blockSize <= contents.size() + 1; ++blockSize)
+    {
+        BOOST_CHECK( readAllLines(contents, blockSize) == expected );
+    }
+}
+
+BOOST_AUTO_TEST_CASE( LineLongerThanBlock )
+{
+    const std::string longLine(10000, 'X');
+    const std::vector<std::string> expected = { "a", longLine, "b" };
+
+    BOOST_CHECK( readAllLines("a\n" + longLine + "\nb\n", 64) == expected );
+}
+
+BOOST_AUTO_TEST_CASE( SplitterPiecesOfEverySize )
+{
+    const std::string contents = "$GPGLL,5425.31,N,107.03,W,82610*69\r\n@header\n\n$GPXXX,1*23";
+    const std::vector<std::string> expected = { "$GPGLL,5425.31,N,107.03,W,82610*69", "@header", "", "$GPXXX,1*23" };
+
+    for (std::size_t pieceSize = 1; pieceSize <= contents.size(); ++pieceSize)
+    {
+        LineSplitter splitter;
+        std::vector<std::string> lines;
+        auto collect = [&lines](std::string_view line) { lines.emplace_back(line); };
+
+        for (std::size_t start = 0; start < contents.size(); start += pieceSize)
+        {
+            splitter.feed(std::string_view(contents).substr(start, pieceSize), collect);
+        }
+        BOOST_CHECK_EQUAL( splitter.pendingBytes() , 11u );
+        splitter.finish(collect);
+
+        BOOST_CHECK( lines == expected );
+        BOOST_CHECK_EQUAL( splitter.pendingBytes() , 0u );
+    }
+}
+
+BOOST_AUTO_TEST_CASE( TrimWhitespace )
+{
+    BOOST_CHECK_EQUAL( trimWhitespace("  $GPXXX,1*23\t\r") , "$GPXXX,1*23" );
+    BOOST_CHECK_EQUAL( trimWhitespace("$GPXXX,1*23") , "$GPXXX,1*23" );
+    BOOST_CHECK_EQUAL( trimWhitespace(" \t \r") , "" );
+    BOOST_CHECK_EQUAL( trimWhitespace("") , "" );
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+/////////////////////////////////////////////////////////////////////////////////////////
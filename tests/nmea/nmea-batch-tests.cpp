@@ -0,0 +1,80 @@
+#include <boost/test/unit_test.hpp>
+
+#include <string>
+#include <stdexcept>
+#include <vector>
+#include <fstream>
+
+#include "dataFiles.h"
+#include "nmea-parser.h"
+#include "nmea-batch.h"
+
+using namespace GPS;
+using namespace NMEA;
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_SUITE( ReadDirectory )
+
+const std::vector<std::string> NMEAfiles = { "gga_rmc-1.log", "gga_rmc-2.log", "gll.log" };
+
+BOOST_AUTO_TEST_CASE( AllFilesRead )
+{
+    BatchResult batch = readDirectory(DataFiles::NMEADir);
+
+    BOOST_REQUIRE_EQUAL( batch.files.size() , NMEAfiles.size() );
+    BOOST_CHECK_EQUAL( batch.statistics.filesRead , NMEAfiles.size() );
+    BOOST_CHECK_EQUAL( batch.statistics.filesFailed , 0u );
+}
+
+BOOST_AUTO_TEST_CASE( OrderedByFilepath )
+{
+    BatchResult batch = readDirectory(DataFiles::NMEADir);
+
+    BOOST_REQUIRE_EQUAL( batch.files.size() , NMEAfiles.size() );
+    for (std::size_t i = 0; i < NMEAfiles.size(); ++i)
+    {
+        BOOST_CHECK_EQUAL( batch.files[i].filepath , DataFiles::NMEADir + NMEAfiles[i] );
+    }
+}
+
+BOOST_AUTO_TEST_CASE( MatchesSerialReading )
+{
+    BatchResult batch = readDirectory(DataFiles::NMEADir, 2);
+
+    std::size_t expectedTotal = 0;
+    for (const FileResult & result : batch.files)
+    {
+        std::ifstream sentences(result.filepath);
+        std::vector<Position> expected = readSentences(sentences);
+        expectedTotal += expected.size();
+
+        BOOST_CHECK( result.succeeded );
+        BOOST_REQUIRE_EQUAL( result.positions.size() , expected.size() );
+        for (std::size_t i = 0; i < expected.size(); ++i)
+        {
+            BOOST_CHECK_EQUAL( result.positions[i].latitude() , expected[i].latitude() );
+            BOOST_CHECK_EQUAL( result.positions[i].longitude() , expected[i].longitude() );
+            BOOST_CHECK_EQUAL( result.positions[i].elevation() , expected[i].elevation() );
+        }
+    }
+    BOOST_CHECK_EQUAL( batch.statistics.positionsRead , expectedTotal );
+}
+
+BOOST_AUTO_TEST_CASE( SingleThread )
+{
+    BatchResult batch = readDirectory(DataFiles::NMEADir, 1);
+
+    BOOST_CHECK_EQUAL( batch.statistics.filesRead , NMEAfiles.size() );
+    BOOST_CHECK_EQUAL( batch.statistics.positionsRead , 632u + 1090u + 1826u );
+}
+
+BOOST_AUTO_TEST_CASE( NotADirectory )
+{
+    BOOST_CHECK_THROW( readDirectory(DataFiles::NMEADir + "gll.log") , std::invalid_argument );
+    BOOST_CHECK_THROW( readDirectory(DataFiles::NMEADir + "no-such-directory/") , std::invalid_argument );
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+/////////////////////////////////////////////////////////////////////////////////////////
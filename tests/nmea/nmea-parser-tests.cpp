@@ -1,5 +1,6 @@
 #include <boost/test/unit_test.hpp>
 
+#include <memory_resource>
 #include <string>
 #include <stdexcept>
 #include <vector>
@@ -271,6 +272,14 @@ BOOST_AUTO_TEST_CASE( MismatchWithLowercaseHexDigit )
     BOOST_CHECK( ! checksumMatches("$GPAAE,*5f") );
 }
 
+BOOST_AUTO_TEST_CASE( ChecksumOfBody )
+{
+    BOOST_CHECK_EQUAL( checksumOf("GPGLL,5425.31,N,107.03,W,82610") , 0x69 );
+    BOOST_CHECK_EQUAL( checksumOf("") , 0 );
+    for (int value = 0; value < 16; ++value) BOOST_CHECK_EQUAL( hexValue(hexDigit(value)) , value );
+    BOOST_CHECK_EQUAL( hexDigit(10) , 'A' );
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 /////////////////////////////////////////////////////////////////////////////////////////
@@ -286,7 +295,7 @@ BOOST_AUTO_TEST_SUITE( ParseSentence )
  * So instead we introduce an auxilliary function for formatting the error message for mismatched vectors.
  */
 
-std::ostream& operator<<(std::ostream& outputStream, const std::vector<std::string> & vec)
+std::ostream& operator<<(std::ostream& outputStream, const std::pmr::vector<std::pmr::string> & vec)
 {
     outputStream << '{';
     for (auto it = vec.begin(); it != vec.end(); ++it)
@@ -298,8 +307,8 @@ std::ostream& operator<<(std::ostream& outputStream, const std::vector<std::stri
     return outputStream;
 }
 
-std::string formatMismatchedFieldData(const std::vector<std::string> & actualFields,
-                                      const std::vector<std::string> & expectedFields)
+std::string formatMismatchedFieldData(const std::pmr::vector<std::pmr::string> & actualFields,
+                                      const std::pmr::vector<std::pmr::string> & expectedFields)
 {
     std::stringstream outputMessage;
     outputMessage << "parseSentenceData() has failed [ " << actualFields << " != " << expectedFields << " ]";
@@ -377,6 +386,35 @@ BOOST_AUTO_TEST_CASE( MSS )
     checkSentenceDataEqual(actualSentenceData , expectedSentenceData);
 }
 
+BOOST_AUTO_TEST_CASE( IntoMemoryResource )
+{
+    const std::string sentence = "$GPGGA,114530.000,3722.6279,N,00559.1566,W,1,0,,1.0,M,,M,,*51";
+    const SentenceData expectedSentenceData = { "GGA", {"114530.000","3722.6279","N","00559.1566","W","1","0","","1.0","M","","M","",""} };
+
+    // A SentenceArena holds a whole sentence without needing its upstream resource.
+    SentenceArena arena(std::pmr::null_memory_resource());
+    SentenceData actualSentenceData = parseSentence(sentence, arena.resource());
+
+    checkSentenceDataEqual(actualSentenceData , expectedSentenceData);
+    BOOST_CHECK( actualSentenceData.format.get_allocator().resource() == arena.resource() );
+    BOOST_CHECK( actualSentenceData.dataFields.get_allocator().resource() == arena.resource() );
+    BOOST_CHECK( actualSentenceData.dataFields[0].get_allocator().resource() == arena.resource() );
+}
+
+BOOST_AUTO_TEST_CASE( ArenaOverflowsUpstream )
+{
+    // Fields too long for the arena's buffer.
+    const std::string field(600, '1');
+    const std::string sentence = "$GPMSS," + field + "," + field + ",*00";
+
+    SentenceArena arena;
+    const SentenceData sentenceData = parseSentence(sentence, arena.resource());
+    BOOST_REQUIRE_EQUAL( sentenceData.dataFields.size() , 3 );
+    BOOST_CHECK( sentenceData.dataFields[0] == std::string_view(field) );
+    BOOST_CHECK( sentenceData.dataFields[1] == std::string_view(field) );
+    BOOST_CHECK_EQUAL( sentenceData.dataFields[2] , "" );
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 /////////////////////////////////////////////////////////////////////////////////////////
@@ -679,6 +717,56 @@ BOOST_AUTO_TEST_SUITE_END()
 
 /////////////////////////////////////////////////////////////////////////////////////////
 
+BOOST_AUTO_TEST_SUITE( TimeOfDay )
+
+BOOST_AUTO_TEST_CASE( GLLTime )
+{
+    const SentenceData sentenceData = { "GLL", {"5425.31","N","107.03","E","082610"} };
+
+    BOOST_REQUIRE( timeOfDay(sentenceData).has_value() );
+    BOOST_CHECK_EQUAL( *timeOfDay(sentenceData) , 8*3600 + 26*60 + 10 );
+}
+
+BOOST_AUTO_TEST_CASE( OmittedLeadingZeros )
+{
+    const SentenceData sentenceData = { "GLL", {"5425.31","N","107.03","E","82610"} };
+
+    BOOST_REQUIRE( timeOfDay(sentenceData).has_value() );
+    BOOST_CHECK_EQUAL( *timeOfDay(sentenceData) , 8*3600 + 26*60 + 10 );
+}
+
+BOOST_AUTO_TEST_CASE( RMCTimeWithFraction )
+{
+    const SentenceData sentenceData = { "RMC", {"115856.250","A","3722.6710","S","00559.3014","E","0.000","0.00","150914","","A"} };
+
+    BOOST_REQUIRE( timeOfDay(sentenceData).has_value() );
+    BOOST_CHECK_CLOSE( *timeOfDay(sentenceData) , 11*3600 + 58*60 + 56.25 , 1e-9 );
+}
+
+BOOST_AUTO_TEST_CASE( GGATime )
+{
+    const SentenceData sentenceData = { "GGA", {"170834","4124.8963","N","08151.6838","W","1","05","1.5","280.2","M","-34.0","M","",""} };
+
+    BOOST_REQUIRE( timeOfDay(sentenceData).has_value() );
+    BOOST_CHECK_EQUAL( *timeOfDay(sentenceData) , 17*3600 + 8*60 + 34 );
+}
+
+BOOST_AUTO_TEST_CASE( MissingOrIllFormedTime )
+{
+    BOOST_CHECK( ! timeOfDay({ "GLL", {"5425.31","N","107.03","E",""} }).has_value() );
+    BOOST_CHECK( ! timeOfDay({ "GLL", {"5425.31","N","107.03","E","8261O"} }).has_value() );
+    BOOST_CHECK( ! timeOfDay({ "GLL", {"5425.31","N","107.03","E","246000"} }).has_value() );
+    BOOST_CHECK( ! timeOfDay({ "GLL", {"5425.31","N","107.03","E","086100"} }).has_value() );
+    BOOST_CHECK( ! timeOfDay({ "GLL", {"5425.31","N","107.03","E","0826100"} }).has_value() );
+    BOOST_CHECK( ! timeOfDay({ "GLL", {"5425.31","N","107.03","E"} }).has_value() );
+    BOOST_CHECK( ! timeOfDay({ "GGA", {} }).has_value() );
+    BOOST_CHECK( ! timeOfDay({ "MSS", {"082610"} }).has_value() );
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
 BOOST_AUTO_TEST_SUITE( ReadSentences )
 
 const double percentageAccuracy = 0.0001;
@@ -857,6 +945,57 @@ BOOST_AUTO_TEST_CASE( InvalidFields )
     BOOST_CHECK_EQUAL( positions.size() , expectedSize );
 }
 
+BOOST_AUTO_TEST_CASE( WindowsLineEndings )
+{
+    std::stringstream sentences;
+    sentences << validGLLSentence << "\r\n";
+    sentences << validRMCSentence << "\r\n";
+    sentences << "\r\n";
+    sentences << validGGASentence << "\r\n";
+    const unsigned int expectedSize = 3;
+
+    std::vector<Position> positions = readSentences(sentences);
+
+    BOOST_CHECK_EQUAL( positions.size() , expectedSize );
+}
+
+BOOST_AUTO_TEST_CASE( FinalLineWithoutLineBreak )
+{
+    std::stringstream sentences;
+    sentences << validGLLSentence << std::endl;
+    sentences << validRMCSentence;
+    const unsigned int expectedSize = 2;
+
+    std::vector<Position> positions = readSentences(sentences);
+
+    BOOST_CHECK_EQUAL( positions.size() , expectedSize );
+}
+
+BOOST_AUTO_TEST_CASE( SurroundingWhitespace )
+{
+    std::stringstream sentences;
+    sentences << "   " << validGLLSentence << "\t " << std::endl;
+    sentences << "\t" << validRMCSentence << std::endl;
+    const unsigned int expectedSize = 2;
+
+    std::vector<Position> positions = readSentences(sentences);
+
+    BOOST_CHECK_EQUAL( positions.size() , expectedSize );
+}
+
+BOOST_AUTO_TEST_CASE( SpacesWithinSentence )
+{
+    std::stringstream sentences;
+    sentences << "$GPGLL,5425.31, N,107.03,W,82610*49" << std::endl;
+    sentences << validGLLSentence << " " << validRMCSentence << std::endl;
+    sentences << validGGASentence << std::endl;
+    const unsigned int expectedSize = 1;
+
+    std::vector<Position> positions = readSentences(sentences);
+
+    BOOST_CHECK_EQUAL( positions.size() , expectedSize );
+}
+
 std::fstream openNMEAfile(std::string filename)
 {
     std::string dataFilepath = DataFiles::NMEADir + filename;
@@ -917,6 +1056,25 @@ BOOST_AUTO_TEST_CASE( LargeFileGGA_RMC )
     BOOST_CHECK_CLOSE( positions[501].longitude(), expectedLongitudePos501, percentageAccuracy );
 }
 
+BOOST_AUTO_TEST_CASE( IntoMemoryResource )
+{
+    std::fstream sentences = openNMEAfile("gga_rmc-1.log");
+    const std::vector<Position> expected = readSentences(sentences);
+
+    std::fstream again = openNMEAfile("gga_rmc-1.log");
+    std::pmr::monotonic_buffer_resource arena;
+    const std::pmr::vector<Position> positions = readSentences(again, &arena);
+
+    BOOST_CHECK( positions.get_allocator().resource() == &arena );
+    BOOST_REQUIRE_EQUAL( positions.size() , expected.size() );
+    for (std::size_t i = 0; i < positions.size(); ++i)
+    {
+        BOOST_CHECK_EQUAL( positions[i].latitude() , expected[i].latitude() );
+        BOOST_CHECK_EQUAL( positions[i].longitude() , expected[i].longitude() );
+        BOOST_CHECK_EQUAL( positions[i].elevation() , expected[i].elevation() );
+    }
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 /////////////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,216 @@
+#include <boost/test/unit_test.hpp>
+
+#include <chrono>
+#include <condition_variable>
+#include <ctime>
+#include <fstream>
+#include <mutex>
+#include <sstream>
+#include <stdexcept>
+#include <streambuf>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "dataFiles.h"
+#include "nmea-parser.h"
+#include "pipeline.h"
+
+using namespace GPS;
+using namespace NMEA;
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_SUITE( RunPipeline )
+
+std::vector<Position> readWithPipeline(std::istream & sentences, PipelineOptions options = {})
+{
+    std::vector<Position> positions;
+    runPipeline(sentences, [&positions](const Position & p) { positions.push_back(p); }, options);
+    return positions;
+}
+
+void checkMatchesReadSentences(std::string filename, PipelineOptions options)
+{
+    std::ifstream eagerFile(DataFiles::NMEADir + filename);
+    std::ifstream pipelineFile(DataFiles::NMEADir + filename);
+    const std::vector<Position> expected = readSentences(eagerFile);
+
+    const std::vector<Position> actual = readWithPipeline(pipelineFile, options);
+
+    BOOST_REQUIRE_EQUAL( actual.size() , expected.size() );
+    for (std::size_t i = 0; i < expected.size(); ++i)
+    {
+        BOOST_CHECK_EQUAL( actual[i].latitude() , expected[i].latitude() );
+        BOOST_CHECK_EQUAL( actual[i].longitude() , expected[i].longitude() );
+        BOOST_CHECK_EQUAL( actual[i].elevation() , expected[i].elevation() );
+    }
+}
+
+/* A live source (like a serial port) that delivers one sentence at a time, each only after
+ * the consumer has received the previous one, or after a delay.  A reader that waits for a
+ * whole block before passing anything on would keep waiting for the timeout.
+ */
+class LiveSentences : public std::streambuf
+{
+  public:
+
+    LiveSentences(std::vector<std::string> sentences, std::chrono::milliseconds timeout)
+        : sentences(std::move(sentences)), timeout(timeout)
+    {}
+
+    void received()
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        ++receivedCount;
+        arrival.notify_all();
+    }
+
+    bool timedOut = false;
+
+  protected:
+
+    int_type underflow() override
+    {
+        if (served == sentences.size()) return traits_type::eof();
+
+        std::unique_lock<std::mutex> lock(mutex);
+        if (! arrival.wait_for(lock, timeout, [this] { return receivedCount == served; }))
+        {
+            timedOut = true;
+        }
+        char * begin = sentences[served].data();
+        setg(begin, begin, begin + sentences[served].size());
+        ++served;
+        return traits_type::to_int_type(*gptr());
+    }
+
+  private:
+
+    std::vector<std::string> sentences;
+    const std::chrono::milliseconds timeout;
+    std::size_t served = 0;
+    std::size_t receivedCount = 0;
+    std::mutex mutex;
+    std::condition_variable arrival;
+};
+
+// Throws after delivering the first sentence.
+class FailingSource : public std::streambuf
+{
+  protected:
+
+    int_type underflow() override
+    {
+        if (delivered) throw std::runtime_error("device unplugged");
+        delivered = true;
+        setg(sentence.data(), sentence.data(), sentence.data() + sentence.size());
+        return traits_type::to_int_type(*gptr());
+    }
+
+  private:
+
+    std::string sentence = "$GPGLL,5425.31,N,107.03,W,82610*69\n";
+    bool delivered = false;
+};
+
+BOOST_AUTO_TEST_CASE( EmptyStream )
+{
+    std::stringstream sentences("");
+
+    BOOST_CHECK( readWithPipeline(sentences).empty() );
+}
+
+BOOST_AUTO_TEST_CASE( MatchesReadSentences )
+{
+    checkMatchesReadSentences("gga_rmc-1.log", {});
+}
+
+BOOST_AUTO_TEST_CASE( SmallBlocksAndQueues )
+{
+    PipelineOptions options;
+    options.blockSize = 7;             // splits nearly every line between blocks
+    options.blockQueueCapacity = 2;
+    options.positionQueueCapacity = 2; // forces backpressure
+
+    checkMatchesReadSentences("gll.log", options);
+}
+
+BOOST_AUTO_TEST_CASE( Metrics )
+{
+    std::ifstream sentences(DataFiles::NMEADir + "gll.log");
+    PipelineOptions options;
+    options.blockSize = 4096;
+
+    PipelineMetrics metrics = runPipeline(sentences, [](const Position &) {}, options);
+
+    BOOST_CHECK( metrics.reader.itemsProcessed > 1 );
+    BOOST_CHECK_EQUAL( metrics.parser.itemsProcessed , 1090u );
+    BOOST_CHECK_EQUAL( metrics.consumer.itemsProcessed , 1090u );
+    BOOST_CHECK( metrics.blockQueue.capacity >= options.blockQueueCapacity );
+    BOOST_CHECK( metrics.positionQueue.maxDepth <= metrics.positionQueue.capacity );
+    BOOST_CHECK( metrics.maxEndToEndMicroseconds >= metrics.meanEndToEndMicroseconds );
+    BOOST_CHECK( metrics.elapsedSeconds > 0 );
+}
+
+BOOST_AUTO_TEST_CASE( ConsumerException )
+{
+    std::ifstream sentences(DataFiles::NMEADir + "gll.log");
+    PipelineOptions options;
+    options.blockSize = 64;
+    options.positionQueueCapacity = 4;
+    int consumed = 0;
+
+    auto failingConsumer = [&consumed](const Position &)
+    {
+        if (++consumed == 10) throw std::runtime_error("consumer failed");
+    };
+
+    BOOST_CHECK_THROW( runPipeline(sentences, failingConsumer, options) , std::runtime_error );
+    BOOST_CHECK_EQUAL( consumed , 10 );
+}
+
+BOOST_AUTO_TEST_CASE( LiveInputIsNotHeldBack )
+{
+    const std::string sentence = "$GPGLL,5425.31,N,107.03,W,82610*69\r\n";
+    LiveSentences source(std::vector<std::string>(5, sentence), std::chrono::seconds(5));
+    std::istream live(&source);
+    int consumed = 0;
+
+    runPipeline(live, [&](const Position &) { ++consumed; source.received(); });
+
+    BOOST_CHECK_EQUAL( consumed , 5 );
+    BOOST_CHECK( ! source.timedOut );
+}
+
+BOOST_AUTO_TEST_CASE( IdleStagesSleep )
+{
+    // The consumer never signals, so every sentence after the first arrives after a delay.
+    const std::string sentence = "$GPGLL,5425.31,N,107.03,W,82610*69\n";
+    LiveSentences source(std::vector<std::string>(3, sentence), std::chrono::milliseconds(150));
+    std::istream live(&source);
+
+    const std::clock_t cpuStart = std::clock();
+    const auto wallStart = std::chrono::steady_clock::now();
+    runPipeline(live, [](const Position &) {});
+    const double cpuSeconds = static_cast<double>(std::clock() - cpuStart) / CLOCKS_PER_SEC;
+    const double wallSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - wallStart).count();
+
+    BOOST_CHECK( wallSeconds >= 0.3 );
+    BOOST_CHECK_LT( cpuSeconds , 0.25 * wallSeconds );
+}
+
+BOOST_AUTO_TEST_CASE( ReaderException )
+{
+    FailingSource source;
+    std::istream failing(&source);
+    failing.exceptions(std::ios::badbit); // let the streambuf's exception through
+    int consumed = 0;
+
+    BOOST_CHECK_THROW( runPipeline(failing, [&consumed](const Position &) { ++consumed; }) , std::runtime_error );
+    BOOST_CHECK( consumed <= 1 );
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+/////////////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,145 @@
+#include <boost/test/unit_test.hpp>
+
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <type_traits>
+#include <vector>
+#if __cplusplus > 201703L
+#include <ranges>
+#endif
+
+#include "dataFiles.h"
+#include "nmea-parser.h"
+#include "position-range.h"
+
+using namespace GPS;
+using namespace NMEA;
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_SUITE( PositionRangeTests )
+
+const std::string validGLLSentence = "$GPGLL,5425.31,N,107.03,W,82610*69";
+const std::string validRMCSentence = "$GPRMC,113922.000,A,3722.5993,N,00559.2458,W,0.000,0.00,150914,,A*62";
+const std::string validGGASentence = "$GPGGA,114530.000,3722.6279,N,00559.1566,W,1,0,,1.0,M,,M,,*4E";
+
+BOOST_AUTO_TEST_CASE( MovableButNotCopyable )
+{
+    BOOST_CHECK( std::is_move_constructible_v<PositionRange> );
+    BOOST_CHECK( ! std::is_copy_constructible_v<PositionRange> );
+    BOOST_CHECK( ! std::is_copy_assignable_v<PositionRange> );
+}
+
+BOOST_AUTO_TEST_CASE( EmptyStream )
+{
+    std::stringstream sentences("");
+    PositionRange range = positions(sentences);
+
+    BOOST_CHECK( range.begin() == range.end() );
+}
+
+BOOST_AUTO_TEST_CASE( SkipsInvalidLines )
+{
+    std::stringstream sentences;
+    sentences << "@Sonygps/ver3.0/wgs-84/" << std::endl;
+    sentences << validGLLSentence << std::endl;
+    sentences << "$GPGLL,5425.31,N,107.03,W,82610*24" << std::endl;
+    sentences << std::endl;
+    sentences << validGGASentence << std::endl;
+    const unsigned int expectedSize = 2;
+
+    unsigned int count = 0;
+    for (const Position & pos : positions(sentences))
+    {
+        BOOST_CHECK( pos.latitude() > 0 );
+        ++count;
+    }
+
+    BOOST_CHECK_EQUAL( count , expectedSize );
+}
+
+BOOST_AUTO_TEST_CASE( IteratesOneAtATime )
+{
+    std::stringstream sentences;
+    sentences << validGLLSentence << std::endl;
+    sentences << validRMCSentence << std::endl;
+    sentences << validGGASentence << std::endl;
+
+    PositionRange range = positions(sentences);
+    PositionRange::iterator it = range.begin();
+    BOOST_CHECK_CLOSE( it->latitude() , ddmTodd("5425.31") , 0.0001 );
+    ++it;
+    BOOST_CHECK_CLOSE( it->latitude() , ddmTodd("3722.5993") , 0.0001 );
+    ++it;
+    BOOST_CHECK_CLOSE( it->elevation() , 1.0 , 0.0001 );
+    ++it;
+    BOOST_CHECK( it == range.end() );
+}
+
+BOOST_AUTO_TEST_CASE( BeginDoesNotRewind )
+{
+    std::stringstream sentences;
+    sentences << validGLLSentence << std::endl;
+    sentences << validRMCSentence << std::endl;
+
+    PositionRange range = positions(sentences);
+    ++range.begin();
+
+    BOOST_CHECK_EQUAL( std::distance(range.begin(), range.end()) , 1 );
+}
+
+BOOST_AUTO_TEST_CASE( MatchesReadSentences )
+{
+    std::ifstream eagerFile(DataFiles::NMEADir + "gga_rmc-2.log");
+    std::ifstream lazyFile(DataFiles::NMEADir + "gga_rmc-2.log");
+    const std::vector<Position> expected = readSentences(eagerFile);
+
+    std::vector<Position> actual;
+    for (const Position & pos : positions(lazyFile))
+    {
+        actual.push_back(pos);
+    }
+
+    BOOST_REQUIRE_EQUAL( actual.size() , expected.size() );
+    for (std::size_t i = 0; i < expected.size(); ++i)
+    {
+        BOOST_CHECK_EQUAL( actual[i].latitude() , expected[i].latitude() );
+        BOOST_CHECK_EQUAL( actual[i].longitude() , expected[i].longitude() );
+        BOOST_CHECK_EQUAL( actual[i].elevation() , expected[i].elevation() );
+    }
+}
+
+BOOST_AUTO_TEST_CASE( StandardAlgorithms )
+{
+    std::ifstream sentences(DataFiles::NMEADir + "gga_rmc-1.log");
+    PositionRange range = positions(sentences);
+
+    const long aboveSeaLevel = std::count_if(range.begin(), range.end(),
+                                             [](const Position & p) { return p.elevation() > 0; });
+
+    BOOST_CHECK( aboveSeaLevel > 0 );
+}
+
+#if __cplusplus > 201703L
+BOOST_AUTO_TEST_CASE( ComposesWithRanges )
+{
+    std::ifstream sentences(DataFiles::NMEADir + "gga_rmc-1.log");
+    PositionRange range = positions(sentences);
+
+    unsigned int count = 0;
+    for (const Position & pos : range | std::views::filter([](const Position & p) { return p.elevation() > 0; })
+                                      | std::views::take(10))
+    {
+        BOOST_CHECK( pos.elevation() > 0 );
+        ++count;
+    }
+
+    BOOST_CHECK_EQUAL( count , 10u );
+}
+#endif
+
+BOOST_AUTO_TEST_SUITE_END()
+
+/////////////////////////////////////////////////////////////////////////////////////////
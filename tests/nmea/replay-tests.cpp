@@ -0,0 +1,189 @@
+#include <boost/test/unit_test.hpp>
+
+#include <chrono>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <unistd.h>
+
+#include "dataFiles.h"
+#include "latency-histogram.h"
+#include "epoll-reader.h"
+#include "replay.h"
+
+using namespace GPS;
+using namespace NMEA;
+using namespace std::chrono;
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_SUITE( Replay )
+
+const std::string timedLog =
+    "$GPGLL,5425.31,N,107.03,W,120000*57\n"
+    "$GPGLL,5425.31,N,107.03,W,120000*56\n"            // bad checksum
+    "$GPRMC,120001.500,A,3722.5993,N,00559.2458,W,0.000,0.00,150914,,A*6F\n"
+    "log comment\n"
+    "$GPGGA,120004.000,3722.6279,N,00559.1566,W,1,0,,1.0,M,,M,,*4B\n";
+
+std::vector<double> secondsOf(const std::vector<nanoseconds> & schedule)
+{
+    std::vector<double> result;
+    for (nanoseconds t : schedule) result.push_back(duration<double>(t).count());
+    return result;
+}
+
+BOOST_AUTO_TEST_CASE( CountsLines )
+{
+    std::istringstream log(timedLog);
+    LogReplayer replayer(log);
+
+    BOOST_CHECK_EQUAL( replayer.lineCount() , 5 );
+    BOOST_CHECK_EQUAL( replayer.validSentenceCount() , 3 );
+    BOOST_CHECK_CLOSE( replayer.recordedDurationSeconds() , 4 , 1e-9 );
+}
+
+BOOST_AUTO_TEST_CASE( RecordedPace )
+{
+    std::istringstream log(timedLog);
+    LogReplayer replayer(log);
+    ReplayOptions options;
+
+    const std::vector<double> realTime = secondsOf(replayer.schedule(options));
+    const std::vector<double> expectedRealTime = {0, 0, 1.5, 1.5, 4};
+    BOOST_CHECK_EQUAL_COLLECTIONS( realTime.begin(), realTime.end(), expectedRealTime.begin(), expectedRealTime.end() );
+
+    options.speedFactor = 4;
+    const std::vector<double> fourTimes = secondsOf(replayer.schedule(options));
+    const std::vector<double> expectedFourTimes = {0, 0, 0.375, 0.375, 1};
+    BOOST_CHECK_EQUAL_COLLECTIONS( fourTimes.begin(), fourTimes.end(), expectedFourTimes.begin(), expectedFourTimes.end() );
+}
+
+BOOST_AUTO_TEST_CASE( FixedRateAndUnthrottledPaces )
+{
+    std::istringstream log(timedLog);
+    LogReplayer replayer(log);
+    ReplayOptions options;
+
+    options.pace = ReplayOptions::Pace::fixedRate;
+    options.sentencesPerSecond = 4;
+    const std::vector<double> fixedRate = secondsOf(replayer.schedule(options));
+    const std::vector<double> expectedFixedRate = {0, 0.25, 0.5, 0.75, 1};
+    BOOST_CHECK_EQUAL_COLLECTIONS( fixedRate.begin(), fixedRate.end(), expectedFixedRate.begin(), expectedFixedRate.end() );
+
+    options.pace = ReplayOptions::Pace::unthrottled;
+    for (nanoseconds t : replayer.schedule(options)) BOOST_CHECK_EQUAL( t.count() , 0 );
+}
+
+BOOST_AUTO_TEST_CASE( CrossesMidnight )
+{
+    std::istringstream log("$GPGLL,5425.31,N,107.03,W,235959*55\n"
+                           "$GPGLL,5425.31,N,107.03,W,000001*55\n");
+    LogReplayer replayer(log);
+
+    BOOST_CHECK_CLOSE( replayer.recordedDurationSeconds() , 2 , 1e-9 );
+}
+
+BOOST_AUTO_TEST_CASE( InvalidOptions )
+{
+    std::istringstream log(timedLog);
+    LogReplayer replayer(log);
+    ReplayOptions options;
+
+    options.speedFactor = 0;
+    BOOST_CHECK_THROW( replayer.schedule(options) , std::invalid_argument );
+
+    options.pace = ReplayOptions::Pace::fixedRate;
+    options.sentencesPerSecond = -1;
+    BOOST_CHECK_THROW( replayer.replay(STDOUT_FILENO, options) , std::invalid_argument );
+
+    BOOST_CHECK_THROW( replayer.latencyOf(3) , std::out_of_range );
+}
+
+// Replays the log into a pipe, returning everything written to it.
+std::string replayThroughPipe(LogReplayer & replayer, const ReplayOptions & options, ReplayStatistics & stats)
+{
+    int fds[2];
+    BOOST_REQUIRE( pipe(fds) == 0 );
+    stats = replayer.replay(fds[1], options);
+    close(fds[1]);
+
+    std::string received;
+    char buffer[4096];
+    ssize_t bytesRead;
+    while ((bytesRead = read(fds[0], buffer, sizeof(buffer))) > 0) received.append(buffer, bytesRead);
+    close(fds[0]);
+    return received;
+}
+
+BOOST_AUTO_TEST_CASE( ReplaysVerbatimAtRate )
+{
+    std::istringstream log(timedLog);
+    LogReplayer replayer(log);
+    ReplayOptions options;
+    options.pace = ReplayOptions::Pace::fixedRate;
+    options.sentencesPerSecond = 100;
+
+    ReplayStatistics stats;
+    BOOST_CHECK_EQUAL( replayThroughPipe(replayer, options, stats) , timedLog );
+    BOOST_CHECK_EQUAL( stats.linesWritten , 5 );
+    BOOST_CHECK_EQUAL( stats.bytesWritten , timedLog.size() );
+    BOOST_CHECK_GE( stats.elapsedSeconds , 0.04 );
+}
+
+BOOST_AUTO_TEST_CASE( KeepsOriginalLineTerminators )
+{
+    const std::string mixedLog = "$GPGLL,5425.31,N,107.03,W,120000*57\r\n"
+                                 "log comment\n"
+                                 "$GPGLL,5425.31,N,107.03,W,120002*55";
+    std::istringstream log(mixedLog);
+    LogReplayer replayer(log);
+    ReplayOptions options;
+    options.pace = ReplayOptions::Pace::unthrottled;
+
+    BOOST_CHECK_EQUAL( replayer.lineCount() , 3 );
+    BOOST_CHECK_EQUAL( replayer.validSentenceCount() , 2 );
+    BOOST_CHECK_CLOSE( replayer.recordedDurationSeconds() , 2 , 1e-9 );
+
+    ReplayStatistics stats;
+    BOOST_CHECK_EQUAL( replayThroughPipe(replayer, options, stats) , mixedLog );
+    BOOST_CHECK_EQUAL( stats.bytesWritten , mixedLog.size() );
+}
+
+BOOST_AUTO_TEST_CASE( EndToEndLatency )
+{
+    std::ifstream log(DataFiles::NMEADir + "gga_rmc-1.log");
+    LogReplayer replayer(log);
+    ReplayOptions options;
+    options.pace = ReplayOptions::Pace::unthrottled;
+
+    int fds[2];
+    BOOST_REQUIRE( pipe(fds) == 0 );
+
+    LatencyHistogram latencies;
+    std::size_t received = 0;
+    std::thread consumer([&]
+    {
+        EpollReader reader([&](int, const Position &) { latencies.record(replayer.latencyOf(received++)); });
+        reader.add(fds[0]);
+        reader.run();
+    });
+
+    replayer.replay(fds[1], options);
+    close(fds[1]);
+    consumer.join();
+    close(fds[0]);
+
+    BOOST_CHECK_EQUAL( received , replayer.validSentenceCount() );
+    BOOST_CHECK_EQUAL( latencies.count() , received );
+    BOOST_CHECK_GT( latencies.min().count() , 0 );
+    BOOST_CHECK( latencies.percentile(50) < seconds(1) );
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+/////////////////////////////////////////////////////////////////////////////////////////
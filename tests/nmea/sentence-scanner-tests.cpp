@@ -0,0 +1,151 @@
+#include <boost/test/unit_test.hpp>
+
+#include <random>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "nmea-parser.h"
+#include "sentence-scanner.h"
+#include "../test-helpers.h"
+
+using namespace GPS;
+using namespace NMEA;
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_SUITE( SentenceScannerTests )
+
+const std::string gll = "$GPGLL,5425.31,N,107.03,W,82610*69";
+const std::string gga = "$GPGGA,114530.000,3722.6279,N,00559.1566,W,1,0,,1.0,M,,M,,*4E";
+const std::string rmc = "$GPRMC,115856.000,A,3722.6710,N,00559.3014,W,0.000,0.00,150914,,A*6d";
+
+std::vector<std::string> scanAll(std::string_view buffer)
+{
+    SentenceScanner scanner(buffer);
+    std::vector<std::string> sentences;
+    std::string_view sentence;
+    while (scanner.nextSentence(sentence)) sentences.emplace_back(sentence);
+    return sentences;
+}
+
+BOOST_AUTO_TEST_CASE( SeparateLines )
+{
+    const std::vector<std::string> expected = {gll, gga, rmc};
+    BOOST_CHECK( scanAll(gll + "\n" + gga + "\r\n" + rmc) == expected );
+}
+
+BOOST_AUTO_TEST_CASE( GluedSentences )
+{
+    const std::vector<std::string> expected = {gll, gga, rmc};
+    BOOST_CHECK( scanAll(gll + gga + rmc) == expected );
+}
+
+BOOST_AUTO_TEST_CASE( GarbageBetweenSentences )
+{
+    const std::vector<std::string> expected = {gll, gga, rmc};
+    BOOST_CHECK( scanAll("\x01\xff" "noise" + gll + "$$$GP" + gga + "$GPGGA,12\n34*00 " + rmc + "*") == expected );
+}
+
+BOOST_AUTO_TEST_CASE( TruncatedSentenceBeforeValidOne )
+{
+    // The first sentence lost its end, and the next one follows without a line break.
+    const std::vector<std::string> expected = {gga};
+    BOOST_CHECK( scanAll(rmc.substr(0, 30) + gga) == expected );
+}
+
+BOOST_AUTO_TEST_CASE( ChecksumMismatch )
+{
+    std::string corrupted = gga;
+    corrupted[20] = '9';
+    const std::vector<std::string> expected = {gll};
+    BOOST_CHECK( scanAll(corrupted + gll) == expected );
+}
+
+BOOST_AUTO_TEST_CASE( CharactersAfterChecksum )
+{
+    const std::vector<std::string> expected = {gll, rmc};
+    BOOST_CHECK( scanAll(gll + "12,x" + rmc) == expected );
+}
+
+BOOST_AUTO_TEST_CASE( CutOffAtEndOfBuffer )
+{
+    for (std::size_t length : {std::size_t(1), std::size_t(5), std::size_t(7), std::size_t(20), gga.size() - 3, gga.size() - 1})
+    {
+        const std::string buffer = gll + gga.substr(0, length);
+        SentenceScanner scanner(buffer);
+        std::string_view sentence;
+        BOOST_REQUIRE( scanner.nextSentence(sentence) );
+        BOOST_CHECK_EQUAL( sentence , gll );
+        BOOST_CHECK( ! scanner.nextSentence(sentence) );
+        BOOST_CHECK_EQUAL( scanner.resumeOffset() , gll.size() );
+    }
+
+    // Not a sentence, however it continues.
+    const std::string buffer = gll + "$GPGGA,12\n";
+    SentenceScanner scanner(buffer);
+    std::string_view sentence;
+    BOOST_REQUIRE( scanner.nextSentence(sentence) );
+    BOOST_CHECK( ! scanner.nextSentence(sentence) );
+    BOOST_CHECK_EQUAL( scanner.resumeOffset() , buffer.size() );
+}
+
+BOOST_AUTO_TEST_CASE( OverlongCandidate )
+{
+    const std::string buffer = "$GPMSS," + std::string(SentenceScanner::maxSentenceLength, '1') + gll;
+    const std::vector<std::string> expected = {gll};
+    BOOST_CHECK( scanAll(buffer) == expected );
+
+    SentenceScanner scanner(std::string_view(buffer).substr(0, SentenceScanner::maxSentenceLength + 7));
+    std::string_view sentence;
+    BOOST_CHECK( ! scanner.nextSentence(sentence) );
+    BOOST_CHECK_EQUAL( scanner.resumeOffset() , SentenceScanner::maxSentenceLength + 7 );
+}
+
+BOOST_AUTO_TEST_CASE( CleanLogsMatchReadSentences )
+{
+    for (const std::string filename : {"gll.log", "gga_rmc-1.log", "gga_rmc-2.log"})
+    {
+        const std::string log = readNMEAfile(filename);
+        std::istringstream stream(log);
+        checkSamePositions(scanSentences(log), readSentences(stream));
+    }
+}
+
+BOOST_AUTO_TEST_CASE( CorruptedCaptureRecoversEverySentence )
+{
+    // The log with line breaks dropped or replaced by garbage, which never contains a '$'.
+    const std::string log = readNMEAfile("gga_rmc-2.log");
+    std::istringstream clean(log);
+    const std::vector<Position> expected = readSentences(clean);
+
+    std::mt19937_64 random(1);
+    std::uniform_int_distribution<int> byte(0, 255);
+    std::string capture;
+    for (char c : log)
+    {
+        if (c != '\n' && c != '\r')
+        {
+            capture += c;
+            continue;
+        }
+        for (int garbage = byte(random) % 4; garbage > 0; --garbage)
+        {
+            char g = static_cast<char>(byte(random));
+            capture += g == '$' ? '#' : g;
+        }
+    }
+
+    checkSamePositions(scanSentences(capture), expected);
+
+    for (std::size_t blockSize : {1, 7, 100, 4096})
+    {
+        std::istringstream stream(capture);
+        checkSamePositions(scanSentences(stream, blockSize), expected);
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+/////////////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,113 @@
+#include <boost/test/unit_test.hpp>
+
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "generator.h"
+#include "nmea-parser.h"
+#include "structural-index.h"
+#include "../test-helpers.h"
+
+using namespace GPS;
+using namespace NMEA;
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_SUITE( StructuralIndexTests )
+
+const std::string gll = "$GPGLL,5425.31,N,107.03,W,82610*69";
+const std::string gga = "$GPGGA,114530.000,3722.6279,N,00559.1566,W,1,0,,1.0,M,,M,,*4E";
+
+void checkMatchesReadSentences(const std::string & text)
+{
+    std::istringstream stream(text);
+    checkSamePositions(readSentencesIndexed(text), readSentences(stream));
+}
+
+BOOST_AUTO_TEST_CASE( OffsetsOfStructuralCharacters )
+{
+    const std::vector<std::uint32_t> expected = {0, 6, 14, 16, 23, 25, 31, 34};
+    BOOST_CHECK( structuralIndex(gll + "\n") == expected );
+    BOOST_CHECK( structuralIndex("").empty() );
+    BOOST_CHECK( structuralIndex("GPGLL 5425.31").empty() );
+}
+
+BOOST_AUTO_TEST_CASE( MatchesScalarIndex )
+{
+    // Mostly structural and sentence characters, so that every block has many set bits.
+    const std::string alphabet = "$,*\n\r0123456789.ABCNSEW \x80\xff";
+    std::mt19937_64 random(1);
+    std::uniform_int_distribution<std::size_t> character(0, alphabet.size() - 1);
+    for (std::size_t length = 0; length <= 300; ++length)
+    {
+        std::string buffer;
+        for (std::size_t i = 0; i < length; ++i) buffer += alphabet[character(random)];
+        BOOST_CHECK( structuralIndex(buffer) == structuralIndexScalar(buffer) );
+    }
+}
+
+BOOST_AUTO_TEST_CASE( LineEndingsAndWhitespace )
+{
+    checkMatchesReadSentences(gll + "\n" + gga + "\n");
+    checkMatchesReadSentences(gll + "\r\n" + gga);
+    checkMatchesReadSentences("  " + gll + " \t\r\n\n\n\t" + gga + "\r\n  ");
+    checkMatchesReadSentences("\n" + gll + "\n\r\n" + gga);
+    BOOST_CHECK_EQUAL( readSentencesIndexed(gll + "\r\n" + gga).size() , 2 );
+}
+
+BOOST_AUTO_TEST_CASE( RejectsInvalidLines )
+{
+    for (const std::string & line : {
+             std::string("$GPGLL,5425.31,N,107.03,W,82610*68"),     // wrong checksum
+             std::string("$GPGLL,5425.31,N,107.03,W,82610*6"),      // short checksum
+             std::string("$GPGLL,5425.31,N,107.03,W,82610"),        // no checksum
+             sentenceFromBody("GPGLL,5425.31,N,107.03,W"),            // missing field
+             std::string("GPGLL,5425.31,N,107.03,W,82610*69"),      // no '$'
+             std::string("$GPGLL,5425.31,N,107.03,W,$2610*69"),     // a '$' within the sentence
+             std::string("$GPGLL,5425.31,N,107.03,W,8*610*69"),     // a '*' within the sentence
+             std::string("$GPGLL,5425.31,N,107.03,W,82610*69 x"),   // characters after the checksum
+             std::string("$GPGLL;5425.31,N,107.03,W,82610*69"),     // no ',' after the format
+             sentenceFromBody("GPXYZ,5425.31,N,107.03,W,82610"),      // unsupported format
+             std::string("$GP*00"),
+             std::string("$")})
+    {
+        checkMatchesReadSentences(line + "\n" + gga);
+        BOOST_CHECK_EQUAL( readSentencesIndexed(line).size() , 0 );
+    }
+}
+
+BOOST_AUTO_TEST_CASE( DataFilesMatchReadSentences )
+{
+    for (const std::string filename : {"gll.log", "gga_rmc-1.log", "gga_rmc-2.log"})
+    {
+        checkMatchesReadSentences(readNMEAfile(filename));
+    }
+}
+
+BOOST_AUTO_TEST_CASE( CorruptedSentencesMatchReadSentences )
+{
+    GeneratorOptions options;
+    options.targetBytes = 256 * 1024;
+    options.corruptionRate = 0.1;
+    std::ostringstream stream;
+    const GeneratorStatistics statistics = generateSentences(stream, options);
+    const std::string text = stream.str();
+
+    BOOST_CHECK_EQUAL( readSentencesIndexed(text).size() , statistics.validSentences );
+    checkMatchesReadSentences(text);
+
+    // The same sentences with CRLF line endings.
+    std::string crlf;
+    for (char c : text)
+    {
+        if (c == '\n') crlf += '\r';
+        crlf += c;
+    }
+    checkMatchesReadSentences(crlf);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+/////////////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,79 @@
+#include <boost/test/unit_test.hpp>
+
+#include <fstream>
+#include <sstream>
+
+#include "dataFiles.h"
+#include "nmea-parser.h"
+#include "track-reader.h"
+
+using namespace GPS;
+using namespace NMEA;
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_SUITE( TrackReader )
+
+BOOST_AUTO_TEST_CASE( PositionsAndTimes )
+{
+    std::stringstream sentences;
+    sentences << "$GPGLL,5425.32,N,107.11,W,82319*65" << std::endl;
+    sentences << "not a sentence" << std::endl;
+    sentences << "$GPRMC,113922.000,A,3722.5993,N,00559.2458,W,0.000,0.00,150914,,A*62" << std::endl;
+
+    const Track track = readTrack(sentences);
+
+    BOOST_REQUIRE_EQUAL( track.size() , 2 );
+    BOOST_CHECK_CLOSE( track.latitudes()[0] , 54.422 , 0.0001 );
+    BOOST_CHECK_EQUAL( track.time(0) , 8*3600 + 23*60 + 19 );
+    BOOST_CHECK_EQUAL( track.time(1) , 11*3600 + 39*60 + 22 );
+}
+
+BOOST_AUTO_TEST_CASE( AcrossMidnight )
+{
+    std::stringstream sentences;
+    sentences << "$GPGLL,5425.32,N,107.11,W,235959*55" << std::endl;
+    sentences << "$GPGLL,5425.32,N,107.11,W,000001*55" << std::endl;
+    sentences << "$GPGLL,5425.32,N,107.11,W,000000*54" << std::endl;
+
+    const Track track = readTrack(sentences);
+
+    // The last sentence is out of order, so it is ignored.
+    BOOST_REQUIRE_EQUAL( track.size() , 2 );
+    BOOST_CHECK_EQUAL( track.time(0) , 86399 );
+    BOOST_CHECK_EQUAL( track.time(1) , 86401 );
+}
+
+BOOST_AUTO_TEST_CASE( LogFiles )
+{
+    for (const std::string filename : { "gga_rmc-1.log", "gll.log" })
+    {
+        std::ifstream positionsFile(DataFiles::NMEADir + filename);
+        const std::vector<Position> positions = readSentences(positionsFile);
+
+        std::ifstream trackFile(DataFiles::NMEADir + filename);
+        const Track track = readTrack(trackFile);
+
+        BOOST_CHECK_GT( track.size() , 0 );
+        BOOST_CHECK_LE( track.size() , positions.size() );
+    }
+}
+
+// A multi-kilometre jump in the middle of a log is filtered out while reading.
+BOOST_AUTO_TEST_CASE( FilteredWhileReading )
+{
+    std::stringstream sentences;
+    sentences << "$GPGLL,5425.32,N,107.11,W,82319*65" << std::endl;
+    sentences << "$GPGLL,5525.32,N,107.11,W,82320*6E" << std::endl;
+    sentences << "$GPGLL,5425.31,N,107.09,W,82446*62" << std::endl;
+
+    FixFilter filter;
+    const Track track = readTrack(sentences, filter);
+
+    BOOST_CHECK_EQUAL( track.size() , 2 );
+    BOOST_CHECK_EQUAL( filter.rejectedCount() , 1 );
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+/////////////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,77 @@
+#include <boost/test/unit_test.hpp>
+
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "dataFiles.h"
+#include "nmea-parser.h"
+#include "track-statistics-reader.h"
+#include "../test-helpers.h"
+
+using namespace GPS;
+using namespace NMEA;
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_SUITE( TrackStatisticsReader )
+
+const double percentageAccuracy = 1e-6;
+
+// Reads the positions of a data file with readSentences(), failing if there are none.
+std::vector<Position> positionsOf(const std::string & filename)
+{
+    std::ifstream file(DataFiles::NMEADir + filename);
+    BOOST_REQUIRE( file.is_open() );
+    const std::vector<Position> positions = readSentences(file);
+    BOOST_REQUIRE( ! positions.empty() );
+    return positions;
+}
+
+BOOST_AUTO_TEST_CASE( Stream )
+{
+    const TrackStatistics expected = statisticsOf(positionsOf("gga_rmc-1.log"));
+
+    std::ifstream statisticsFile(DataFiles::NMEADir + "gga_rmc-1.log");
+    BOOST_REQUIRE( statisticsFile.is_open() );
+    checkSameStatistics(readTrackStatistics(statisticsFile), expected, percentageAccuracy);
+}
+
+// Small chunks, so that most chunks start part-way through a line.
+BOOST_AUTO_TEST_CASE( ChunkedFile )
+{
+    for (const std::string filename : { "gga_rmc-1.log", "gga_rmc-2.log", "gll.log" })
+    {
+        const TrackStatistics expected = statisticsOf(positionsOf(filename));
+
+        for (std::size_t chunkSize : { 1, 37, 4096, 1 << 30 })
+        {
+            checkSameStatistics(readTrackStatisticsFromFile(DataFiles::NMEADir + filename, 4, chunkSize), expected,
+                                percentageAccuracy);
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE( FileWithoutFinalLineBreak )
+{
+    const std::string filepath = (std::filesystem::temp_directory_path() / "track-statistics-reader-test.log").string();
+    std::ofstream(filepath, std::ios::binary) << "$GPGLL,5425.32,N,107.11,W,82319*65\r\n"
+                                                 "$GPGLL,5425.31,N,107.09,W,82446*62";
+
+    const TrackStatistics statistics = readTrackStatisticsFromFile(filepath, 2, 10);
+    std::filesystem::remove(filepath);
+
+    BOOST_CHECK_EQUAL( statistics.fixCount() , 2 );
+}
+
+BOOST_AUTO_TEST_CASE( MissingFile )
+{
+    BOOST_CHECK_THROW( readTrackStatisticsFromFile(DataFiles::NMEADir + "nonexistent.log"), std::invalid_argument );
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+/////////////////////////////////////////////////////////////////////////////////////////
@@ -147,6 +147,19 @@ const std::string lonBeyondBoundaryDDM = "18000.60";
 
 BOOST_AUTO_TEST_SUITE( NumericDD )
 
+BOOST_AUTO_TEST_CASE( CompileTime )
+{
+    constexpr Position pos = Position(25.5,-37.25,4786.2);
+    static_assert( pos.latitude() == 25.5 );
+    static_assert( pos.longitude() == -37.25 );
+    static_assert( pos.elevation() == 4786.2 );
+
+    static_assert( Earth::NorthPole.latitude() == poleLatitude );
+    static_assert( isValidLatitude(-90) && ! isValidLatitude(90.01) );
+    static_assert( isValidLongitude(180) && ! isValidLongitude(-180.01) );
+    static_assert( degToRad(halfRotation) == pi );
+}
+
 BOOST_AUTO_TEST_CASE( PositiveArgs )
 {
     Position pos = Position(lat,lon,ele);
@@ -0,0 +1,71 @@
+#include <boost/test/unit_test.hpp>
+
+#include <thread>
+
+#include "spsc-queue.h"
+
+using namespace GPS;
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_SUITE( SpscQueueTests )
+
+BOOST_AUTO_TEST_CASE( CapacityRoundedUp )
+{
+    BOOST_CHECK_EQUAL( SpscQueue<int>(1).capacity() , 1u );
+    BOOST_CHECK_EQUAL( SpscQueue<int>(5).capacity() , 8u );
+    BOOST_CHECK_EQUAL( SpscQueue<int>(64).capacity() , 64u );
+}
+
+BOOST_AUTO_TEST_CASE( EmptyAndFull )
+{
+    SpscQueue<int> queue(2);
+    int item = 0;
+
+    BOOST_CHECK( ! queue.tryPop(item) );
+
+    int first = 1, second = 2, third = 3;
+    BOOST_CHECK( queue.tryPush(first) );
+    BOOST_CHECK( queue.tryPush(second) );
+    BOOST_CHECK( ! queue.tryPush(third) );
+    BOOST_CHECK_EQUAL( queue.size() , 2u );
+
+    BOOST_CHECK( queue.tryPop(item) );
+    BOOST_CHECK_EQUAL( item , 1 );
+    BOOST_CHECK( queue.tryPush(third) );
+    BOOST_CHECK( queue.tryPop(item) );
+    BOOST_CHECK_EQUAL( item , 2 );
+    BOOST_CHECK( queue.tryPop(item) );
+    BOOST_CHECK_EQUAL( item , 3 );
+    BOOST_CHECK( ! queue.tryPop(item) );
+}
+
+BOOST_AUTO_TEST_CASE( TwoThreadsPreserveOrder )
+{
+    SpscQueue<int> queue(16);
+    const int itemCount = 100000;
+
+    std::thread producer([&queue]
+    {
+        for (int i = 0; i < itemCount; ++i)
+        {
+            int item = i;
+            while (! queue.tryPush(item)) std::this_thread::yield();
+        }
+    });
+
+    bool inOrder = true;
+    for (int expected = 0; expected < itemCount; ++expected)
+    {
+        int item;
+        while (! queue.tryPop(item)) std::this_thread::yield();
+        inOrder = inOrder && (item == expected);
+    }
+    producer.join();
+
+    BOOST_CHECK( inOrder );
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+/////////////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,130 @@
+#include <boost/test/unit_test.hpp>
+
+#include <stdexcept>
+#include <vector>
+
+#include "earth.h"
+#include "geometry.h"
+#include "stay-points.h"
+#include "test-helpers.h"
+
+using namespace GPS;
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_SUITE( StayPointTests )
+
+const double percentageAccuracy = 0.0001;
+
+/* A Track that waits at the City Campus from 0 to 'wait' seconds, jittering by up to 20m,
+ * then drives East at 10m/s for 'drive' seconds, then waits again until 'end'.
+ */
+Track waitDriveWait(double wait, double drive, double end)
+{
+    Track track;
+    double t = 0;
+    for (; t <= wait; t += 10) track.append(displaced(Earth::CityCampus, int(t) % 40 - 20, 0), t);
+    for (; t <= wait + drive; t += 10) track.append(displaced(Earth::CityCampus, 0, (t - wait) * 10), t);
+    const Position destination = displaced(Earth::CityCampus, 0, drive * 10);
+    for (; t <= end; t += 10) track.append(displaced(destination, 0, int(t) % 30 - 15), t);
+    return track;
+}
+
+BOOST_AUTO_TEST_CASE( InvalidParameters )
+{
+    BOOST_CHECK_THROW( StayPointDetector(0, 60) , std::invalid_argument );
+    BOOST_CHECK_THROW( StayPointDetector(100, -1) , std::invalid_argument );
+}
+
+BOOST_AUTO_TEST_CASE( DecreasingTimes )
+{
+    StayPointDetector detector;
+    detector.add(Earth::CityCampus, 10);
+    BOOST_CHECK_THROW( detector.add(Earth::CityCampus, 9) , std::invalid_argument );
+}
+
+BOOST_AUTO_TEST_CASE( NoFixes )
+{
+    StayPointDetector detector;
+    BOOST_CHECK( ! detector.finish() );
+    BOOST_CHECK( findStayPoints(Track()).empty() );
+}
+
+BOOST_AUTO_TEST_CASE( StopsAtBothEnds )
+{
+    const std::vector<StayPoint> stays = findStayPoints(waitDriveWait(1800, 600, 4000), 200, 1200);
+
+    BOOST_REQUIRE_EQUAL( stays.size() , 2 );
+    BOOST_CHECK_EQUAL( stays[0].arrival , 0 );
+    BOOST_CHECK_EQUAL( stays[0].departure , 1810 );  // 1810s is still within 200m
+    BOOST_CHECK_EQUAL( stays[0].fixCount , 182 );
+    BOOST_CHECK_LT( Position::horizontalDistanceBetween(stays[0].centre, Earth::CityCampus) , 10 );
+
+    const Position destination = displaced(Earth::CityCampus, 0, 6000);
+    BOOST_CHECK_LT( Position::horizontalDistanceBetween(stays[1].centre, destination) , 30 );
+    BOOST_CHECK_EQUAL( stays[1].departure , 4000 );
+}
+
+BOOST_AUTO_TEST_CASE( ShortStopsAreIgnored )
+{
+    const std::vector<StayPoint> stays = findStayPoints(waitDriveWait(600, 600, 1500), 200, 1200);
+
+    BOOST_CHECK( stays.empty() );
+}
+
+BOOST_AUTO_TEST_CASE( RestartsAtTheFirstDistantFix )
+{
+    // The run from 0s is too short, and the next run starts at 20s (not 10s), 250m East.
+    Track track;
+    track.append(Earth::CityCampus, 0);
+    track.append(displaced(Earth::CityCampus, 0, 150), 10);
+    track.append(displaced(Earth::CityCampus, 0, 250), 20);
+    for (int t = 30; t <= 200; t += 10) track.append(Earth::CityCampus, t);
+    const std::vector<StayPoint> stays = findStayPoints(track, 200, 100);
+
+    BOOST_REQUIRE_EQUAL( stays.size() , 1 );
+    BOOST_CHECK_EQUAL( stays[0].arrival , 30 );
+    BOOST_CHECK_EQUAL( stays[0].fixCount , 18 );
+}
+
+BOOST_AUTO_TEST_CASE( StreamingMatchesBatch )
+{
+    const Track track = waitDriveWait(1800, 600, 4000);
+    StayPointDetector detector(200, 1200);
+    std::vector<double> departures;
+    for (std::size_t i = 0; i < track.size(); ++i)
+    {
+        const std::optional<StayPoint> stay = detector.add(track.position(i), track.time(i));
+        if (stay)
+        {
+            // The stay is reported at the first fix that is too far away.
+            BOOST_CHECK_GT( Position::horizontalDistanceBetween(track.position(i), Earth::CityCampus) , 150 );
+            departures.push_back(stay->departure);
+        }
+    }
+    const std::optional<StayPoint> last = detector.finish();
+    BOOST_REQUIRE( last );
+    departures.push_back(last->departure);
+
+    const std::vector<StayPoint> stays = findStayPoints(track, 200, 1200);
+    BOOST_REQUIRE_EQUAL( departures.size() , stays.size() );
+    for (std::size_t i = 0; i < stays.size(); ++i) BOOST_CHECK_EQUAL( departures[i] , stays[i].departure );
+}
+
+BOOST_AUTO_TEST_CASE( AcrossTheAntiMeridian )
+{
+    Track track;
+    for (int t = 0; t <= 600; t += 10)
+    {
+        track.append(displaced(Earth::EquatorialAntiMeridian, 0, t % 20 == 0 ? -30 : 30), t);
+    }
+    const std::vector<StayPoint> stays = findStayPoints(track, 100, 300);
+
+    BOOST_REQUIRE_EQUAL( stays.size() , 1 );
+    BOOST_CHECK_LT( Position::horizontalDistanceBetween(stays[0].centre, Earth::EquatorialAntiMeridian) , 1 );
+    BOOST_CHECK_CLOSE( std::abs(stays[0].centre.longitude()) , 180 , percentageAccuracy );
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+/////////////////////////////////////////////////////////////////////////////////////////
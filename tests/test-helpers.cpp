@@ -0,0 +1,92 @@
+#include <boost/test/unit_test.hpp>
+
+#include <algorithm>
+#include <fstream>
+#include <random>
+#include <sstream>
+
+#include "dataFiles.h"
+#include "earth.h"
+#include "geometry.h"
+#include "test-helpers.h"
+
+namespace GPS
+{
+  Track randomWalk(Position start, std::size_t size, degrees step, unsigned int seed)
+  {
+      std::mt19937_64 random(seed);
+      std::uniform_real_distribution<degrees> offset(-step, step);
+      Track track;
+      degrees lat = start.latitude(), lon = start.longitude();
+      for (std::size_t i = 0; i < size; ++i)
+      {
+          track.append(Position(lat, lon, 0), double(i));
+          lat = std::clamp(lat + offset(random), -89.0, 89.0);
+          lon = normaliseDegrees(lon + offset(random));
+      }
+      return track;
+  }
+
+  Position displaced(Position p, metres north, metres east)
+  {
+      return Earth::offsetPositions({p}, north, east).front();
+  }
+
+  std::string readNMEAfile(std::string filename)
+  {
+      const std::string dataFilepath = DataFiles::NMEADir + filename;
+      std::ifstream file(dataFilepath, std::ios::binary);
+      BOOST_REQUIRE_MESSAGE( file.good() ,
+        ("Could not open NMEA data file: " + dataFilepath +
+         "\n(If you're running at the command-line, you need to 'cd' into the 'bin/' directory first.)") );
+      std::ostringstream contents;
+      contents << file.rdbuf();
+      return contents.str();
+  }
+
+  void checkSamePositions(const std::vector<Position> & actual, const std::vector<Position> & expected)
+  {
+      BOOST_REQUIRE_EQUAL( actual.size() , expected.size() );
+      for (std::size_t i = 0; i < actual.size(); ++i)
+      {
+          BOOST_CHECK_EQUAL( actual[i].latitude() , expected[i].latitude() );
+          BOOST_CHECK_EQUAL( actual[i].longitude() , expected[i].longitude() );
+          BOOST_CHECK_EQUAL( actual[i].elevation() , expected[i].elevation() );
+      }
+  }
+
+  TrackStatistics statisticsOf(std::vector<Position>::const_iterator begin, std::vector<Position>::const_iterator end)
+  {
+      TrackStatistics statistics;
+      for (auto p = begin; p != end; ++p) statistics.add(*p);
+      return statistics;
+  }
+
+  TrackStatistics statisticsOf(const std::vector<Position> & positions)
+  {
+      return statisticsOf(positions.begin(), positions.end());
+  }
+
+  void checkSameStatistics(const TrackStatistics & actual, const TrackStatistics & expected, double percentageAccuracy)
+  {
+      BOOST_REQUIRE_EQUAL( actual.fixCount() , expected.fixCount() );
+      BOOST_CHECK_CLOSE( actual.totalDistance() , expected.totalDistance() , percentageAccuracy );
+
+      // Offset by 1, so that a gain or loss of zero can be compared to within a percentage.
+      BOOST_CHECK_CLOSE( actual.elevationGain() + 1 , expected.elevationGain() + 1 , percentageAccuracy );
+      BOOST_CHECK_CLOSE( actual.elevationLoss() + 1 , expected.elevationLoss() + 1 , percentageAccuracy );
+      if (expected.fixCount() == 0) return;
+
+      BOOST_CHECK_EQUAL( actual.minElevation() , expected.minElevation() );
+      BOOST_CHECK_EQUAL( actual.maxElevation() , expected.maxElevation() );
+      BOOST_CHECK_CLOSE( actual.meanElevation() , expected.meanElevation() , percentageAccuracy );
+      BOOST_CHECK_EQUAL( actual.boundingBox().minLatitude , expected.boundingBox().minLatitude );
+      BOOST_CHECK_EQUAL( actual.boundingBox().maxLatitude , expected.boundingBox().maxLatitude );
+      BOOST_CHECK_EQUAL( actual.boundingBox().minLongitude , expected.boundingBox().minLongitude );
+      BOOST_CHECK_EQUAL( actual.boundingBox().maxLongitude , expected.boundingBox().maxLongitude );
+      BOOST_CHECK_EQUAL( actual.first().latitude() , expected.first().latitude() );
+      BOOST_CHECK_EQUAL( actual.first().longitude() , expected.first().longitude() );
+      BOOST_CHECK_EQUAL( actual.last().latitude() , expected.last().latitude() );
+      BOOST_CHECK_EQUAL( actual.last().longitude() , expected.last().longitude() );
+  }
+}
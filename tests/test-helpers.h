@@ -0,0 +1,42 @@
+#ifndef GPS_TEST_HELPERS_H
+#define GPS_TEST_HELPERS_H
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include "position.h"
+#include "track.h"
+#include "track-statistics.h"
+#include "types.h"
+
+namespace GPS
+{
+  /* A random walk of 'size' fixes from a starting Position, one second apart, in steps of up
+   * to 'step' degrees in latitude and longitude.  The walk stays clear of the poles, and its
+   * longitudes wrap around at the anti-meridian.
+   */
+  Track randomWalk(Position start, std::size_t size, degrees step, unsigned int seed);
+
+  // 'p' moved the specified distances North and East, with Earth::offsetPositions().
+  Position displaced(Position p, metres north, metres east);
+
+  /* The whole contents of a file in the NMEA data directory.  The test fails if the file
+   * cannot be opened.
+   */
+  std::string readNMEAfile(std::string filename);
+
+  // Checks that two sequences of Positions are exactly equal.
+  void checkSamePositions(const std::vector<Position> & actual, const std::vector<Position> & expected);
+
+  // The statistics of a sequence of Positions, added one at a time.
+  TrackStatistics statisticsOf(std::vector<Position>::const_iterator begin, std::vector<Position>::const_iterator end);
+  TrackStatistics statisticsOf(const std::vector<Position> &);
+
+  /* Checks that two sets of statistics agree: the distances and elevations to within the
+   * percentage accuracy, and the fixes exactly.
+   */
+  void checkSameStatistics(const TrackStatistics & actual, const TrackStatistics & expected, double percentageAccuracy);
+}
+
+#endif
@@ -0,0 +1,76 @@
+#include <boost/test/unit_test.hpp>
+
+#include <atomic>
+#include <stdexcept>
+#include <vector>
+
+#include "thread-pool.h"
+
+using namespace GPS;
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_SUITE( ThreadPoolTests )
+
+BOOST_AUTO_TEST_CASE( RunsEveryTask )
+{
+    ThreadPool pool(4);
+    std::atomic<int> count{0};
+
+    for (int i = 0; i < 1000; ++i)
+    {
+        pool.submit([&count]{ ++count; });
+    }
+    pool.wait();
+
+    BOOST_CHECK_EQUAL( count.load() , 1000 );
+}
+
+BOOST_AUTO_TEST_CASE( StealsFromBusyWorker )
+{
+    ThreadPool pool(4);
+    std::vector<int> done(100, 0);
+
+    // Every task is queued on worker 0; the other workers must steal them.
+    for (int i = 0; i < 100; ++i)
+    {
+        pool.submit([&done,i]{ done[i] = 1; }, 0);
+    }
+    pool.wait();
+
+    for (int d : done) BOOST_CHECK_EQUAL( d , 1 );
+}
+
+BOOST_AUTO_TEST_CASE( ReusableAfterWait )
+{
+    ThreadPool pool(2);
+    std::atomic<int> count{0};
+
+    pool.submit([&count]{ ++count; });
+    pool.wait();
+    pool.submit([&count]{ ++count; });
+    pool.wait();
+
+    BOOST_CHECK_EQUAL( count.load() , 2 );
+}
+
+BOOST_AUTO_TEST_CASE( TaskExceptionRethrown )
+{
+    ThreadPool pool(2);
+
+    pool.submit([]{ throw std::runtime_error("task failed"); });
+
+    BOOST_CHECK_THROW( pool.wait() , std::runtime_error );
+    BOOST_CHECK_NO_THROW( pool.wait() );
+}
+
+BOOST_AUTO_TEST_CASE( DefaultThreadCount )
+{
+    ThreadPool pool;
+
+    BOOST_CHECK( pool.size() >= 1 );
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+/////////////////////////////////////////////////////////////////////////////////////////
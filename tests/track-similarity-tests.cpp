@@ -0,0 +1,273 @@
+#include <boost/test/unit_test.hpp>
+
+#include <algorithm>
+#include <cstdlib>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+#include "earth.h"
+#include "geometry.h"
+#include "test-helpers.h"
+#include "track-similarity.h"
+
+using namespace GPS;
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_SUITE( TrackSimilarityTests )
+
+const double percentageAccuracy = 0.000001;
+
+const double infinity = std::numeric_limits<double>::infinity();
+
+// The distances between every pair of fixes.
+std::vector<std::vector<metres>> distanceTable(const Track & a, const Track & b)
+{
+    std::vector<std::vector<metres>> table(a.size(), std::vector<metres>(b.size()));
+    for (std::size_t i = 0; i < a.size(); ++i)
+    {
+        for (std::size_t j = 0; j < b.size(); ++j)
+        {
+            table[i][j] = Position::horizontalDistanceBetween(a.position(i), b.position(j));
+        }
+    }
+    return table;
+}
+
+// The Fréchet distance, by the textbook recurrence over the full table.
+metres fullTableFrechet(const Track & a, const Track & b)
+{
+    const std::vector<std::vector<metres>> d = distanceTable(a, b);
+    std::vector<std::vector<metres>> c = d;
+    for (std::size_t i = 0; i < a.size(); ++i)
+    {
+        for (std::size_t j = 0; j < b.size(); ++j)
+        {
+            if (i == 0 && j == 0) continue;
+            metres best = infinity;
+            if (i > 0) best = std::min(best, c[i-1][j]);
+            if (j > 0) best = std::min(best, c[i][j-1]);
+            if (i > 0 && j > 0) best = std::min(best, c[i-1][j-1]);
+            c[i][j] = std::max(d[i][j], best);
+        }
+    }
+    return c.back().back();
+}
+
+// The DTW distance over the full table, matching fix 'i' of 'a' only with fixes of 'b' within 'window' of 'centre(i)'.
+metres fullTableDtw(const Track & a, const Track & b, std::size_t window)
+{
+    const std::size_t n = a.size(), m = b.size();
+    const auto inWindow = [&](std::size_t i, std::size_t j)
+    {
+        const long centre = n > 1 ? long((i * (m - 1) + (n - 1) / 2) / (n - 1)) : 0;
+        return std::size_t(std::labs(long(j) - centre)) <= window;
+    };
+
+    const std::vector<std::vector<metres>> d = distanceTable(a, b);
+    std::vector<std::vector<metres>> c(n, std::vector<metres>(m, infinity));
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        for (std::size_t j = 0; j < m; ++j)
+        {
+            if (! inWindow(i, j)) continue;
+            metres best = (i == 0 && j == 0) ? 0 : infinity;
+            if (i > 0) best = std::min(best, c[i-1][j]);
+            if (j > 0) best = std::min(best, c[i][j-1]);
+            if (i > 0 && j > 0) best = std::min(best, c[i-1][j-1]);
+            c[i][j] = d[i][j] + best;
+        }
+    }
+    return c.back().back();
+}
+
+BOOST_AUTO_TEST_CASE( EmptyTracks )
+{
+    const Track track = randomWalk(Earth::CityCampus, 10, 0.001, 1);
+    BOOST_CHECK_THROW( frechetDistance(Track(), track) , std::domain_error );
+    BOOST_CHECK_THROW( frechetDistance(track, Track()) , std::domain_error );
+    BOOST_CHECK_THROW( dtwDistance(Track(), track) , std::domain_error );
+    BOOST_CHECK_THROW( dtwDistanceWithin(track, Track(), 1000) , std::domain_error );
+    BOOST_CHECK_THROW( nearestRoutes(Track(), {track}) , std::domain_error );
+    BOOST_CHECK_THROW( nearestRoutes(track, {track, Track()}) , std::domain_error );
+}
+
+BOOST_AUTO_TEST_CASE( IdenticalTracks )
+{
+    const Track track = randomWalk(Earth::CityCampus, 100, 0.001, 2);
+    BOOST_CHECK_EQUAL( frechetDistance(track, track) , 0 );
+    BOOST_CHECK_EQUAL( dtwDistance(track, track) , 0 );
+    BOOST_CHECK_EQUAL( dtwDistance(track, track, 0) , 0 );
+}
+
+BOOST_AUTO_TEST_CASE( SingleFixes )
+{
+    Track a, b;
+    a.append(Earth::CityCampus, 0);
+    b.append(Earth::CliftonCampus, 0);
+    const metres distance = Position::horizontalDistanceBetween(Earth::CityCampus, Earth::CliftonCampus);
+    BOOST_CHECK_CLOSE( frechetDistance(a, b) , distance , percentageAccuracy );
+    BOOST_CHECK_CLOSE( dtwDistance(a, b) , distance , percentageAccuracy );
+
+    // One fix against many: it is matched with every one of them.
+    const Track walk = randomWalk(Earth::CliftonCampus, 20, 0.001, 3);
+    metres furthest = 0, total = 0;
+    for (std::size_t j = 0; j < walk.size(); ++j)
+    {
+        const metres d = Position::horizontalDistanceBetween(Earth::CityCampus, walk.position(j));
+        furthest = std::max(furthest, d);
+        total += d;
+    }
+    BOOST_CHECK_CLOSE( frechetDistance(a, walk) , furthest , percentageAccuracy );
+    BOOST_CHECK_CLOSE( dtwDistance(a, walk, 0) , total , percentageAccuracy );
+    BOOST_CHECK_CLOSE( dtwDistance(walk, a, 0) , total , percentageAccuracy );
+}
+
+BOOST_AUTO_TEST_CASE( FrechetMatchesFullTable )
+{
+    for (unsigned int seed = 0; seed < 5; ++seed)
+    {
+        const Track a = randomWalk(Earth::CityCampus, 40 + seed * 13, 0.002, seed);
+        const Track b = randomWalk(Earth::CityCampus, 70 - seed * 7, 0.002, seed + 100);
+        BOOST_CHECK_CLOSE( frechetDistance(a, b) , fullTableFrechet(a, b) , percentageAccuracy );
+        BOOST_CHECK_CLOSE( frechetDistance(b, a) , fullTableFrechet(a, b) , percentageAccuracy );
+    }
+}
+
+BOOST_AUTO_TEST_CASE( FrechetFollowsOrder )
+{
+    // A route and the same route backwards pass through the same places.
+    const Track route = randomWalk(Earth::CityCampus, 50, 0.001, 4);
+    Track backwards;
+    for (std::size_t i = route.size(); i-- > 0; ) backwards.append(route.position(i), double(route.size() - i));
+
+    BOOST_CHECK_GE( frechetDistance(route, backwards) ,
+                    Position::horizontalDistanceBetween(route.position(0), route.position(route.size() - 1)) * (1 - 1e-9) );
+}
+
+BOOST_AUTO_TEST_CASE( DtwMatchesFullTable )
+{
+    for (unsigned int seed = 0; seed < 5; ++seed)
+    {
+        const Track a = randomWalk(Earth::CityCampus, 40 + seed * 13, 0.002, seed);
+        const Track b = randomWalk(Earth::CityCampus, 70 - seed * 7, 0.002, seed + 100);
+        BOOST_CHECK_CLOSE( dtwDistance(a, b) , fullTableDtw(a, b, noWarpingWindow) , percentageAccuracy );
+        BOOST_CHECK_CLOSE( dtwDistance(b, a) , fullTableDtw(a, b, noWarpingWindow) , percentageAccuracy );
+
+        // Windows wide enough not to be widened.
+        for (std::size_t window : {3, 5, 20})
+        {
+            BOOST_CHECK_CLOSE( dtwDistance(a, b, window) , fullTableDtw(a, b, window) , percentageAccuracy );
+            BOOST_CHECK_GE( dtwDistance(a, b, window) , dtwDistance(a, b) );
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE( NarrowWindowIsWidened )
+{
+    const Track a = randomWalk(Earth::CityCampus, 10, 0.002, 5);
+    const Track b = randomWalk(Earth::CityCampus, 95, 0.002, 6);
+
+    // Fix 'i' of 'a' must reach 11 fixes along 'b' from fix 'i-1'.
+    BOOST_CHECK_CLOSE( dtwDistance(a, b, 0) , fullTableDtw(a, b, 11) , percentageAccuracy );
+    BOOST_CHECK_CLOSE( dtwDistance(b, a, 0) , fullTableDtw(b, a, 1) , percentageAccuracy );
+}
+
+BOOST_AUTO_TEST_CASE( Abandoning )
+{
+    const Track a = randomWalk(Earth::CityCampus, 60, 0.002, 7);
+    const Track b = randomWalk(Earth::CityCampus, 80, 0.002, 8);
+    const metres frechet = frechetDistance(a, b);
+    const metres dtw = dtwDistance(a, b, 10);
+
+    BOOST_REQUIRE( frechetDistanceWithin(a, b, frechet * 1.01) );
+    BOOST_CHECK_CLOSE( *frechetDistanceWithin(a, b, frechet * 1.01) , frechet , percentageAccuracy );
+    BOOST_CHECK( ! frechetDistanceWithin(a, b, frechet * 0.99) );
+
+    BOOST_REQUIRE( dtwDistanceWithin(a, b, dtw * 1.01, 10) );
+    BOOST_CHECK_CLOSE( *dtwDistanceWithin(a, b, dtw * 1.01, 10) , dtw , percentageAccuracy );
+    BOOST_CHECK( ! dtwDistanceWithin(a, b, dtw * 0.99, 10) );
+    BOOST_CHECK( ! dtwDistanceWithin(a, b, 0.0) );
+}
+
+BOOST_AUTO_TEST_CASE( NearestRoutesMatchAllComparisons )
+{
+    // Routes around the City Campus, some of them variations on the Track, and some far away.
+    const Track track = randomWalk(Earth::CityCampus, 120, 0.001, 9);
+    std::vector<Track> routes;
+    for (unsigned int seed = 0; seed < 30; ++seed)
+    {
+        if (seed % 3 == 0)
+        {
+            std::vector<Position> fixes;
+            for (std::size_t i = 0; i < track.size(); i += 1 + seed % 2) fixes.push_back(track.position(i));
+            Track variation;
+            for (const Position & p : Earth::offsetPositions(fixes, seed * 10.0, 0)) variation.append(p, double(variation.size()));
+            routes.push_back(variation);
+        }
+        else
+        {
+            const Position start = seed % 3 == 1 ? Earth::CityCampus : Earth::Pontianak;
+            routes.push_back(randomWalk(start, 50 + seed * 5, 0.001, seed + 200));
+        }
+    }
+
+    using Measure = RouteSearchOptions::Measure;
+    for (Measure measure : {Measure::frechet, Measure::dtw})
+    {
+        for (std::size_t window : {std::size_t(8), noWarpingWindow})
+        {
+            std::vector<RouteMatch> expected;
+            for (std::size_t route = 0; route < routes.size(); ++route)
+            {
+                const metres distance = measure == Measure::frechet ? fullTableFrechet(track, routes[route])
+                                                                    : fullTableDtw(track, routes[route], window);
+                expected.push_back({route, distance});
+            }
+            std::sort(expected.begin(), expected.end(), [](const RouteMatch & r, const RouteMatch & s)
+            {
+                return r.distance < s.distance;
+            });
+
+            for (unsigned int threads : {1, 3})
+            {
+                RouteSearchOptions options;
+                options.measure = measure;
+                options.window = window;
+                options.count = 4;
+                options.threadCount = threads;
+                const std::vector<RouteMatch> nearest = nearestRoutes(track, routes, options);
+
+                BOOST_REQUIRE_EQUAL( nearest.size() , options.count );
+                for (std::size_t k = 0; k < nearest.size(); ++k)
+                {
+                    BOOST_CHECK_EQUAL( nearest[k].route , expected[k].route );
+                    BOOST_CHECK_CLOSE( nearest[k].distance , expected[k].distance , percentageAccuracy );
+                }
+            }
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE( MoreRoutesRequestedThanExist )
+{
+    const Track track = randomWalk(Earth::CityCampus, 30, 0.001, 10);
+    const std::vector<Track> routes = {randomWalk(Earth::CityCampus, 30, 0.001, 11), track};
+
+    RouteSearchOptions options;
+    options.count = 5;
+    const std::vector<RouteMatch> nearest = nearestRoutes(track, routes, options);
+    BOOST_REQUIRE_EQUAL( nearest.size() , 2 );
+    BOOST_CHECK_EQUAL( nearest[0].route , 1 );
+    BOOST_CHECK_EQUAL( nearest[0].distance , 0 );
+    BOOST_CHECK_EQUAL( nearest[1].route , 0 );
+
+    options.count = 0;
+    BOOST_CHECK( nearestRoutes(track, routes, options).empty() );
+    BOOST_CHECK( nearestRoutes(track, {}).empty() );
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+/////////////////////////////////////////////////////////////////////////////////////////
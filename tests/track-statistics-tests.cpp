@@ -0,0 +1,101 @@
+#include <boost/test/unit_test.hpp>
+
+#include <stdexcept>
+#include <vector>
+
+#include "earth.h"
+#include "test-helpers.h"
+#include "track-statistics.h"
+
+using namespace GPS;
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_SUITE( TrackStatisticsTests )
+
+const double percentageAccuracy = 1e-9;
+
+const std::vector<Position> track = { Position(52.9, -1.2, 50), Position(52.91, -1.19, 58), Position(52.93, -1.17, 40),
+                                      Position(52.95, -1.16, 45), Position(52.96, -1.15, 53) };
+
+BOOST_AUTO_TEST_CASE( Empty )
+{
+    const TrackStatistics statistics;
+
+    BOOST_CHECK_EQUAL( statistics.fixCount() , 0 );
+    BOOST_CHECK_EQUAL( statistics.totalDistance() , 0 );
+    BOOST_CHECK_EQUAL( statistics.elevationGain() , 0 );
+    BOOST_CHECK_EQUAL( statistics.elevationLoss() , 0 );
+    BOOST_CHECK_THROW( statistics.boundingBox(), std::domain_error );
+    BOOST_CHECK_THROW( statistics.minElevation(), std::domain_error );
+    BOOST_CHECK_THROW( statistics.meanElevation(), std::domain_error );
+    BOOST_CHECK_THROW( statistics.first(), std::domain_error );
+}
+
+BOOST_AUTO_TEST_CASE( SinglePosition )
+{
+    TrackStatistics statistics;
+    statistics.add(Earth::CliftonCampus);
+
+    BOOST_CHECK_EQUAL( statistics.fixCount() , 1 );
+    BOOST_CHECK_EQUAL( statistics.totalDistance() , 0 );
+    BOOST_CHECK_EQUAL( statistics.minElevation() , 58 );
+    BOOST_CHECK_EQUAL( statistics.maxElevation() , 58 );
+    BOOST_CHECK_EQUAL( statistics.meanElevation() , 58 );
+    BOOST_CHECK_EQUAL( statistics.boundingBox().minLatitude , Earth::CliftonCampus.latitude() );
+    BOOST_CHECK_EQUAL( statistics.boundingBox().maxLongitude , Earth::CliftonCampus.longitude() );
+}
+
+BOOST_AUTO_TEST_CASE( WholeTrack )
+{
+    const TrackStatistics statistics = statisticsOf(track.begin(), track.end());
+
+    metres expectedDistance = 0;
+    for (std::size_t i = 1; i < track.size(); ++i) expectedDistance += Position::horizontalDistanceBetween(track[i-1], track[i]);
+
+    BOOST_CHECK_EQUAL( statistics.fixCount() , 5 );
+    BOOST_CHECK_CLOSE( statistics.totalDistance() , expectedDistance , percentageAccuracy );
+    BOOST_CHECK_CLOSE( statistics.elevationGain() , 8 + 5 + 8 , percentageAccuracy );
+    BOOST_CHECK_CLOSE( statistics.elevationLoss() , 18 , percentageAccuracy );
+    BOOST_CHECK_EQUAL( statistics.minElevation() , 40 );
+    BOOST_CHECK_EQUAL( statistics.maxElevation() , 58 );
+    BOOST_CHECK_CLOSE( statistics.meanElevation() , 49.2 , percentageAccuracy );
+    BOOST_CHECK_EQUAL( statistics.boundingBox().minLatitude , 52.9 );
+    BOOST_CHECK_EQUAL( statistics.boundingBox().maxLatitude , 52.96 );
+    BOOST_CHECK_EQUAL( statistics.boundingBox().minLongitude , -1.2 );
+    BOOST_CHECK_EQUAL( statistics.boundingBox().maxLongitude , -1.15 );
+}
+
+// Splitting the track at any point and merging the two halves gives the same figures.
+BOOST_AUTO_TEST_CASE( MergeTwoPieces )
+{
+    const TrackStatistics whole = statisticsOf(track.begin(), track.end());
+    for (std::size_t split = 0; split <= track.size(); ++split)
+    {
+        TrackStatistics merged = statisticsOf(track.begin(), track.begin() + split);
+        merged.merge(statisticsOf(track.begin() + split, track.end()));
+        checkSameStatistics(merged, whole, percentageAccuracy);
+    }
+}
+
+BOOST_AUTO_TEST_CASE( MergeIsAssociative )
+{
+    const TrackStatistics a = statisticsOf(track.begin(), track.begin() + 2);
+    const TrackStatistics b = statisticsOf(track.begin() + 2, track.begin() + 3);
+    const TrackStatistics c = statisticsOf(track.begin() + 3, track.end());
+
+    TrackStatistics leftFirst = a;
+    leftFirst.merge(b);
+    leftFirst.merge(c);
+
+    TrackStatistics rightFirst = b;
+    rightFirst.merge(c);
+    TrackStatistics aThenRest = a;
+    aThenRest.merge(rightFirst);
+
+    checkSameStatistics(aThenRest, leftFirst, percentageAccuracy);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+/////////////////////////////////////////////////////////////////////////////////////////
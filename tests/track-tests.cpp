@@ -0,0 +1,185 @@
+#include <boost/test/unit_test.hpp>
+
+#include <cmath>
+#include <stdexcept>
+#include <vector>
+
+#include "earth.h"
+#include "geometry.h"
+#include "track.h"
+
+using namespace GPS;
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_SUITE( TrackTests )
+
+BOOST_AUTO_TEST_CASE( Empty )
+{
+    const Track track;
+
+    BOOST_CHECK( track.empty() );
+    BOOST_CHECK_EQUAL( track.size() , 0 );
+    BOOST_CHECK( track.latitudes().empty() );
+    BOOST_CHECK( track.times().empty() );
+}
+
+BOOST_AUTO_TEST_CASE( Columns )
+{
+    Track track;
+    track.append(Earth::CliftonCampus, 10);
+    track.append(Earth::CityCampus, 10);
+    track.append(Earth::Pontianak, 25.5);
+
+    BOOST_REQUIRE_EQUAL( track.size() , 3 );
+    BOOST_CHECK_EQUAL( track.latitudes()[1] , Earth::CityCampus.latitude() );
+    BOOST_CHECK_EQUAL( track.longitudes()[2] , Earth::Pontianak.longitude() );
+    BOOST_CHECK_EQUAL( track.elevations()[0] , Earth::CliftonCampus.elevation() );
+    BOOST_CHECK_EQUAL( track.times()[2] , 25.5 );
+
+    const Position p = track.position(0);
+    BOOST_CHECK_EQUAL( p.latitude() , Earth::CliftonCampus.latitude() );
+    BOOST_CHECK_EQUAL( p.longitude() , Earth::CliftonCampus.longitude() );
+    BOOST_CHECK_EQUAL( p.elevation() , Earth::CliftonCampus.elevation() );
+    BOOST_CHECK_EQUAL( track.time(1) , 10 );
+}
+
+BOOST_AUTO_TEST_CASE( TimesMustNotDecrease )
+{
+    Track track;
+    track.append(Earth::CliftonCampus, 10);
+
+    BOOST_CHECK_THROW( track.append(Earth::CityCampus, 9.9), std::invalid_argument );
+    BOOST_CHECK_EQUAL( track.size() , 1 );
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_SUITE( TrackInterpolationTests )
+
+const double percentageAccuracy = 0.0001;
+
+// A Track heading North-East from the City Campus, with irregular gaps between fixes.
+Track irregularTrack()
+{
+    Track track;
+    const double times[] = {0, 1, 1, 4, 5, 11, 12.5, 20};
+    for (int i = 0; i < 8; ++i)
+    {
+        const Position p(Earth::CityCampus.latitude() + i * 0.0001, Earth::CityCampus.longitude() + i * 0.0002, 50 + i);
+        track.append(p, times[i]);
+    }
+    return track;
+}
+
+BOOST_AUTO_TEST_CASE( EmptyTrack )
+{
+    const Track track;
+
+    BOOST_CHECK_THROW( track.positionAt(0) , std::domain_error );
+    BOOST_CHECK_THROW( track.positionsAt({0}) , std::domain_error );
+    BOOST_CHECK_THROW( track.resampled(1) , std::domain_error );
+}
+
+BOOST_AUTO_TEST_CASE( InvalidTimes )
+{
+    const Track track = irregularTrack();
+
+    BOOST_CHECK_THROW( track.positionAt(-0.1) , std::invalid_argument );
+    BOOST_CHECK_THROW( track.positionAt(20.1) , std::invalid_argument );
+    BOOST_CHECK_THROW( track.positionsAt({1, 3, 2}) , std::invalid_argument );
+    BOOST_CHECK_THROW( track.resampled(0) , std::invalid_argument );
+}
+
+BOOST_AUTO_TEST_CASE( AtFixTimes )
+{
+    const Track track = irregularTrack();
+
+    for (std::size_t i = 0; i < track.size(); ++i)
+    {
+        if (i == 1) continue;  // two fixes at time 1: the last is used
+        const Position p = track.positionAt(track.time(i));
+        BOOST_CHECK_CLOSE( p.latitude() , track.latitudes()[i] , percentageAccuracy );
+        BOOST_CHECK_CLOSE( p.longitude() , track.longitudes()[i] , percentageAccuracy );
+        BOOST_CHECK_CLOSE( p.elevation() , track.elevations()[i] , percentageAccuracy );
+    }
+    BOOST_CHECK_EQUAL( track.positionAt(1).elevation() , 52 );
+}
+
+BOOST_AUTO_TEST_CASE( BetweenFixes )
+{
+    const Track track = irregularTrack();
+    const Position p = track.positionAt(8);  // half way from the fix at 5 to the fix at 11
+
+    BOOST_CHECK_CLOSE( p.latitude() , Earth::CityCampus.latitude() + 4.5 * 0.0001 , percentageAccuracy );
+    BOOST_CHECK_CLOSE( p.longitude() , Earth::CityCampus.longitude() + 4.5 * 0.0002 , percentageAccuracy );
+    BOOST_CHECK_CLOSE( p.elevation() , 54.5 , percentageAccuracy );
+}
+
+BOOST_AUTO_TEST_CASE( AcrossTheAntiMeridian )
+{
+    Track track;
+    track.append(Position(10, 179.999, 0), 0);
+    track.append(Position(10, -179.997, 0), 4);
+
+    BOOST_CHECK_CLOSE( track.positionAt(1).longitude() , 180 , percentageAccuracy );
+    BOOST_CHECK_CLOSE( track.positionAt(3).longitude() , -179.998 , percentageAccuracy );
+}
+
+BOOST_AUTO_TEST_CASE( AlongGreatCirclesForLongGaps )
+{
+    Track track;
+    track.append(Position(45, 0, 0), 0);
+    track.append(Position(45, 90, 1000), 100);
+
+    // The great circle bulges towards the pole, rather than following the line of latitude.
+    const Position middle = track.positionAt(50);
+    BOOST_CHECK_CLOSE( middle.latitude() , radToDeg(std::atan(std::sqrt(2.0))) , percentageAccuracy );
+    BOOST_CHECK_CLOSE( middle.longitude() , 45 , percentageAccuracy );
+    BOOST_CHECK_CLOSE( middle.elevation() , 500 , percentageAccuracy );
+
+    // Equal distances along the great circle in equal times.
+    const metres firstQuarter = Position::horizontalDistanceBetween(track.position(0), track.positionAt(25));
+    const metres secondQuarter = Position::horizontalDistanceBetween(track.positionAt(25), middle);
+    BOOST_CHECK_CLOSE( firstQuarter , secondQuarter , percentageAccuracy );
+}
+
+BOOST_AUTO_TEST_CASE( BatchMatchesSingleQueries )
+{
+    Track track = irregularTrack();
+    track.append(Position(60, 30, 0), 100);  // a long gap
+
+    std::vector<double> times;
+    for (double t = 0; t <= 100; t += 0.7) times.push_back(t);
+    const Track batch = track.positionsAt(times);
+
+    BOOST_REQUIRE_EQUAL( batch.size() , times.size() );
+    for (std::size_t k = 0; k < times.size(); ++k)
+    {
+        const Position p = track.positionAt(times[k]);
+        BOOST_CHECK_EQUAL( batch.time(k) , times[k] );
+        BOOST_CHECK_CLOSE( batch.latitudes()[k] , p.latitude() , percentageAccuracy );
+        BOOST_CHECK_CLOSE( batch.longitudes()[k] , p.longitude() , percentageAccuracy );
+        BOOST_CHECK_CLOSE( batch.elevations()[k] , p.elevation() , percentageAccuracy );
+    }
+}
+
+BOOST_AUTO_TEST_CASE( Resampled )
+{
+    const Track track = irregularTrack();
+    const Track every3 = track.resampled(3);
+
+    BOOST_REQUIRE_EQUAL( every3.size() , 7 );  // 0, 3, ..., 18
+    BOOST_CHECK_EQUAL( every3.time(6) , 18 );
+    BOOST_CHECK_CLOSE( every3.elevations()[1] , track.positionAt(3).elevation() , percentageAccuracy );
+
+    const Track single = track.resampled(100);
+    BOOST_REQUIRE_EQUAL( single.size() , 1 );
+    BOOST_CHECK_EQUAL( single.time(0) , 0 );
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+/////////////////////////////////////////////////////////////////////////////////////////
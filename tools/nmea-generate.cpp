@@ -0,0 +1,101 @@
+/* Generates a synthetic NMEA corpus for benchmarking.
+ *
+ * Usage: nmea-generate [--bytes N[K|M|G]] [--seed N] [--corruption RATE] [--output FILE]
+ *
+ * Writes to standard output unless an output file is given, and prints a summary of what
+ * was generated to standard error.
+ */
+
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+
+#include "generator.h"
+
+using namespace GPS::NMEA;
+
+namespace
+{
+  std::uint64_t parseByteCount(const std::string & text)
+  {
+      std::size_t end;
+      std::uint64_t count = std::stoull(text, &end);
+      const std::string suffix = text.substr(end);
+      if      (suffix == "" ) {}
+      else if (suffix == "K") count <<= 10;
+      else if (suffix == "M") count <<= 20;
+      else if (suffix == "G") count <<= 30;
+      else throw std::invalid_argument("Invalid byte count: " + text);
+      return count;
+  }
+
+  void printUsage()
+  {
+      std::cerr << "Usage: nmea-generate [--bytes N[K|M|G]] [--seed N] [--corruption RATE] [--output FILE]\n";
+  }
+}
+
+int main(int argc, char * argv[])
+{
+    GeneratorOptions options;
+    std::string outputPath;
+
+    try
+    {
+        for (int i = 1; i < argc; ++i)
+        {
+            const std::string arg = argv[i];
+            if (arg == "--help")
+            {
+                printUsage();
+                return EXIT_SUCCESS;
+            }
+            if (i + 1 == argc) throw std::invalid_argument("Missing value for " + arg);
+            const std::string value = argv[++i];
+
+            if      (arg == "--bytes")      options.targetBytes = parseByteCount(value);
+            else if (arg == "--seed")       options.seed = std::stoull(value);
+            else if (arg == "--corruption") options.corruptionRate = std::stod(value);
+            else if (arg == "--output")     outputPath = value;
+            else throw std::invalid_argument("Unknown option: " + arg);
+        }
+    }
+    catch (const std::exception & e)
+    {
+        std::cerr << e.what() << "\n";
+        printUsage();
+        return EXIT_FAILURE;
+    }
+
+    try
+    {
+        std::ofstream file;
+        if (! outputPath.empty())
+        {
+            file.open(outputPath, std::ios::binary | std::ios::trunc);
+            if (! file) throw std::runtime_error("Cannot open " + outputPath);
+        }
+        std::ostream & out = outputPath.empty() ? std::cout : file;
+
+        const GeneratorStatistics stats = generateSentences(out, options);
+        out.flush();
+        if (! out) throw std::runtime_error("Failed to write output.");
+
+        std::cerr << stats.bytesWritten << " bytes, "
+                  << stats.fixes << " fixes, "
+                  << stats.sentences << " sentences ("
+                  << stats.validSentences << " valid, "
+                  << stats.badChecksums << " bad checksums, "
+                  << stats.truncatedSentences << " truncated, "
+                  << stats.badBearings << " bad bearings, "
+                  << stats.wrongFieldCounts << " wrong field counts)\n";
+    }
+    catch (const std::exception & e)
+    {
+        std::cerr << e.what() << "\n";
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,13 @@
+TEMPLATE = app
+CONFIG += console
+CONFIG -= app_bundle
+CONFIG -= qt
+
+include(../gps.pri)
+
+SOURCES += \
+    nmea-generate.cpp
+
+OBJECTS_DIR = $$_PRO_FILE_PWD_/../bin/nmea-generate-obj/
+DESTDIR = $$_PRO_FILE_PWD_/../bin/
+TARGET = nmea-generate
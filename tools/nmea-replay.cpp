@@ -0,0 +1,198 @@
+/* Replays a recorded NMEA log through a pipe, pseudo-terminal or local socket into the
+ * streaming parser, and reports the latency from each sentence being written to its
+ * Position being parsed.
+ *
+ * Usage: nmea-replay [--speed N | --rate N | --unthrottled] [--transport pipe|pty|socket] LOGFILE
+ *
+ * By default the log is replayed at its recorded pace, through a pipe.
+ */
+
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <utility>
+
+#include <fcntl.h>
+#include <stdlib.h>
+#include <sys/ioctl.h>
+#include <sys/socket.h>
+#include <termios.h>
+#include <unistd.h>
+
+#include "latency-histogram.h"
+#include "epoll-reader.h"
+#include "replay.h"
+
+using namespace GPS;
+using namespace GPS::NMEA;
+
+namespace
+{
+  std::system_error systemError(const char * what)
+  {
+      return std::system_error(errno, std::generic_category(), what);
+  }
+
+  // Returns the (writing, reading) ends of the transport.
+  std::pair<int,int> openTransport(const std::string & transport)
+  {
+      if (transport == "pipe")
+      {
+          int fds[2];
+          if (pipe(fds) != 0) throw systemError("pipe");
+          return {fds[1], fds[0]};
+      }
+      if (transport == "socket")
+      {
+          int fds[2];
+          if (socketpair(AF_UNIX, SOCK_STREAM, 0, fds) != 0) throw systemError("socketpair");
+          return {fds[0], fds[1]};
+      }
+      if (transport == "pty")
+      {
+          // The parser reads the device side, configured in raw mode as a serial port would be.
+          const int controller = posix_openpt(O_RDWR | O_NOCTTY);
+          if (controller < 0 || grantpt(controller) != 0 || unlockpt(controller) != 0) throw systemError("posix_openpt");
+          const int device = open(ptsname(controller), O_RDWR | O_NOCTTY);
+          if (device < 0) throw systemError("open");
+          termios settings;
+          tcgetattr(device, &settings);
+          cfmakeraw(&settings);
+          tcsetattr(device, TCSANOW, &settings);
+          return {controller, device};
+      }
+      throw std::invalid_argument("Unknown transport: " + transport);
+  }
+
+  /* Wait until the reader has taken all the data out of the transport.  Closing a
+   * pseudo-terminal discards any data still buffered in it.
+   */
+  void waitUntilDrained(int readFd)
+  {
+      int pending;
+      while (ioctl(readFd, FIONREAD, &pending) == 0 && pending > 0)
+      {
+          std::this_thread::sleep_for(std::chrono::milliseconds(1));
+      }
+  }
+
+  void printUsage()
+  {
+      std::cerr << "Usage: nmea-replay [--speed N | --rate N | --unthrottled] [--transport pipe|pty|socket] LOGFILE\n";
+  }
+
+  std::string microseconds(std::chrono::nanoseconds duration)
+  {
+      std::ostringstream text;
+      text << std::fixed << std::setprecision(1) << duration.count() / 1000.0 << " us";
+      return text.str();
+  }
+}
+
+int main(int argc, char * argv[])
+{
+    ReplayOptions options;
+    std::string transport = "pipe";
+    std::string logPath;
+
+    try
+    {
+        for (int i = 1; i < argc; ++i)
+        {
+            const std::string arg = argv[i];
+            if (arg == "--help")
+            {
+                printUsage();
+                return EXIT_SUCCESS;
+            }
+            else if (arg == "--unthrottled")
+            {
+                options.pace = ReplayOptions::Pace::unthrottled;
+            }
+            else if (arg == "--speed" || arg == "--rate" || arg == "--transport")
+            {
+                if (i + 1 == argc) throw std::invalid_argument("Missing value for " + arg);
+                const std::string value = argv[++i];
+                if (arg == "--speed")
+                {
+                    options.pace = ReplayOptions::Pace::recorded;
+                    options.speedFactor = std::stod(value);
+                }
+                else if (arg == "--rate")
+                {
+                    options.pace = ReplayOptions::Pace::fixedRate;
+                    options.sentencesPerSecond = std::stod(value);
+                }
+                else transport = value;
+            }
+            else if (logPath.empty() && arg.substr(0,2) != "--")
+            {
+                logPath = arg;
+            }
+            else throw std::invalid_argument("Unknown option: " + arg);
+        }
+        if (logPath.empty()) throw std::invalid_argument("No log file specified.");
+    }
+    catch (const std::exception & e)
+    {
+        std::cerr << e.what() << "\n";
+        printUsage();
+        return EXIT_FAILURE;
+    }
+
+    try
+    {
+        std::ifstream log(logPath, std::ios::binary);
+        if (! log) throw std::runtime_error("Cannot open " + logPath);
+        LogReplayer replayer(log);
+        replayer.schedule(options); // validates the options before anything is started
+
+        const auto [writeFd, readFd] = openTransport(transport);
+
+        LatencyHistogram latencies;
+        std::size_t received = 0;
+        EpollReader reader([&](int, const Position &) { latencies.record(replayer.latencyOf(received++)); });
+        reader.add(readFd);
+        std::thread consumer([&reader] { reader.run(); });
+
+        ReplayStatistics stats;
+        try
+        {
+            stats = replayer.replay(writeFd, options);
+        }
+        catch (...)
+        {
+            reader.stop();
+            consumer.join();
+            throw;
+        }
+        waitUntilDrained(readFd);
+        close(writeFd); // the reader sees end-of-file (or EIO for a pseudo-terminal) and stops
+        consumer.join();
+        close(readFd);
+
+        std::cout << stats.linesWritten << " lines (" << stats.bytesWritten << " bytes) written in "
+                  << stats.elapsedSeconds << " s, at most " << stats.maxLagSeconds << " s behind schedule\n"
+                  << received << " of " << replayer.validSentenceCount() << " valid sentences parsed\n"
+                  << "Latency from write to parse:\n"
+                  << "  min    " << microseconds(latencies.min()) << "\n"
+                  << "  mean   " << microseconds(latencies.mean()) << "\n"
+                  << "  p50    " << microseconds(latencies.percentile(50)) << "\n"
+                  << "  p90    " << microseconds(latencies.percentile(90)) << "\n"
+                  << "  p99    " << microseconds(latencies.percentile(99)) << "\n"
+                  << "  p99.9  " << microseconds(latencies.percentile(99.9)) << "\n"
+                  << "  max    " << microseconds(latencies.max()) << "\n";
+    }
+    catch (const std::exception & e)
+    {
+        std::cerr << e.what() << "\n";
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}